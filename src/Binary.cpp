@@ -45,7 +45,7 @@ namespace {
             bool isNegative = opOverload.first[0] == '!';
             
             NodeCall* overloadedCall = new NodeCall(loc,
-                new NodeIden(AST::structTable[isNegative ? opOverload.first.substr(1) : opOverload.first]->operators[op][opOverload.second]->name, loc),
+                new NodeIden(AST::structTable[Symbol(isNegative ? opOverload.first.substr(1) : opOverload.first)]->operators[op][opOverload.second]->name, loc),
                 std::vector<Node*>({new NodeDone(firstVal), new NodeDone(secondVal)})
             );
 
@@ -116,7 +116,7 @@ namespace {
 
                 if (instanceof<TypeBasic>(value.type) && ((TypeBasic*)value.type)->type != ((TypeBasic*)elType)->type) LLVM::cast(value, elType, loc);
 
-                if (value.type->toString() != elType->toString()) 
+                if (!Types::typesEqual(value.type, elType)) 
                     generator->error("cannot store a value of type \033[1m" + value.type->toString() + "\033[22m into a value of type \033[1m" + elType->toString() + "\033[22m!", loc);
 
                 if (instanceof<TypePointer>(ptr.type)) {
@@ -153,7 +153,7 @@ namespace {
             auto overload = Binary::isOperatorOverload(first, second, vSecond, vFirst, TokType::In);
 
             if (overload.first != "" && overload.second != "") {
-                NodeFunc* _operator = AST::structTable[overload.first]->operators[TokType::In][overload.second];
+                NodeFunc* _operator = AST::structTable[Symbol(overload.first)]->operators[TokType::In][overload.second];
 
                 if (_operator == nullptr) generator->error("operator not found!", loc);
                 else {
@@ -255,8 +255,8 @@ std::pair<std::string, std::string> Binary::isOperatorOverload(Node* firstNode,
 
     if (instanceof<TypeStruct>(type) || (instanceof<TypePointer>(type) && instanceof<TypeStruct>(type->getElType()))) {
         std::string structName = (instanceof<TypeStruct>(type) ? ((TypeStruct*)type)->name : ((TypeStruct*)(((TypePointer*)type)->instance))->name);
-        if (AST::structTable.find(structName) != AST::structTable.end()) {
-            auto& operators = AST::structTable[structName]->operators;
+        if (AST::structTable.find(Symbol::lookup(structName)) != AST::structTable.end()) {
+            auto& operators = AST::structTable[Symbol(structName)]->operators;
             if (operators.find(op) != operators.end()) {
                 std::vector<Type*> types = {firstNode->getType(), secondNode->getType()};
                 std::string sTypes = typesToString(types);
@@ -303,7 +303,7 @@ RaveValue Binary::operation(char op, Node* first, Node* second, int loc) {
             bool isNegative = opOverload.first[0] == '!';
 
             NodeCall* _overloadedCall = new NodeCall(loc,
-                new NodeIden(AST::structTable[isNegative ? opOverload.first.substr(1) : opOverload.first]->operators[isNegative ? TokType::Equal : op][opOverload.second]->name, loc),
+                new NodeIden(AST::structTable[Symbol(isNegative ? opOverload.first.substr(1) : opOverload.first)]->operators[isNegative ? TokType::Equal : op][opOverload.second]->name, loc),
                 std::vector<Node*>({new NodeDone(vFirst), new NodeDone(vSecond)})
             );
 
@@ -10,12 +10,18 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "./include/parser/nodes/NodeBool.hpp"
 #include "./include/parser/nodes/NodeInt.hpp"
 #include "./include/parser/nodes/NodeImport.hpp"
+#include "./include/parser/nodes/NodeCall.hpp"
+#include "./include/parser/FuncRegistry.hpp"
+#include "./include/parser/LoopHints.hpp"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <chrono>
 #include <ctime>
 #include "./include/lexer/lexer.hpp"
 #include "./include/parser/parser.hpp"
+#include "./include/version.hpp"
+#include "./include/timeTrace.hpp"
 #include <llvm-c/Target.h>
 #include <llvm-c/TargetMachine.h>
 #include <llvm-c/Core.h>
@@ -28,6 +34,9 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <llvm-c/Remarks.h>
 #include <llvm-c/Linker.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/BitWriter.h>
+#include <llvm-c/Comdat.h>
 
 #if LLVM_VERSION < 17
 #include <llvm-c/Transforms/InstCombine.h>
@@ -42,14 +51,35 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #ifdef _WIN32
    #include <io.h>
+   #include <process.h>
    #define access    _access_s
+   #define getpid _getpid
    #define WEXITSTATUS(w) (((w) >> 8) & 0377)
 #else
    #include <unistd.h>
    #include <sys/wait.h>
+   #include <spawn.h>
+   extern char** environ;
 #endif
 
-std::string Compiler::linkString;
+#include <thread>
+
+#ifndef __has_include
+  static_assert(false, "__has_include not supported");
+#else
+#if __cplusplus >= 201703L && __has_include(<filesystem>)
+#include <filesystem>
+    namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#    include <experimental/filesystem>
+    namespace fs = std::experimental::filesystem;
+#elif __has_include(<boost/filesystem.hpp>)
+#include <boost/filesystem.hpp>
+    namespace fs = boost::filesystem;
+#  endif
+#endif
+
+std::vector<std::string> Compiler::linkArguments;
 std::string Compiler::outFile;
 std::string Compiler::outType;
 std::string Compiler::features;
@@ -58,11 +88,16 @@ nlohmann::json Compiler::options;
 double Compiler::lexTime = 0.0;
 double Compiler::parseTime = 0.0;
 double Compiler::genTime = 0.0;
+double Compiler::startupTime = 0.0;
 std::vector<std::string> Compiler::files;
 std::vector<std::string> Compiler::toImport;
 bool Compiler::debugMode;
 std::string Compiler::raveOs;
 std::string Compiler::ravePlatform;
+std::string Compiler::settingsKey;
+
+// Nodes and types of the file being compiled, released as a whole after its object file is written
+static Arena unitArena;
 
 std::string getDirectory(std::string file) {
     return file.substr(0, file.find_last_of("/\\"));
@@ -77,6 +112,79 @@ ShellResult exec(std::string cmd) {
     return ShellResult{.output = result, .status = WEXITSTATUS(pclose(pipe))};
 }
 
+// Joins the arguments into a command line (for the messages and the shell), quoting the ones with spaces or quotes
+static std::string joinArguments(const std::vector<std::string>& arguments) {
+    std::string command = "";
+
+    for (const auto& argument : arguments) {
+        if (command != "") command += " ";
+        if (argument == "" || argument.find_first_of(" \t\n\"'") != std::string::npos) command += "\"" + replaceAll(argument, "\"", "\\\"") + "\"";
+        else command += argument;
+    }
+
+    return command;
+}
+
+// Runs the command directly (without a shell in between), letting it write to the terminal.
+// Used for the linker calls, which only need the exit status.
+ShellResult spawn(const std::vector<std::string>& arguments) {
+    #ifdef _WIN32
+    return exec(joinArguments(arguments));
+    #else
+    if (arguments.empty()) return ShellResult{.output = "", .status = 1};
+
+    std::vector<char*> argv;
+    for (size_t i=0; i<arguments.size(); i++) argv.push_back((char*)arguments[i].c_str());
+    argv.push_back(nullptr);
+
+    std::cout.flush();
+    fflush(stdout);
+
+    pid_t pid;
+    if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) return ShellResult{.output = "", .status = 127};
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) return ShellResult{.output = "", .status = 1};
+    return ShellResult{.output = "", .status = WIFEXITED(status) ? WEXITSTATUS(status) : 1};
+    #endif
+}
+
+// Adds the flags of a command line (the compiler of options.json) to the arguments, split on whitespace
+static void addFlags(std::vector<std::string>& arguments, const std::string& flags) {
+    std::string argument = "";
+
+    for (size_t i=0; i<=flags.size(); i++) {
+        if (i == flags.size() || flags[i] == ' ' || flags[i] == '\t' || flags[i] == '\n') {
+            if (argument != "") arguments.push_back(argument);
+            argument = "";
+        }
+        else argument += flags[i];
+    }
+}
+
+// Checks that the program can be found in PATH.
+static bool inPath(std::string program) {
+    if (program.find('/') != std::string::npos) return access(program.c_str(), 0) == 0;
+
+    const char* path = getenv("PATH");
+    if (path == nullptr) return false;
+
+    std::string directories = path;
+    size_t start = 0;
+
+    while (start <= directories.size()) {
+        size_t end = directories.find(':', start);
+        if (end == std::string::npos) end = directories.size();
+
+        std::string directory = directories.substr(start, end - start);
+        if (directory != "" && access((directory + "/" + program).c_str(), 0) == 0) return true;
+
+        start = end + 1;
+    }
+
+    return false;
+}
+
 bool endsWith(const std::string &str, const std::string &suffix) {
     if (str.size() < suffix.size()) return false;
     return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
@@ -87,7 +195,35 @@ void Compiler::error(std::string message) {
     std::exit(1);
 }
 
+// Hash of every setting that changes the generated code; computed once by initialize()
+static std::string makeSettingsKey() {
+    const genSettings& settings = Compiler::settings;
+    std::string key = std::string(RAVE_VERSION) + "|" + std::to_string(LLVM_VERSION) + "|" + Compiler::outType + "|" + std::to_string(settings.optLevel) + "|";
+
+    const bool flags[] = {
+        settings.noPrelude, settings.noStd, settings.noEntry, settings.noChecks, settings.isPIC, settings.isPIE, settings.outDebugInfo,
+        settings.isNative, settings.noFastMath, settings.noPrivateInlining, settings.noIoInit, settings.lto,
+        settings.popcnt, settings.fma, settings.f16c, settings.sse, settings.sse2, settings.sse3, settings.ssse3, settings.sse4a,
+        settings.sse4_1, settings.sse4_2, settings.avx, settings.avx2, settings.avx512,
+        settings.asimd, settings.fp, settings.sve, settings.sve2, settings.half
+    };
+
+    for (bool flag : flags) key += flag ? '1' : '0';
+    for (const auto& dir : settings.importDirectories) key += "|" + dir;
+    key += "|" + Compiler::options.dump();
+
+    if (settings.isNative) {
+        char* hostFeatures = LLVMGetHostCPUFeatures();
+        key += "|" + std::string(hostFeatures);
+        LLVMDisposeMessage(hostFeatures);
+    }
+
+    return hashString(key);
+}
+
 void Compiler::initialize(std::string outFile, std::string outType, genSettings settings, std::vector<std::string> files) {
+    auto start = std::chrono::steady_clock::now();
+
     Compiler::outFile = outFile;
     Compiler::outType = outType;
     Compiler::settings = settings;
@@ -117,13 +253,13 @@ void Compiler::initialize(std::string outFile, std::string outType, genSettings
 
         if (outType.find("win32") != std::string::npos) {
             #ifndef _WIN32
-                Compiler::linkString += " --target=i686-pc-windows-gnu ";
+                Compiler::linkArguments.push_back("--target=i686-pc-windows-gnu");
             #endif
             raveOs = "WINDOWS";
         }
         else if (outType.find("win64") != std::string::npos || outType.find("windows") != std::string::npos) {
             #ifndef _WIN32
-                Compiler::linkString += " --target=x86_64-pc-windows-gnu ";
+                Compiler::linkArguments.push_back("--target=x86_64-pc-windows-gnu");
             #endif
             raveOs = "WINDOWS";
         }
@@ -232,50 +368,16 @@ void Compiler::initialize(std::string outFile, std::string outType, genSettings
         if (rfOptions.is_open()) rfOptions.close();
     }
 
-    Compiler::linkString = Compiler::options["compiler"].template get<std::string>() + " ";
-
-    if (Compiler::settings.isPIE) linkString += "-fPIE ";
-    if (Compiler::settings.noStd) linkString += "-nostdlib ";
-    if (Compiler::settings.noEntry) linkString += "--no-entry ";
-
-    // Begin of LLVM initializing
-
-    LLVMInitializeX86TargetInfo();
-    LLVMInitializeAArch64TargetInfo();
-    LLVMInitializePowerPCTargetInfo();
-    LLVMInitializeMipsTargetInfo();
-    LLVMInitializeARMTargetInfo();
-    LLVMInitializeAVRTargetInfo();
-
-    LLVMInitializeX86Target();
-    LLVMInitializeAArch64Target();
-    LLVMInitializePowerPCTarget();
-    LLVMInitializeMipsTarget();
-    LLVMInitializeARMTarget();
-    LLVMInitializeAVRTarget();
+    Compiler::linkArguments.clear();
+    addFlags(Compiler::linkArguments, Compiler::options["compiler"].template get<std::string>());
 
-    LLVMInitializeX86AsmParser();
-    LLVMInitializeAArch64AsmParser();
-    LLVMInitializePowerPCAsmParser();
-    LLVMInitializeMipsAsmParser();
-    LLVMInitializeARMAsmParser();
-    LLVMInitializeAVRAsmParser();
+    if (Compiler::settings.isPIE) linkArguments.push_back("-fPIE");
+    if (Compiler::settings.noStd) linkArguments.push_back("-nostdlib");
+    if (Compiler::settings.noEntry) linkArguments.push_back("--no-entry");
 
-    LLVMInitializeX86AsmPrinter();
-    LLVMInitializeAArch64AsmPrinter();
-    LLVMInitializePowerPCAsmPrinter();
-    LLVMInitializeMipsAsmPrinter();
-    LLVMInitializeARMAsmPrinter();
-    LLVMInitializeAVRAsmPrinter();
+    Compiler::settingsKey = makeSettingsKey();
 
-    LLVMInitializeX86TargetMC();
-    LLVMInitializeAArch64TargetMC();
-    LLVMInitializePowerPCTargetMC();
-    LLVMInitializeMipsTargetMC();
-    LLVMInitializeARMTargetMC();
-    LLVMInitializeAVRTargetMC();
-
-    // End of LLVM initializing
+    // The LLVM backend of the target is initialized by setupTarget(), on first use
 
     basicTypes[BasicType::Bool] = new TypeBasic(BasicType::Bool);
     basicTypes[BasicType::Char] = new TypeBasic(BasicType::Char);
@@ -294,6 +396,8 @@ void Compiler::initialize(std::string outFile, std::string outType, genSettings
     basicTypes[BasicType::Double] = new TypeBasic(BasicType::Double);
     basicTypes[BasicType::Real] = new TypeBasic(BasicType::Real);
     typeVoid = new TypeVoid();
+
+    Compiler::startupTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 // Clears all possible global variables.
@@ -305,8 +409,12 @@ void Compiler::clearAll() {
     AST::structTable.clear();
     AST::structMembersTable.clear();
     AST::methodTable.clear();
+    AST::lambdaTable.clear();
     AST::importedFiles.clear();
     AST::aliasTypes.clear();
+    FuncRegistry::instance().clear();
+    Types::clearTypePools();
+    Template::clearCache();
     generator->structures.clear();
     generator->globals.clear();
     generator->functions.clear();
@@ -315,166 +423,325 @@ void Compiler::clearAll() {
     currScope = nullptr;
 }
 
-void Compiler::compile(std::string file) {
-    std::ifstream fContent(file);
-    std::string content = "";
+static bool readFile(const std::string& file, std::string& content) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream.is_open()) return false;
 
-    char c;
-    while (fContent.get(c)) content += c;
+    content.assign((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return true;
+}
 
-    bool littleEndian = true;
-
-    // Note: PowerPC must be rechecked for endianness
-
-    if (ravePlatform == "MIPS64" || ravePlatform == "MIPS") littleEndian = false;
-
-    bool isX86 = ravePlatform == "X86_64" || ravePlatform == "X86";
-    bool isAARCH64 = ravePlatform == "AARCH64";
-    bool isARM = ravePlatform == "ARM";
-
-    bool popcnt = settings.popcnt && isX86;
-    bool fma = settings.fma && isX86;
-    bool f16c = settings.f16c && isX86;
-    bool sse = settings.sse && isX86;
-    bool sse2 = settings.sse2 && isX86;
-    bool sse3 = settings.sse3 && isX86;
-    bool ssse3 = settings.ssse3 && isX86;
-    bool sse4a = settings.sse4a && isX86;
-    bool sse4_1 = settings.sse4_1 && isX86;
-    bool sse4_2 = settings.sse4_2 && isX86;
-    bool avx = settings.avx && isX86;
-    bool avx2 = settings.avx2 && isX86;
-    bool avx512 = settings.avx512 && isX86;
-
-    bool asimd = settings.asimd && isAARCH64;
-    bool fp = settings.fp && isAARCH64;
-    bool sve = settings.sve && isAARCH64;
-    bool sve2 = settings.sve2 && isAARCH64;
-
-    bool half = settings.half && isARM;
-
-    if (isX86) {
-        popcnt = popcnt && Compiler::options["platforms"][ravePlatform]["POPCNT"].template get<bool>();
-        fma = fma && Compiler::options["platforms"][ravePlatform]["FMA"].template get<bool>();
-        f16c = f16c && Compiler::options["platforms"][ravePlatform]["F16C"].template get<bool>();
-        sse = sse && Compiler::options["platforms"][ravePlatform]["SSE"].template get<bool>();
-        sse2 = sse2 && Compiler::options["platforms"][ravePlatform]["SSE2"].template get<bool>();
-        sse3 = sse3 && Compiler::options["platforms"][ravePlatform]["SSE3"].template get<bool>();
-        ssse3 = ssse3 && Compiler::options["platforms"][ravePlatform]["SSSE3"].template get<bool>();
-        sse4a = sse4a && Compiler::options["platforms"][ravePlatform]["SSE4A"].template get<bool>();
-        sse4_1 = sse4_1 && Compiler::options["platforms"][ravePlatform]["SSE4_1"].template get<bool>();
-        sse4_2 = sse4_2 && Compiler::options["platforms"][ravePlatform]["SSE4_2"].template get<bool>();
-        avx = avx && Compiler::options["platforms"][ravePlatform]["AVX"].template get<bool>();
-        avx2 = avx2 && Compiler::options["platforms"][ravePlatform]["AVX2"].template get<bool>();
-
-        if (ravePlatform == "X86_64") avx512 = avx512 && Compiler::options["platforms"][ravePlatform]["AVX512"].template get<bool>();
-        else avx512 = false;
-    }
-    else if (isAARCH64) {
-        asimd = asimd && Compiler::options["platforms"]["AARCH64"]["ASIMD"].template get<bool>();
-        fp = fp && Compiler::options["platforms"]["AARCH64"]["FP"].template get<bool>();
-        sve = sve && Compiler::options["platforms"]["AARCH64"]["SVE"].template get<bool>();
-        sve2 = sve2 && Compiler::options["platforms"]["AARCH64"]["SVE2"].template get<bool>();
-    }
-    else if (isARM) {
-        half = half && Compiler::options["platforms"]["ARM"]["HALF"].template get<bool>();
-    }
-
-    if (!settings.isNative) {
-        Compiler::features = "";
-
-        if (popcnt) Compiler::features += "+popcnt,";
-        if (fma) Compiler::features += "+fma,";
-        if (f16c) Compiler::features += "+f16c,";
-        if (sse) Compiler::features += "+sse,";
-        if (sse2) Compiler::features += "+sse2,";
-        if (sse3) Compiler::features += "+sse3,";
-        if (ssse3) Compiler::features += "+ssse3,";
-        if (sse4a) Compiler::features += "+sse4a,";
-        if (sse4_1) Compiler::features += "+sse4.1,";
-        if (sse4_2) Compiler::features += "+sse4.2,";
-        if (avx) Compiler::features += "+avx,";
-        if (avx2) Compiler::features += "+avx2,";
-        if (avx512) Compiler::features += "+avx512,";
-
-        if (asimd) Compiler::features += "+neon,";
-        if (fp) Compiler::features += "+fp-armv8,";
-        if (sve) Compiler::features += "+sve,";
-        if (sve2) Compiler::features += "+sve2,";
-
-        if (half) Compiler::features += "+fp16,";
-        
-        if (ravePlatform == "X86_64") Compiler::features += "+64bit,";
+static std::string buildDirectory = "";
+static int buildDirectoryOwner = 0;
+
+// Private directory for the objects that are removed after linking, so concurrent builds of one source tree never share them.
+// It is created before the workers are forked and removed at exit by the process that created it.
+static std::string getBuildDirectory() {
+    if (buildDirectory != "") return buildDirectory;
+
+    fs::path directory = fs::temp_directory_path() / ("rave-" + std::to_string(getpid()) + "-" + hashString(std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())));
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) Compiler::error("cannot create the build directory \033[1m" + directory.string() + "\033[22m: " + error.message());
+
+    buildDirectory = directory.string();
+    buildDirectoryOwner = getpid();
+    std::atexit([]() {
+        std::error_code error;
+        if (getpid() == buildDirectoryOwner) fs::remove_all(buildDirectory, error);
+    });
+
+    return buildDirectory;
+}
+
+// File that compile() writes for the source file: an object, or bitcode with -flto.
+std::string Compiler::getObjectFile(std::string file) {
+    // Standard library files are emitted straight into their cache
+    if (file.find(exePath + "std/") != std::string::npos) return Compiler::getStdObject(file);
+
+    std::string extension = Compiler::settings.lto ? ".bc" : ".o";
+    bool isImport = std::find(Compiler::files.begin(), Compiler::files.end(), file) == Compiler::files.end();
+
+    // When -c is used with -o and there's only one source file, use the output path
+    if (!Compiler::settings.lto && Compiler::settings.onlyObject && Compiler::outFile != "" && Compiler::files.size() == 1 && file == Compiler::files[0]) return Compiler::outFile;
+
+    bool isKept = Compiler::settings.incremental || (!isImport && Compiler::settings.saveObjectFiles) || (!isImport && Compiler::settings.onlyObject && !Compiler::settings.lto);
+    if (!isKept) return getBuildDirectory() + "/" + hashString(file) + "-" + replaceExtension(fs::path(file).filename().string(), ".rave", extension);
+
+    return replaceExtension(file, ".rave", extension);
+}
 
-        if (Compiler::features.length() > 0) Compiler::features = Compiler::features.substr(0, Compiler::features.length() - 1);
+// Cached standard library object of the file. Each configuration has its own copy, so debug and release builds never share std code.
+std::string Compiler::getStdObject(std::string file) {
+    return replaceExtension(file, ".rave", "." + Compiler::outType + "." + Compiler::settingsKey + (Compiler::settings.lto ? ".bc" : ".o"));
+}
+
+// Writes <object>.deps for incremental builds: the settings key, content hashes of the file and of everything it imported,
+// and the side effects of its compilation (imports, libraries) that must be replayed when the object is reused.
+static void saveDependencies(std::string file, std::string objectFile, std::string& content, size_t linkArgumentsSize, size_t addToImportSize) {
+    std::ofstream deps(objectFile + ".deps");
+    if (!deps.is_open()) return;
+
+    deps << "S " << Compiler::settingsKey << "\n";
+    deps << "F " << hashString(content) << " " << file << "\n";
+
+    for (const auto& imported : AST::importedFiles) {
+        std::string importedContent;
+        if (!readFile(imported, importedContent)) {deps.close(); std::remove((objectFile + ".deps").c_str()); return;}
+        deps << "F " << hashString(importedContent) << " " << imported << "\n";
     }
-    else Compiler::features = std::string(LLVMGetHostCPUFeatures());
 
-    AST::aliasTable["__RAVE_PLATFORM"] = new NodeString(ravePlatform, false);
-    AST::aliasTable["__RAVE_OS"] = new NodeString(raveOs, false);
-    AST::aliasTable["__RAVE_OPTIMIZATION_LEVEL"] = new NodeInt(settings.optLevel);
-    AST::aliasTable["__RAVE_RUNTIME_CHECKS"] = new NodeBool(!settings.noChecks);
+    for (size_t i=addToImportSize; i<AST::addToImport.size(); i++) deps << "A " << AST::addToImport[i] << "\n";
+    for (size_t i=linkArgumentsSize; i<Compiler::linkArguments.size(); i++) deps << "L " << Compiler::linkArguments[i] << "\n";
+}
 
-    AST::aliasTable["__RAVE_POPCNT"] = new NodeBool(popcnt);
-    AST::aliasTable["__RAVE_FMA"] = new NodeBool(fma);
-    AST::aliasTable["__RAVE_F16C"] = new NodeBool(f16c);
-    AST::aliasTable["__RAVE_SSE"] = new NodeBool(sse);
-    AST::aliasTable["__RAVE_SSE2"] = new NodeBool(sse2);
-    AST::aliasTable["__RAVE_SSE3"] = new NodeBool(sse3);
-    AST::aliasTable["__RAVE_SSSE3"] = new NodeBool(ssse3);
-    AST::aliasTable["__RAVE_SSE4A"] = new NodeBool(sse4a);
-    AST::aliasTable["__RAVE_SSE4_1"] = new NodeBool(sse4_1);
-    AST::aliasTable["__RAVE_SSE4_2"] = new NodeBool(sse4_2);
-    AST::aliasTable["__RAVE_AVX"] = new NodeBool(avx);
-    AST::aliasTable["__RAVE_AVX2"] = new NodeBool(avx2);
-    AST::aliasTable["__RAVE_AVX512"] = new NodeBool(avx512);
+// Reuses the object of the file if neither the file, nor anything it imports, nor the settings changed since it was built.
+bool Compiler::reuseObject(std::string file, std::string objectFile) {
+    if (!Compiler::settings.incremental || Compiler::settings.emitLLVM || access(objectFile.c_str(), 0) != 0) return false;
 
-    AST::aliasTable["__RAVE_ASIMD"] = new NodeBool(asimd);
-    AST::aliasTable["__RAVE_FP_ARMV8"] = new NodeBool(fp);
-    AST::aliasTable["__RAVE_SVE"] = new NodeBool(sve);
-    AST::aliasTable["__RAVE_SVE2"] = new NodeBool(sve2);
+    std::ifstream deps(objectFile + ".deps");
+    if (!deps.is_open()) return false;
 
-    AST::aliasTable["__RAVE_HALF"] = new NodeBool(half);
+    std::string line;
+    std::vector<std::string> imported, addToImport, linkAdditions;
+    bool hasSettings = false;
 
-    AST::aliasTable["__RAVE_LITTLE_ENDIAN"] = new NodeBool(littleEndian);
-    AST::aliasTable["__RAVE_BIG_ENDIAN"] = new NodeBool(!littleEndian);
+    while (std::getline(deps, line)) {
+        if (line.size() < 3) return false;
+        std::string value = line.substr(2);
 
-    if (ravePlatform == "X86_64" || ravePlatform == "AARCH64" || ravePlatform == "POWERPC64" || ravePlatform == "MIPS64") pointerSize = 64;
-    else if (ravePlatform == "AVR") pointerSize = 16;
-    else pointerSize = 32;
+        if (line[0] == 'S') {
+            if (value != Compiler::settingsKey) return false;
+            hasSettings = true;
+        }
+        else if (line[0] == 'F') {
+            std::string path = value.substr(value.find(' ') + 1), content;
+            if (!readFile(path, content) || hashString(content) != value.substr(0, value.find(' '))) return false;
+            if (path != file) imported.push_back(path);
+        }
+        else if (line[0] == 'A') addToImport.push_back(value);
+        else if (line[0] == 'L') linkAdditions.push_back(value);
+        else return false;
+    }
 
-    AST::mainFile = Compiler::files[0];
-    AST::currentFile = file;
+    if (!hasSettings) return false;
 
-    Lexer lexer = Lexer(content, -1);
-    Parser parser = Parser(lexer.tokens, file);
-    parser.importDirectories = Compiler::settings.importDirectories;
+    for (const auto& path : imported) {
+        if (std::find(Compiler::toImport.begin(), Compiler::toImport.end(), path) == Compiler::toImport.end()) Compiler::toImport.push_back(path);
+    }
 
-    if (!Compiler::settings.noPrelude && !endsWith(file, "std/prelude.rave") && !endsWith(file, "std/memory.rave")) {
-        parser.nodes.push_back(new NodeImport(ImportFile{exePath + "std/prelude.rave", true}, {}, -1));
-        parser.nodes.push_back(new NodeImport(ImportFile{exePath + "std/memory.rave", true}, {}, -1));
+    for (const auto& value : addToImport) AST::addToImport.push_back(value);
+    Compiler::linkArguments.insert(Compiler::linkArguments.end(), linkAdditions.begin(), linkAdditions.end());
+    return true;
+}
+
+// Target state of the invocation: computed by the first setupTarget() call and shared by every file.
+static struct {
+    bool isReady = false;
+    char* triple = nullptr;
+    LLVMTargetMachineRef machine = nullptr;
+
+    bool littleEndian, popcnt, fma, f16c, sse, sse2, sse3, ssse3, sse4a, sse4_1, sse4_2, avx, avx2, avx512;
+    bool asimd, fp, sve, sve2, half;
+} target;
+
+static LLVMTargetMachineRef createTargetMachine(char* triple);
+
+// Initializes only the LLVM backend of the target platform (every supported one if the platform is unknown).
+static void initializeBackend() {
+    std::string platform = Compiler::ravePlatform;
+    bool all = platform != "X86" && platform != "X86_64" && platform != "AARCH64" && platform != "POWERPC" &&
+        platform != "POWERPC64" && platform != "MIPS" && platform != "MIPS64" && platform != "ARM" && platform != "AVR";
+
+    if (all || platform == "X86" || platform == "X86_64") {
+        LLVMInitializeX86TargetInfo();
+        LLVMInitializeX86Target();
+        LLVMInitializeX86AsmParser();
+        LLVMInitializeX86AsmPrinter();
+        LLVMInitializeX86TargetMC();
     }
 
-    parser.parseAll();
-    for (size_t i=0; i<parser.nodes.size(); i++) parser.nodes[i]->check();
+    if (all || platform == "AARCH64") {
+        LLVMInitializeAArch64TargetInfo();
+        LLVMInitializeAArch64Target();
+        LLVMInitializeAArch64AsmParser();
+        LLVMInitializeAArch64AsmPrinter();
+        LLVMInitializeAArch64TargetMC();
+    }
 
-    auto start = std::chrono::steady_clock::now();
+    if (all || platform == "POWERPC" || platform == "POWERPC64") {
+        LLVMInitializePowerPCTargetInfo();
+        LLVMInitializePowerPCTarget();
+        LLVMInitializePowerPCAsmParser();
+        LLVMInitializePowerPCAsmPrinter();
+        LLVMInitializePowerPCTargetMC();
+    }
 
-    generator = new LLVMGen(file, Compiler::settings, Compiler::options);
+    if (all || platform == "MIPS" || platform == "MIPS64") {
+        LLVMInitializeMipsTargetInfo();
+        LLVMInitializeMipsTarget();
+        LLVMInitializeMipsAsmParser();
+        LLVMInitializeMipsAsmPrinter();
+        LLVMInitializeMipsTargetMC();
+    }
 
-    if (settings.outDebugInfo) debugInfo = new DebugGen(settings, file, generator->lModule);
-    else debugInfo = nullptr;
+    if (all || platform == "ARM") {
+        LLVMInitializeARMTargetInfo();
+        LLVMInitializeARMTarget();
+        LLVMInitializeARMAsmParser();
+        LLVMInitializeARMAsmPrinter();
+        LLVMInitializeARMTargetMC();
+    }
 
-    char* errors = nullptr;
-    LLVMTargetRef target;
-    char* triple = LLVMNormalizeTargetTriple(Compiler::outType.c_str());
+    if (all || platform == "AVR") {
+        LLVMInitializeAVRTargetInfo();
+        LLVMInitializeAVRTarget();
+        LLVMInitializeAVRAsmParser();
+        LLVMInitializeAVRAsmPrinter();
+        LLVMInitializeAVRTargetMC();
+    }
+}
 
-    if (errors != nullptr) {
-        Compiler::error("normalize target triple: " + std::string(errors));
-        std::exit(1);
+// Computes Compiler::features, the LLVM backend and the target machine once, then (for every file) the pointer size and the __RAVE_* target aliases.
+void Compiler::setupTarget() {
+    if (!target.isReady) {
+        auto start = std::chrono::steady_clock::now();
+
+        target.littleEndian = true;
+
+        // Note: PowerPC must be rechecked for endianness
+
+        if (ravePlatform == "MIPS64" || ravePlatform == "MIPS") target.littleEndian = false;
+
+        bool isX86 = ravePlatform == "X86_64" || ravePlatform == "X86";
+        bool isAARCH64 = ravePlatform == "AARCH64";
+        bool isARM = ravePlatform == "ARM";
+
+        target.popcnt = settings.popcnt && isX86;
+        target.fma = settings.fma && isX86;
+        target.f16c = settings.f16c && isX86;
+        target.sse = settings.sse && isX86;
+        target.sse2 = settings.sse2 && isX86;
+        target.sse3 = settings.sse3 && isX86;
+        target.ssse3 = settings.ssse3 && isX86;
+        target.sse4a = settings.sse4a && isX86;
+        target.sse4_1 = settings.sse4_1 && isX86;
+        target.sse4_2 = settings.sse4_2 && isX86;
+        target.avx = settings.avx && isX86;
+        target.avx2 = settings.avx2 && isX86;
+        target.avx512 = settings.avx512 && isX86;
+
+        target.asimd = settings.asimd && isAARCH64;
+        target.fp = settings.fp && isAARCH64;
+        target.sve = settings.sve && isAARCH64;
+        target.sve2 = settings.sve2 && isAARCH64;
+
+        target.half = settings.half && isARM;
+
+        if (isX86) {
+            target.popcnt = target.popcnt && Compiler::options["platforms"][ravePlatform]["POPCNT"].template get<bool>();
+            target.fma = target.fma && Compiler::options["platforms"][ravePlatform]["FMA"].template get<bool>();
+            target.f16c = target.f16c && Compiler::options["platforms"][ravePlatform]["F16C"].template get<bool>();
+            target.sse = target.sse && Compiler::options["platforms"][ravePlatform]["SSE"].template get<bool>();
+            target.sse2 = target.sse2 && Compiler::options["platforms"][ravePlatform]["SSE2"].template get<bool>();
+            target.sse3 = target.sse3 && Compiler::options["platforms"][ravePlatform]["SSE3"].template get<bool>();
+            target.ssse3 = target.ssse3 && Compiler::options["platforms"][ravePlatform]["SSSE3"].template get<bool>();
+            target.sse4a = target.sse4a && Compiler::options["platforms"][ravePlatform]["SSE4A"].template get<bool>();
+            target.sse4_1 = target.sse4_1 && Compiler::options["platforms"][ravePlatform]["SSE4_1"].template get<bool>();
+            target.sse4_2 = target.sse4_2 && Compiler::options["platforms"][ravePlatform]["SSE4_2"].template get<bool>();
+            target.avx = target.avx && Compiler::options["platforms"][ravePlatform]["AVX"].template get<bool>();
+            target.avx2 = target.avx2 && Compiler::options["platforms"][ravePlatform]["AVX2"].template get<bool>();
+
+            if (ravePlatform == "X86_64") target.avx512 = target.avx512 && Compiler::options["platforms"][ravePlatform]["AVX512"].template get<bool>();
+            else target.avx512 = false;
+        }
+        else if (isAARCH64) {
+            target.asimd = target.asimd && Compiler::options["platforms"]["AARCH64"]["ASIMD"].template get<bool>();
+            target.fp = target.fp && Compiler::options["platforms"]["AARCH64"]["FP"].template get<bool>();
+            target.sve = target.sve && Compiler::options["platforms"]["AARCH64"]["SVE"].template get<bool>();
+            target.sve2 = target.sve2 && Compiler::options["platforms"]["AARCH64"]["SVE2"].template get<bool>();
+        }
+        else if (isARM) {
+            target.half = target.half && Compiler::options["platforms"]["ARM"]["HALF"].template get<bool>();
+        }
+
+        if (!settings.isNative) {
+            Compiler::features = "";
+
+            if (target.popcnt) Compiler::features += "+popcnt,";
+            if (target.fma) Compiler::features += "+fma,";
+            if (target.f16c) Compiler::features += "+f16c,";
+            if (target.sse) Compiler::features += "+sse,";
+            if (target.sse2) Compiler::features += "+sse2,";
+            if (target.sse3) Compiler::features += "+sse3,";
+            if (target.ssse3) Compiler::features += "+ssse3,";
+            if (target.sse4a) Compiler::features += "+sse4a,";
+            if (target.sse4_1) Compiler::features += "+sse4.1,";
+            if (target.sse4_2) Compiler::features += "+sse4.2,";
+            if (target.avx) Compiler::features += "+avx,";
+            if (target.avx2) Compiler::features += "+avx2,";
+            if (target.avx512) Compiler::features += "+avx512,";
+
+            if (target.asimd) Compiler::features += "+neon,";
+            if (target.fp) Compiler::features += "+fp-armv8,";
+            if (target.sve) Compiler::features += "+sve,";
+            if (target.sve2) Compiler::features += "+sve2,";
+
+            if (target.half) Compiler::features += "+fp16,";
+        
+            if (ravePlatform == "X86_64") Compiler::features += "+64bit,";
+
+            if (Compiler::features.length() > 0) Compiler::features = Compiler::features.substr(0, Compiler::features.length() - 1);
+        }
+        else Compiler::features = std::string(LLVMGetHostCPUFeatures());
+
+        initializeBackend();
+
+        target.triple = LLVMNormalizeTargetTriple(Compiler::outType.c_str());
+        target.machine = createTargetMachine(target.triple);
+        target.isReady = true;
+
+        Compiler::startupTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     }
-    else LLVMDisposeErrorMessage(errors);
-    LLVMSetTarget(generator->lModule, triple);
+
+    AST::aliasTable[Symbol("__RAVE_PLATFORM")] = new NodeString(ravePlatform, false);
+    AST::aliasTable[Symbol("__RAVE_OS")] = new NodeString(raveOs, false);
+    AST::aliasTable[Symbol("__RAVE_OPTIMIZATION_LEVEL")] = new NodeInt(settings.optLevel);
+    AST::aliasTable[Symbol("__RAVE_RUNTIME_CHECKS")] = new NodeBool(!settings.noChecks);
+
+    AST::aliasTable[Symbol("__RAVE_POPCNT")] = new NodeBool(target.popcnt);
+    AST::aliasTable[Symbol("__RAVE_FMA")] = new NodeBool(target.fma);
+    AST::aliasTable[Symbol("__RAVE_F16C")] = new NodeBool(target.f16c);
+    AST::aliasTable[Symbol("__RAVE_SSE")] = new NodeBool(target.sse);
+    AST::aliasTable[Symbol("__RAVE_SSE2")] = new NodeBool(target.sse2);
+    AST::aliasTable[Symbol("__RAVE_SSE3")] = new NodeBool(target.sse3);
+    AST::aliasTable[Symbol("__RAVE_SSSE3")] = new NodeBool(target.ssse3);
+    AST::aliasTable[Symbol("__RAVE_SSE4A")] = new NodeBool(target.sse4a);
+    AST::aliasTable[Symbol("__RAVE_SSE4_1")] = new NodeBool(target.sse4_1);
+    AST::aliasTable[Symbol("__RAVE_SSE4_2")] = new NodeBool(target.sse4_2);
+    AST::aliasTable[Symbol("__RAVE_AVX")] = new NodeBool(target.avx);
+    AST::aliasTable[Symbol("__RAVE_AVX2")] = new NodeBool(target.avx2);
+    AST::aliasTable[Symbol("__RAVE_AVX512")] = new NodeBool(target.avx512);
+
+    AST::aliasTable[Symbol("__RAVE_ASIMD")] = new NodeBool(target.asimd);
+    AST::aliasTable[Symbol("__RAVE_FP_ARMV8")] = new NodeBool(target.fp);
+    AST::aliasTable[Symbol("__RAVE_SVE")] = new NodeBool(target.sve);
+    AST::aliasTable[Symbol("__RAVE_SVE2")] = new NodeBool(target.sve2);
+
+    AST::aliasTable[Symbol("__RAVE_HALF")] = new NodeBool(target.half);
+
+    AST::aliasTable[Symbol("__RAVE_LITTLE_ENDIAN")] = new NodeBool(target.littleEndian);
+    AST::aliasTable[Symbol("__RAVE_BIG_ENDIAN")] = new NodeBool(!target.littleEndian);
+
+    if (ravePlatform == "X86_64" || ravePlatform == "AARCH64" || ravePlatform == "POWERPC64" || ravePlatform == "MIPS64") pointerSize = 64;
+    else if (ravePlatform == "AVR") pointerSize = 16;
+    else pointerSize = 32;
+}
+
+// Creates the target machine of the triple with the current features.
+static LLVMTargetMachineRef createTargetMachine(char* triple) {
+    char* errors = nullptr;
+    LLVMTargetRef target;
 
     LLVMGetTargetFromTriple(triple, &target, &errors);
     if (errors != nullptr) {
@@ -483,7 +750,7 @@ void Compiler::compile(std::string file) {
     }
     else LLVMDisposeErrorMessage(errors);
 
-    LLVMTargetMachineRef machine = LLVMCreateTargetMachine(
+    return LLVMCreateTargetMachine(
 		target,
 		triple,
 		"generic",
@@ -491,16 +758,28 @@ void Compiler::compile(std::string file) {
 		(Compiler::settings.optLevel < 3 ? LLVMCodeGenLevelDefault : LLVMCodeGenLevelAggressive),
         (Compiler::settings.isPIC ? LLVMRelocPIC : LLVMRelocDynamicNoPic),
 	LLVMCodeModelDefault);
+}
 
-    generator->targetData = LLVMCreateTargetDataLayout(machine);
-    LLVMSetDataLayout(generator->lModule, LLVMCopyStringRepOfTargetData(generator->targetData));
+// Runs the optimization pipeline over the module.
+// With -flto every TU gets the pre-link pipeline, and the merged module (wholeProgram) gets the LTO one.
+static void runPasses(LLVMModuleRef module, LLVMTargetMachineRef machine, bool wholeProgram) {
+    TIME_TRACE_SCOPE("Optimize", std::string(wholeProgram ? "lto" : (Compiler::settings.lto ? "lto-pre-link" : "default")) + "<O" + std::to_string(Compiler::settings.optLevel) + ">");
 
-    for (size_t i=0; i<parser.nodes.size(); i++) parser.nodes[i]->generate();
+    // The legacy pass manager lost its LTO pipeline in LLVM 15, so the merged module always goes through the new one
+    if (wholeProgram) {
+        if (Compiler::settings.optLevel < 1 || Compiler::settings.optLevel > 3) return;
+
+        LLVMPassBuilderOptionsRef pbOptions = LLVMCreatePassBuilderOptions();
+        LLVMRunPasses(module, ("lto<O" + std::to_string(Compiler::settings.optLevel) + ">").c_str(), machine, pbOptions);
+        LLVMDisposePassBuilderOptions(pbOptions);
+        return;
+    }
 
     #if LLVM_VERSION < 17
     LLVMPassManagerRef pm = LLVMCreatePassManager();
 
     if (Compiler::settings.optLevel > 0) {
+        LLVMAddLowerExpectIntrinsicPass(pm); // Turns llvm.expect (likely/unlikely, runtime checks) into branch weights
         LLVMAddPromoteMemoryToRegisterPass(pm);
         LLVMAddInstructionCombiningPass(pm);
         LLVMAddReassociatePass(pm);
@@ -533,49 +812,571 @@ void Compiler::compile(std::string file) {
         LLVMPassManagerBuilderPopulateModulePassManager(pmb, pm);
     }
 
-    LLVMRunPassManager(pm, generator->lModule);
+    LLVMRunPassManager(pm, module);
     #else
     LLVMPassBuilderOptionsRef pbOptions = LLVMCreatePassBuilderOptions();
+    std::string pipeline = Compiler::settings.lto ? "lto-pre-link" : "default";
 
-    if (Compiler::settings.optLevel == 1) LLVMRunPasses(generator->lModule, "default<O1>", machine, pbOptions);
-    else if (Compiler::settings.optLevel == 2) LLVMRunPasses(generator->lModule, "default<O2>", machine, pbOptions);
-    else if (Compiler::settings.optLevel == 3) LLVMRunPasses(generator->lModule, "default<O3>", machine, pbOptions);
+    if (Compiler::settings.optLevel >= 1 && Compiler::settings.optLevel <= 3)
+        LLVMRunPasses(module, (pipeline + "<O" + std::to_string(Compiler::settings.optLevel) + ">").c_str(), machine, pbOptions);
 
     LLVMDisposePassBuilderOptions(pbOptions);
     #endif
+}
 
-    std::string objectFile;
-    // When -c is used with -o and there's only one source file, use the output path
-    if (Compiler::settings.onlyObject && Compiler::outFile != "" && Compiler::files.size() == 1 && file == Compiler::files[0]) {
-        objectFile = Compiler::outFile;
-    } else {
-        objectFile = replaceExtension(file, ".rave", ".o");
+static bool isLocalLinkage(LLVMLinkage linkage) {
+    return linkage == LLVMInternalLinkage || linkage == LLVMPrivateLinkage;
+}
+
+// Number of instructions in the function, used to balance the codegen partitions.
+static size_t functionSize(LLVMValueRef function) {
+    size_t size = 0;
+
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(function); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        for (LLVMValueRef inst = LLVMGetFirstInstruction(block); inst != nullptr; inst = LLVMGetNextInstruction(inst)) size += 1;
+    }
+
+    return size;
+}
+
+// Turns the function definition into a declaration.
+static void dropBody(LLVMValueRef function) {
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(function); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        for (LLVMValueRef inst = LLVMGetFirstInstruction(block); inst != nullptr; inst = LLVMGetNextInstruction(inst)) {
+            if (LLVMGetTypeKind(LLVMTypeOf(inst)) != LLVMVoidTypeKind) LLVMReplaceAllUsesWith(inst, LLVMGetUndef(LLVMTypeOf(inst)));
+        }
+    }
+
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(function); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        while (LLVMGetFirstInstruction(block) != nullptr) LLVMInstructionEraseFromParent(LLVMGetFirstInstruction(block));
+    }
+
+    while (LLVMGetFirstBasicBlock(function) != nullptr) LLVMDeleteBasicBlock(LLVMGetFirstBasicBlock(function));
+
+    LLVMGlobalClearMetadata(function);
+}
+
+// Leaves only the functions of the partition defined in the module; globals are defined by the first partition only.
+// Local symbols are promoted to hidden ones (with the tag in the name to keep them unique between files), so the partitions can reference each other.
+static void keepPartition(LLVMModuleRef module, std::vector<int>& partitions, int partition, const std::string& tag) {
+    size_t index = 0;
+
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != nullptr; function = LLVMGetNextFunction(function), index++) {
+        if (LLVMIsDeclaration(function)) continue;
+
+        if (isLocalLinkage(LLVMGetLinkage(function))) {
+            LLVMSetValueName(function, (std::string(LLVMGetValueName(function)) + ".part." + std::to_string(index) + "." + tag).c_str());
+            LLVMSetLinkage(function, LLVMExternalLinkage);
+            LLVMSetVisibility(function, LLVMHiddenVisibility);
+        }
+
+        if (partitions[index] == partition || LLVMGetLinkage(function) == LLVMAvailableExternallyLinkage) continue;
+
+        dropBody(function);
+        LLVMSetComdat(function, nullptr);
+        LLVMSetLinkage(function, LLVMExternalLinkage);
+    }
+
+    index = 0;
+    std::vector<LLVMValueRef> intrinsicGlobals;
+
+    for (LLVMValueRef global = LLVMGetFirstGlobal(module); global != nullptr; global = LLVMGetNextGlobal(global), index++) {
+        if (LLVMIsDeclaration(global)) continue;
+
+        std::string name = LLVMGetValueName(global);
+        if (name.rfind("llvm.", 0) == 0) {
+            if (partition != 0) intrinsicGlobals.push_back(global);
+            continue;
+        }
+
+        if (isLocalLinkage(LLVMGetLinkage(global))) {
+            LLVMSetValueName(global, (name + ".global." + std::to_string(index) + "." + tag).c_str());
+            LLVMSetLinkage(global, LLVMExternalLinkage);
+            LLVMSetVisibility(global, LLVMHiddenVisibility);
+        }
+
+        if (partition == 0 || LLVMGetLinkage(global) == LLVMAvailableExternallyLinkage) continue;
+
+        LLVMSetInitializer(global, nullptr);
+        LLVMSetComdat(global, nullptr);
+        LLVMSetLinkage(global, LLVMExternalLinkage);
+    }
+
+    for (size_t i=0; i<intrinsicGlobals.size(); i++) LLVMDeleteGlobal(intrinsicGlobals[i]);
+}
+
+// Writes the buffer next to the path and renames it into place, so other builds never see a partially written object.
+static void writeObject(LLVMMemoryBufferRef buffer, std::string path) {
+    std::string tmpPath = path + "." + std::to_string(getpid()) + ".tmp";
+
+    std::ofstream output(tmpPath, std::ios::binary);
+    output.write(LLVMGetBufferStart(buffer), LLVMGetBufferSize(buffer));
+    output.close();
+
+    std::error_code error;
+    if (!output.good()) Compiler::error("cannot write \033[1m" + tmpPath + "\033[22m!");
+
+    fs::rename(tmpPath, path, error);
+    if (error) {
+        std::remove(tmpPath.c_str());
+        Compiler::error("cannot write \033[1m" + path + "\033[22m: " + error.message());
+    }
+}
+
+// Emits the module as an object file.
+// With --codegen-threads the functions are split into balanced partitions that are emitted on separate threads
+// (each one with its own context and target machine) and joined back by a relocatable link.
+static void emitObject(LLVMModuleRef module, std::string objectFile) {
+    TIME_TRACE_SCOPE("Emit", objectFile);
+    char* errors = nullptr;
+
+    std::vector<LLVMValueRef> functions;
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != nullptr; function = LLVMGetNextFunction(function)) functions.push_back(function);
+
+    std::vector<size_t> bySize;
+    for (size_t i=0; i<functions.size(); i++) {
+        if (!LLVMIsDeclaration(functions[i])) bySize.push_back(i);
+    }
+
+    int threads = Compiler::settings.codegenThreads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min((int)bySize.size(), threads);
+
+    if (threads < 2) {
+        LLVMMemoryBufferRef object = nullptr;
+        LLVMTargetMachineEmitToMemoryBuffer(target.machine, module, LLVMObjectFile, &errors, &object);
+        if (errors != nullptr) {
+            Compiler::error("target machine emit to memory buffer: " + std::string(errors));
+            std::exit(1);
+        }
+
+        writeObject(object, objectFile);
+        LLVMDisposeMemoryBuffer(object);
+        return;
+    }
+
+    // The biggest functions go first, each one to the least loaded partition
+    std::vector<size_t> sizes(functions.size(), 0);
+    for (size_t i=0; i<bySize.size(); i++) sizes[bySize[i]] = functionSize(functions[bySize[i]]);
+    std::stable_sort(bySize.begin(), bySize.end(), [&](size_t a, size_t b) {return sizes[a] > sizes[b];});
+
+    std::vector<int> partitions(functions.size(), 0);
+    std::vector<size_t> loads(threads, 0);
+
+    for (size_t i=0; i<bySize.size(); i++) {
+        int partition = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        partitions[bySize[i]] = partition;
+        loads[partition] += sizes[bySize[i]] + 1;
+    }
+
+    LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(module);
+    std::string tag = hashString(objectFile);
+
+    // The first partition uses the shared machine, the others keep theirs for the next files
+    static std::vector<LLVMTargetMachineRef> machines = {target.machine};
+    while (machines.size() < (size_t)threads) machines.push_back(createTargetMachine(target.triple));
+
+    std::vector<std::string> parts(threads);
+    std::vector<std::string> failures(threads);
+    std::vector<std::thread> workers;
+
+    for (int i=0; i<threads; i++) {
+        parts[i] = objectFile + "." + std::to_string(getpid()) + ".part" + std::to_string(i) + ".o";
+    }
+
+    for (int i=0; i<threads; i++) workers.push_back(std::thread([&, i]() {
+        TIME_TRACE_SCOPE("Emit partition", parts[i]);
+        LLVMContextRef context = LLVMContextCreate();
+        LLVMModuleRef part;
+
+        if (LLVMParseBitcodeInContext2(context, bitcode, &part) != 0) failures[i] = "cannot read the module back";
+        else {
+            keepPartition(part, partitions, i, tag);
+
+            char* message = nullptr;
+            LLVMTargetMachineEmitToFile(machines[i], part, (char*)parts[i].c_str(), LLVMObjectFile, &message);
+            if (message != nullptr) {
+                failures[i] = message;
+                LLVMDisposeMessage(message);
+            }
+
+            LLVMDisposeModule(part);
+        }
+
+        LLVMContextDispose(context);
+    }));
+
+    std::vector<std::string> linkParts;
+    addFlags(linkParts, Compiler::options["compiler"].template get<std::string>());
+    linkParts.push_back("-r");
+    linkParts.push_back("-nostdlib");
+
+    for (int i=0; i<threads; i++) {
+        workers[i].join();
+        linkParts.push_back(parts[i]);
+    }
+
+    LLVMDisposeMemoryBuffer(bitcode);
+
+    for (int i=0; i<threads; i++) {
+        if (failures[i] != "") Compiler::error("target machine emit to file: " + failures[i]);
+    }
+
+    std::string joined = objectFile + "." + std::to_string(getpid()) + ".tmp";
+    TimeTrace::begin("Join partitions", objectFile);
+    linkParts.push_back("-o");
+    linkParts.push_back(joined);
+    ShellResult result = spawn(linkParts);
+    TimeTrace::end();
+    for (int i=0; i<threads; i++) std::remove(parts[i].c_str());
+
+    if (result.status != 0) {
+        std::remove(joined.c_str());
+        Compiler::error("error when joining the codegen partitions!\nLinking string: '" + joinArguments(linkParts) + "'");
+        std::exit(result.status);
     }
 
+    std::error_code error;
+    fs::rename(joined, objectFile, error);
+    if (error) Compiler::error("cannot write \033[1m" + objectFile + "\033[22m: " + error.message());
+}
+
+void Compiler::compile(std::string file) {
+    TIME_TRACE_SCOPE("Compile file", file);
+    Arena::Scope arenaScope(&unitArena);
+
+    std::ifstream fContent(file);
+    std::string content = "";
+
+    char c;
+    while (fContent.get(c)) content += c;
+
+    size_t linkArgumentsSize = Compiler::linkArguments.size();
+    size_t addToImportSize = AST::addToImport.size();
+
+    Compiler::setupTarget();
+
+    AST::mainFile = Compiler::files[0];
+    AST::currentFile = file;
+
+    Lexer lexer(content, -1);
+    Parser parser = Parser(lexer.tokens, file);
+    parser.importDirectories = Compiler::settings.importDirectories;
+
+    if (!Compiler::settings.noPrelude && !endsWith(file, "std/prelude.rave") && !endsWith(file, "std/memory.rave")) {
+        parser.nodes.push_back(new NodeImport(ImportFile{exePath + "std/prelude.rave", true}, {}, -1));
+        parser.nodes.push_back(new NodeImport(ImportFile{exePath + "std/memory.rave", true}, {}, -1));
+    }
+
+    parser.parseAll();
+
+    {
+        TIME_TRACE_SCOPE("Check", file);
+        for (size_t i=0; i<parser.nodes.size(); i++) parser.nodes[i]->check();
+    }
+
+    // Imports are lexed and parsed inside the generation, that time is already counted by lexTime and parseTime
+    double nestedTime = Compiler::lexTime + Compiler::parseTime;
+    auto start = std::chrono::steady_clock::now();
+
+    // The module of the previous unit is only kept for -emit-llvm
+    if (generator != nullptr) delete generator;
+    generator = new LLVMGen(file, Compiler::settings, Compiler::options);
+
+    if (settings.outDebugInfo) debugInfo = new DebugGen(settings, file, generator->lModule);
+    else debugInfo = nullptr;
+
+    LLVMSetTarget(generator->lModule, target.triple);
+
+    generator->targetData = LLVMCreateTargetDataLayout(target.machine);
+    LLVMSetDataLayout(generator->lModule, LLVMCopyStringRepOfTargetData(generator->targetData));
+
+    {
+        TIME_TRACE_SCOPE("Generate", file);
+        for (size_t i=0; i<parser.nodes.size(); i++) parser.nodes[i]->generate();
+    }
+
+    runPasses(generator->lModule, target.machine, false);
+    LoopHints::report(generator->lModule);
+
+    std::string objectFile = Compiler::getObjectFile(file);
+
     if (debugInfo) {
         delete debugInfo;
         debugInfo = nullptr;
     }
 
-    LLVMTargetMachineEmitToFile(machine, generator->lModule, (char*)objectFile.c_str(), LLVMObjectFile, &errors);
-    if (errors != nullptr) {
-        Compiler::error("target machine emit to file: " + std::string(errors));
-        std::exit(1);
+    if (Compiler::settings.lto) {
+        TIME_TRACE_SCOPE("Write bitcode", objectFile);
+        LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(generator->lModule);
+        writeObject(bitcode, objectFile);
+        LLVMDisposeMemoryBuffer(bitcode);
     }
+    else emitObject(generator->lModule, objectFile);
 
     auto end = std::chrono::steady_clock::now();
-    Compiler::genTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    nestedTime = Compiler::lexTime + Compiler::parseTime - nestedTime;
+    Compiler::genTime += std::chrono::duration<double, std::milli>(end - start).count() - nestedTime;
 
     for (size_t i=0; i<AST::importedFiles.size(); i++) {
         if (std::find(Compiler::toImport.begin(), Compiler::toImport.end(), AST::importedFiles[i]) == Compiler::toImport.end()) Compiler::toImport.push_back(AST::importedFiles[i]);
     }
 
+    if (Compiler::settings.incremental) saveDependencies(file, objectFile, content, linkArgumentsSize, addToImportSize);
+
     Compiler::clearAll();
+    unitArena.release();
+}
+
+#ifndef _WIN32
+struct UnitWorker {
+    pid_t pid;
+    FILE* output;
+    FILE* result;
+    FILE* trace;
+    int status;
+    std::string outputText;
+    std::string resultText;
+};
+
+// Reads the temporary file of a finished worker and closes it
+static std::string readWorkerFile(FILE* file) {
+    std::string text;
+    char buffer[4096];
+    size_t count;
+
+    rewind(file);
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, count);
+    fclose(file);
+
+    return text;
+}
+#endif
+
+// Compiles every unit with compileUnit(), using up to settings.jobs worker processes.
+// Each worker gets a forked copy of the global compiler state, so units do not share AST or LLVM tables.
+// Worker output and discovered imports are merged back in the order of units, which keeps diagnostics and link order deterministic.
+// The temporary files of a worker are read and closed once it exits, so only the running workers keep files open.
+void Compiler::compileUnits(std::vector<std::string> units, std::function<void(std::string)> compileUnit) {
+    int jobs = Compiler::settings.jobs;
+    if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    #ifndef _WIN32
+    if (jobs > 1 && units.size() > 1) {
+        std::vector<UnitWorker> workers(units.size());
+        size_t toImportSize = Compiler::toImport.size();
+        size_t addToImportSize = AST::addToImport.size();
+        size_t started = 0, running = 0;
+
+        std::cout.flush();
+        fflush(stdout);
+
+        while (started < units.size() || running > 0) {
+            if (started < units.size() && running < (size_t)jobs) {
+                UnitWorker& worker = workers[started];
+                worker.output = tmpfile();
+                worker.result = tmpfile();
+                worker.trace = TimeTrace::enabled ? tmpfile() : nullptr;
+                if (worker.output == nullptr || worker.result == nullptr || (TimeTrace::enabled && worker.trace == nullptr)) Compiler::error("tmpfile() failed!");
+
+                worker.pid = fork();
+                if (worker.pid < 0) Compiler::error("fork() failed!");
+
+                if (worker.pid == 0) {
+                    dup2(fileno(worker.output), 1);
+                    dup2(fileno(worker.output), 2);
+
+                    Compiler::lexTime = Compiler::parseTime = Compiler::genTime = 0.0;
+                    TimeTrace::clear();
+                    size_t linkArgumentsSize = Compiler::linkArguments.size();
+                    compileUnit(units[started]);
+
+                    if (worker.trace != nullptr) {
+                        TimeTrace::save(worker.trace);
+                        fflush(worker.trace);
+                    }
+
+                    fprintf(worker.result, "T %f %f %f\n", Compiler::lexTime, Compiler::parseTime, Compiler::genTime);
+                    for (size_t i=linkArgumentsSize; i<Compiler::linkArguments.size(); i++) fprintf(worker.result, "L %s\n", Compiler::linkArguments[i].c_str());
+                    for (size_t i=toImportSize; i<Compiler::toImport.size(); i++) fprintf(worker.result, "I %s\n", Compiler::toImport[i].c_str());
+                    for (size_t i=addToImportSize; i<AST::addToImport.size(); i++) fprintf(worker.result, "A %s\n", AST::addToImport[i].c_str());
+
+                    std::cout.flush();
+                    fflush(worker.result);
+                    _exit(0);
+                }
+
+                started += 1;
+                running += 1;
+                continue;
+            }
+
+            int status;
+            pid_t pid = wait(&status);
+            if (pid < 0) Compiler::error("wait() failed!");
+
+            for (size_t i=0; i<started; i++) {
+                UnitWorker& worker = workers[i];
+                if (worker.pid != pid) continue;
+
+                worker.status = status;
+                worker.outputText = readWorkerFile(worker.output);
+                worker.resultText = readWorkerFile(worker.result);
+
+                if (worker.trace != nullptr) {
+                    TimeTrace::load(worker.trace);
+                    fclose(worker.trace);
+                }
+
+                running -= 1;
+                break;
+            }
+        }
+
+        for (auto& worker : workers) {
+            std::cout.write(worker.outputText.data(), worker.outputText.size());
+            std::cout.flush();
+
+            if (!WIFEXITED(worker.status) || WEXITSTATUS(worker.status) != 0) std::exit(WIFEXITED(worker.status) ? WEXITSTATUS(worker.status) : 1);
+
+            std::istringstream result(worker.resultText);
+            std::string line;
+            while (std::getline(result, line)) {
+                if (line.size() < 2) continue;
+                std::string value = line.substr(2);
+
+                if (line[0] == 'T') {
+                    double lex, parse, gen;
+                    if (sscanf(value.c_str(), "%lf %lf %lf", &lex, &parse, &gen) == 3) {
+                        Compiler::lexTime += lex;
+                        Compiler::parseTime += parse;
+                        Compiler::genTime += gen;
+                    }
+                }
+                else if (line[0] == 'I') {
+                    if (std::find(Compiler::toImport.begin(), Compiler::toImport.end(), value) == Compiler::toImport.end()) Compiler::toImport.push_back(value);
+                }
+                else if (line[0] == 'A') AST::addToImport.push_back(value);
+                else if (line[0] == 'L') Compiler::linkArguments.push_back(value);
+            }
+        }
+
+        return;
+    }
+    #endif
+
+    for (size_t i=0; i<units.size(); i++) compileUnit(units[i]);
+}
+
+// Compiles one of the imported files and puts the standard library object into the cache.
+static void compileImport(std::string file) {
+    Compiler::compile(file);
+
+    if (Compiler::settings.emitLLVM) {
+        char* err;
+        LLVMPrintModuleToFile(generator->lModule, (file + ".ll").c_str(), &err);
+    }
+}
+
+// Gives every definition except the entry point internal linkage, so the whole-program pipeline can inline, specialize and drop it.
+static void internalizeModule(LLVMModuleRef module) {
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != nullptr; function = LLVMGetNextFunction(function)) {
+        if (LLVMIsDeclaration(function)) continue;
+
+        std::string name = LLVMGetValueName(function);
+        if (name == "main" || name.rfind("llvm.", 0) == 0) continue;
+
+        LLVMLinkage linkage = LLVMGetLinkage(function);
+        if (linkage == LLVMExternalLinkage || linkage == LLVMLinkOnceAnyLinkage || linkage == LLVMLinkOnceODRLinkage ||
+            linkage == LLVMWeakAnyLinkage || linkage == LLVMWeakODRLinkage) {
+            LLVMSetComdat(function, nullptr);
+            LLVMSetLinkage(function, LLVMInternalLinkage);
+        }
+    }
+
+    for (LLVMValueRef global = LLVMGetFirstGlobal(module); global != nullptr; global = LLVMGetNextGlobal(global)) {
+        if (LLVMIsDeclaration(global)) continue;
+
+        std::string name = LLVMGetValueName(global);
+        if (name.rfind("llvm.", 0) == 0) continue;
+
+        LLVMLinkage linkage = LLVMGetLinkage(global);
+        if (linkage == LLVMExternalLinkage || linkage == LLVMLinkOnceAnyLinkage || linkage == LLVMLinkOnceODRLinkage ||
+            linkage == LLVMWeakAnyLinkage || linkage == LLVMWeakODRLinkage) {
+            LLVMSetComdat(global, nullptr);
+            LLVMSetLinkage(global, LLVMInternalLinkage);
+        }
+    }
+}
+
+// Links the bitcode of every unit (-flto) into one module, runs the whole-program pipeline over it and emits a single object.
+static void linkTimeOptimize(std::vector<std::string>& modules, std::string objectFile, bool internalize) {
+    TIME_TRACE_SCOPE("Link-time optimization", objectFile);
+    auto start = std::chrono::steady_clock::now();
+
+    LLVMContextRef context = LLVMContextCreate();
+    LLVMModuleRef program = nullptr;
+
+    TimeTrace::begin("Link modules", std::to_string(modules.size()) + " modules");
+
+    for (size_t i=0; i<modules.size(); i++) {
+        LLVMMemoryBufferRef buffer;
+        char* message = nullptr;
+
+        if (LLVMCreateMemoryBufferWithContentsOfFile(modules[i].c_str(), &buffer, &message) != 0) {
+            Compiler::error("cannot read \033[1m" + modules[i] + "\033[22m: " + std::string(message));
+            return;
+        }
+
+        LLVMModuleRef module;
+        bool failed = LLVMParseBitcodeInContext2(context, buffer, &module) != 0;
+        LLVMDisposeMemoryBuffer(buffer);
+        if (failed) {
+            Compiler::error("cannot parse the bitcode of \033[1m" + modules[i] + "\033[22m!");
+            return;
+        }
+
+        if (program == nullptr) program = module;
+        else if (LLVMLinkModules2(program, module) != 0) {
+            Compiler::error("cannot link \033[1m" + modules[i] + "\033[22m into the program!");
+            return;
+        }
+    }
+
+    TimeTrace::end();
+
+    if (internalize) internalizeModule(program);
+
+    runPasses(program, target.machine, true);
+
+    char* errors = nullptr;
+
+    if (Compiler::settings.emitLLVM) LLVMPrintModuleToFile(program, (Compiler::outFile + ".ll").c_str(), &errors);
+
+    emitObject(program, objectFile);
+
+    LLVMDisposeModule(program);
+    LLVMContextDispose(context);
+
+    Compiler::genTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 void Compiler::compileAll() {
     AST::debugMode = Compiler::debugMode;
+    TimeTrace::begin("Build", Compiler::outFile);
+
+    // Set up before the workers are forked, so they all share the initialized backend
+    Compiler::setupTarget();
     std::vector<std::string> toRemove;
+    std::vector<std::string> units;
+
+    // With -flto the units are bitcode modules, linked together before the codegen
+    std::vector<std::string> ltoModules;
+    bool hasForeignObjects = false;
+    auto addModule = [&](std::string module) {
+        if (Compiler::settings.lto) ltoModules.push_back(module);
+        else Compiler::linkArguments.push_back(module);
+    };
 
     for (size_t i=0; i<Compiler::files.size(); i++) {
         if (access(Compiler::files[i].c_str(), 0) != 0) {
@@ -583,27 +1384,27 @@ void Compiler::compileAll() {
             return;
         }
 
-        if (Compiler::files[i].size() > 2 && (endsWith(Compiler::files[i], ".a") || endsWith(Compiler::files[i], ".o") || endsWith(Compiler::files[i], ".lib")))
-            Compiler::linkString += Compiler::files[i] + " ";
+        if (Compiler::files[i].size() > 2 && (endsWith(Compiler::files[i], ".a") || endsWith(Compiler::files[i], ".o") || endsWith(Compiler::files[i], ".lib"))) {
+            Compiler::linkArguments.push_back(Compiler::files[i]);
+            hasForeignObjects = true;
+        }
         else {
-            Compiler::compile(Compiler::files[i]);
-            if (Compiler::settings.emitLLVM) {
-                char* err;
-                LLVMPrintModuleToFile(generator->lModule, (Compiler::files[i]+".ll").c_str(), &err);
-            }
+            std::string compiledFile = Compiler::getObjectFile(Compiler::files[i]);
+            addModule(compiledFile);
+            if (!Compiler::settings.saveObjectFiles && (!Compiler::settings.onlyObject || Compiler::settings.lto) && !Compiler::settings.incremental) toRemove.push_back(compiledFile);
 
-            std::string compiledFile;
-            // When -c is used with -o and there's only one source file, use the output path
-            if (Compiler::settings.onlyObject && Compiler::outFile != "" && Compiler::files.size() == 1) {
-                compiledFile = Compiler::outFile;
-            } else {
-                compiledFile = replaceExtension(Compiler::files[i], ".rave", ".o");
-            }
-            Compiler::linkString += compiledFile + " ";
-            if (!Compiler::settings.saveObjectFiles && !Compiler::settings.onlyObject) toRemove.push_back(compiledFile);
+            if (!Compiler::reuseObject(Compiler::files[i], compiledFile)) units.push_back(Compiler::files[i]);
         }
     }
 
+    Compiler::compileUnits(units, [](std::string file) {
+        Compiler::compile(file);
+        if (Compiler::settings.emitLLVM) {
+            char* err;
+            LLVMPrintModuleToFile(generator->lModule, (file + ".ll").c_str(), &err);
+        }
+    });
+
     for (size_t i=0; i<AST::addToImport.size(); i++) {
         std::string fname = replaceAll(AST::addToImport[i], ">", "");
         if (std::count(Compiler::toImport.begin(), Compiler::toImport.end(), fname) == 0 &&
@@ -611,62 +1412,95 @@ void Compiler::compileAll() {
         ) Compiler::toImport.push_back(fname);
     }
 
-    for (size_t i=0; i<Compiler::toImport.size(); i++) {
-        if (access(Compiler::toImport[i].c_str(), 0) != 0) {
-            Compiler::error("file \033[1m" + Compiler::files[i] + "\033[22m does not exist!");
-            return;
-        }
+    // Every pass compiles the files found by the previous one, so independent imports are compiled together
+    for (size_t start=0; start<Compiler::toImport.size();) {
+        size_t end = Compiler::toImport.size();
+        units.clear();
 
-        if (Compiler::toImport[i].size() > 2 && (endsWith(Compiler::toImport[i], ".a") || endsWith(Compiler::toImport[i], ".o") || endsWith(Compiler::toImport[i], ".lib")))
-            Compiler::linkString += Compiler::toImport[i] + " ";
-        else {
-            if (
-                Compiler::toImport[i].find(exePath + "std/") != std::string::npos && !Compiler::settings.recompileStd &&
-                access(replaceExtension(Compiler::toImport[i], ".rave", std::string(".") + Compiler::outType + ".o").c_str(), 0) != -1
-            ) linkString += replaceExtension(Compiler::toImport[i], ".rave", std::string(".") + Compiler::outType + ".o") + " ";
-            else {
-                compile(Compiler::toImport[i]);
+        for (size_t i=start; i<end; i++) {
+            if (access(Compiler::toImport[i].c_str(), 0) != 0) {
+                Compiler::error("file \033[1m" + Compiler::files[i] + "\033[22m does not exist!");
+                return;
+            }
 
-                if (Compiler::settings.emitLLVM) {
-                    char* err;
-                    LLVMPrintModuleToFile(generator->lModule, (Compiler::toImport[i] + ".ll").c_str(), &err);
+            if (Compiler::toImport[i].size() > 2 && (endsWith(Compiler::toImport[i], ".a") || endsWith(Compiler::toImport[i], ".o") || endsWith(Compiler::toImport[i], ".lib"))) {
+                Compiler::linkArguments.push_back(Compiler::toImport[i]);
+                hasForeignObjects = true;
+            }
+            else {
+                if (
+                    Compiler::toImport[i].find(exePath + "std/") != std::string::npos && !Compiler::settings.recompileStd &&
+                    access(Compiler::getStdObject(Compiler::toImport[i]).c_str(), 0) != -1
+                ) addModule(Compiler::getStdObject(Compiler::toImport[i]));
+                else {
+                    std::string compiledFile = Compiler::getObjectFile(Compiler::toImport[i]);
+                    addModule(compiledFile);
+
+                    if (Compiler::toImport[i].find(exePath + "std/") != std::string::npos) units.push_back(Compiler::toImport[i]);
+                    else if (!Compiler::settings.incremental) {
+                        units.push_back(Compiler::toImport[i]);
+                        toRemove.push_back(compiledFile);
+                    }
+                    else if (!Compiler::reuseObject(Compiler::toImport[i], compiledFile)) units.push_back(Compiler::toImport[i]);
                 }
+            }
+        }
 
-                std::string compiledFile = replaceExtension(Compiler::toImport[i], ".rave", ".o");
-                linkString += compiledFile + " ";
+        Compiler::compileUnits(units, compileImport);
+        start = end;
+    }
 
-                if (Compiler::toImport[i].find(exePath + "std/") != std::string::npos) {
-                    std::ifstream src(compiledFile, std::ios::binary);
-                    std::ofstream dst(replaceExtension(compiledFile, ".o", std::string(".") + Compiler::outType + ".o"), std::ios::binary);
-                    dst << src.rdbuf();
-                }
+    if (Compiler::settings.lto && !ltoModules.empty()) {
+        std::string objectFile;
+        if (Compiler::settings.onlyObject) objectFile = (Compiler::outFile != "") ? Compiler::outFile : "a.o";
+        else if (Compiler::settings.saveObjectFiles) objectFile = ((Compiler::outFile != "") ? Compiler::outFile : "a") + ".lto.o";
+        else objectFile = getBuildDirectory() + "/program.lto.o";
 
-                toRemove.push_back(compiledFile);
-            }
+        // Only a self-contained executable may hide its symbols: objects, libraries and foreign inputs can still reference them
+        bool internalize = !Compiler::settings.onlyObject && !Compiler::settings.noEntry && !Compiler::settings.noStd && !hasForeignObjects &&
+            std::find(Compiler::settings.linkParams.begin(), Compiler::settings.linkParams.end(), "-shared") == Compiler::settings.linkParams.end();
+
+        linkTimeOptimize(ltoModules, objectFile, internalize);
+
+        if (!Compiler::settings.onlyObject) {
+            Compiler::linkArguments.push_back(objectFile);
+            if (!Compiler::settings.saveObjectFiles) toRemove.push_back(objectFile);
         }
+        else for (size_t i=0; i<toRemove.size(); i++) std::remove(toRemove[i].c_str());
     }
 
     if (Compiler::outFile == "") Compiler::outFile = "a";
 
-    Compiler::linkString += " -Wl,--no-relax ";
+    Compiler::linkArguments.push_back("-Wl,--no-relax");
 
     // TODO: Add support of linking on AVR, improve settings.onlyObject handling
 
     if (!Compiler::settings.onlyObject) {
-        if (Compiler::settings.isStatic) Compiler::linkString += "-static ";
-        if (Compiler::settings.isPIC) Compiler::linkString += "-no-pie ";
+        std::vector<std::string>& linkParams = Compiler::settings.linkParams;
+        if (Compiler::settings.isStatic) Compiler::linkArguments.push_back("-static");
+        if (Compiler::settings.isPIC) Compiler::linkArguments.push_back("-no-pie");
 
-        if (Compiler::settings.outDebugInfo && raveOs != "WINDOWS") Compiler::linkString += "-g ";
+        if (Compiler::settings.outDebugInfo && raveOs != "WINDOWS") Compiler::linkArguments.push_back("-g");
 
-        Compiler::linkString += " " + Compiler::settings.linkParams + " -Wno-unused-command-line-argument ";
+        Compiler::linkArguments.insert(Compiler::linkArguments.end(), linkParams.begin(), linkParams.end());
+        Compiler::linkArguments.push_back("-Wno-unused-command-line-argument");
 
         #ifdef _WIN32
-            if (Compiler::options["compiler"].template get<std::string>().find("clang") != std::string::npos) Compiler::linkString += " -fuse-ld=ld ";
+            if (Compiler::options["compiler"].template get<std::string>().find("clang") != std::string::npos) Compiler::linkArguments.push_back("-fuse-ld=ld");
+        #else
+            // Use the linker of --linker, but only if it is installed: otherwise the driver keeps its own
+            bool hasFuseLd = std::any_of(linkParams.begin(), linkParams.end(), [](const std::string& param) {return param.rfind("-fuse-ld=", 0) == 0;});
+            if (Compiler::settings.linker != "" && !hasFuseLd && (inPath("ld." + Compiler::settings.linker) || inPath(Compiler::settings.linker)))
+                Compiler::linkArguments.push_back("-fuse-ld=" + Compiler::settings.linker);
         #endif
 
-        ShellResult result = exec(Compiler::linkString + " -o " + Compiler::outFile);
+        TimeTrace::begin("Link", Compiler::outFile);
+        Compiler::linkArguments.push_back("-o");
+        Compiler::linkArguments.push_back(Compiler::outFile);
+        ShellResult result = spawn(Compiler::linkArguments);
+        TimeTrace::end();
         if (result.status != 0) {
-            Compiler::error("error when linking!\nLinking string: '" + Compiler::linkString + " -o " + Compiler::outFile + "'");
+            Compiler::error("error when linking!\nLinking string: '" + joinArguments(Compiler::linkArguments) + "'");
             std::exit(result.status);
             return;
         }
@@ -674,5 +1508,8 @@ void Compiler::compileAll() {
         for (size_t i=0; i<toRemove.size(); i++) std::remove(toRemove[i].c_str());
     }
 
-    std::cout << "Time spent by lexer: " << std::to_string(Compiler::lexTime) << "ms\nTime spent by parser: " << std::to_string(Compiler::parseTime) << "ms\nTime spent by generator: " << std::to_string(Compiler::genTime) << "ms" << std::endl;
+    TimeTrace::end();
+    if (TimeTrace::enabled) TimeTrace::write(Compiler::outFile + ".time-trace.json");
+
+    std::cout << "Time spent on startup: " << std::to_string(Compiler::startupTime) << "ms\nTime spent by lexer: " << std::to_string(Compiler::lexTime) << "ms\nTime spent by parser: " << std::to_string(Compiler::parseTime) << "ms\nTime spent by generator: " << std::to_string(Compiler::genTime) << "ms" << std::endl;
 }
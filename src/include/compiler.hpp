@@ -8,9 +8,10 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "./utils.hpp"
 #include "./json.hpp"
+#include <functional>
 
 namespace Compiler {
-    extern std::string linkString;
+    extern std::vector<std::string> linkArguments; // Arguments of the link command, one per element
     extern std::string outFile;
     extern std::string outType;
     extern genSettings settings;
@@ -18,6 +19,7 @@ namespace Compiler {
     extern double lexTime;
     extern double parseTime;
     extern double genTime;
+    extern double startupTime;
     extern std::vector<std::string> files;
     extern std::vector<std::string> toImport;
     extern bool debugMode;
@@ -25,10 +27,16 @@ namespace Compiler {
 
     extern std::string raveOs;
     extern std::string ravePlatform;
+    extern std::string settingsKey; // Hash of the settings that change the generated code
 
     extern void error(std::string message);
     extern void initialize(std::string outFile, std::string outType, genSettings settings, std::vector<std::string> files);
     extern void clearAll();
+    extern std::string getStdObject(std::string file);
+    extern std::string getObjectFile(std::string file);
+    extern bool reuseObject(std::string file, std::string objectFile);
+    extern void setupTarget();
     extern void compile(std::string file);
+    extern void compileUnits(std::vector<std::string> units, std::function<void(std::string)> compileUnit);
     extern void compileAll();
 }
\ No newline at end of file
@@ -9,25 +9,32 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <string>
 #include <iostream>
 #include <vector>
+#include <deque>
 #include "./tokens.hpp"
 #include <inttypes.h>
 
 class Lexer {
 public:
     std::string text = "";
-    std::vector<Token*> tokens;
+    std::vector<Token> tokens;
+    std::deque<std::string> literals; // Decoded string and char literals (a deque never moves its elements)
     int32_t idx = 0;
     int32_t line = 0;
 
     inline char peek() {return text[idx];}
     inline char next() {return text[++idx];}
+    inline StringView view(size_t start) {return StringView(text.data() + start, idx - start);}
 
     std::string unescape(const std::string& str);
-    std::string getIdentifier();
-    std::string getString();
-    std::string getChar();
-    std::string getDigit(char numType);
+    StringView getIdentifier();
+    StringView getPlainLiteral(char quote);
+    StringView getString();
+    StringView getChar();
+    StringView getDigit(char numType);
 
-    Lexer(std::string text, int offset);
-    ~Lexer() {for (size_t i=0; i<tokens.size(); i++) delete tokens[i];}
+    Lexer(std::string source, int offset);
+
+    // Tokens point into the buffers of the lexer
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
 };
\ No newline at end of file
@@ -8,6 +8,15 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <string>
 
+// llvm-config of older LLVM versions forces -std=c++14
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    #include <string_view>
+    using StringView = std::string_view;
+#else
+    #include <experimental/string_view>
+    using StringView = std::experimental::string_view;
+#endif
+
 namespace TokType {
 enum TokType : char {
     String,
@@ -76,31 +85,16 @@ extern bool isCompoundAssigment(char type);
 extern bool isParent(char type);
 }
 
-class Token {
-public:
+// Tokens are plain values stored contiguously by the lexer.
+// The value is a view into the lexer's source buffer (or its decoded literals, or a static string), so it is only valid while the lexer lives.
+struct Token {
     char type;
-    std::string value;
     int line = -1;
+    StringView value;
+
+    Token(char type, StringView value = "", int line = -1) : type(type), line(line), value(value) {}
 
-    Token(char type, std::string value) {
-        this->type = type;
-        this->value = value;
-    }
-
-    Token(char type) {
-        this->type = type;
-        this->value = "";
-    }
-
-    Token(char type, std::string value, int line) {
-        this->type = type;
-        this->value = value;
-        this->line = line;
-    }
-
-    inline Token* copy() {
-        return new Token(this->type, this->value);
-    }
+    inline std::string str() const {return std::string(value.data(), value.size());}
 };
 
 std::string tokenToString(char type);
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace LLVM {
     extern RaveValue alloc(RaveValue size, const char* name);
     extern RaveValue call(RaveValue fn, LLVMValueRef* args, unsigned int argsCount, const char* name, std::vector<int> byVals = {});
     extern RaveValue call(RaveValue fn, std::vector<RaveValue> args, const char* name, std::vector<int> byVals = {});
+    extern RaveValue expect(RaveValue condition, bool expected, const char* name);
     extern RaveValue gep(RaveValue ptr, LLVMValueRef* indices, unsigned int indicesCount, const char* name);
     extern RaveValue cInboundsGep(RaveValue ptr, LLVMValueRef* indices, unsigned int indicesCount);
     extern RaveValue structGep(RaveValue ptr, unsigned int idx, const char* name);
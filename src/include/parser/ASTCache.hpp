@@ -0,0 +1,22 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "./nodes/Node.hpp"
+
+// On-disk cache of parsed imports (std/.cache/<hash>.rast).
+// Entries are keyed by the compiler version, the import path, the import directories, the pointer size and the file content,
+// so a changed file or a different compiler never picks up a stale AST.
+namespace ASTCache {
+    // Loads the nodes of the file from the cache. Returns false if there is no valid entry.
+    extern bool load(const std::string& file, const std::string& content, std::vector<Node*>& nodes);
+
+    // Saves the freshly parsed nodes of the file. Failures are silently ignored.
+    extern void save(const std::string& file, const std::string& content, std::vector<Node*>& nodes);
+}
@@ -0,0 +1,63 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bump allocator for the AST nodes and types.
+// new Node/new Type allocate from Arena::current (or from the heap, if there is no current arena),
+// so everything built for a compilation unit is released at once instead of walking the trees.
+// Nodes and types do not own each other: delete only destroys the object itself,
+// and release() destroys the objects that are still alive and frees the memory.
+class Arena {
+public:
+    enum Object : uint8_t {Dead, NodeObject, TypeObject};
+
+    // Arena used by new Node/new Type, nullptr means the heap
+    static Arena* current;
+
+    explicit Arena(size_t blockSize = 256 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Allocates in the current arena; the object kind is used to destroy it on release()
+    static void* allocate(size_t size, Object object);
+    static void deallocate(void* pointer);
+
+    // Arena that holds the object, nullptr if it was allocated on the heap
+    static Arena* owner(const void* pointer);
+
+    // Destroys the objects that are still alive and frees every block except the first one
+    void release();
+
+    // Bytes taken by the objects allocated since the last release()
+    size_t used() const;
+
+    // Makes the arena current for a C++ scope
+    struct Scope {
+        Arena* previous;
+
+        explicit Scope(Arena* arena) : previous(Arena::current) {Arena::current = arena;}
+        ~Scope() {Arena::current = previous;}
+    };
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+        size_t used;
+    };
+
+    std::vector<Block> blocks;
+    size_t blockSize;
+
+    void* allocateHere(size_t size, Object object);
+};
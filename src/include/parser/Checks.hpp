@@ -0,0 +1,31 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <llvm-c/Core.h>
+#include "../llvm.hpp"
+
+// Runtime checks of the generated code.
+// A failed check branches (as unlikely) to a block that calls the cold out-of-line stub of the function with the line of the check;
+// the stub knows the file and the function, so the sites do not carry their own messages.
+// Without std::__nullCheckFailed (-np) the stub traps without a message.
+namespace Checks {
+    // Checks are enabled by the settings (-nc disables them) and by the current function ((nochecks) disables them)
+    extern bool enabled();
+
+    // Stops the program with an error if the pointer is null; the builder continues in the block of the passed check
+    extern void nullPointer(RaveValue ptr, int loc);
+
+    // Counted loop (see NodeWhile::isCounted) whose body is being generated.
+    // "entered" is the condition of the loop tested before it, "preheaderBranch" is the branch to the header.
+    extern void beginLoop(LLVMValueRef entered, LLVMValueRef preheaderBranch, LLVMBasicBlockRef header, LLVMBasicBlockRef body);
+    extern void endLoop(LLVMBasicBlockRef header);
+
+    // Called once the body of the function is generated:
+    // removes the checks dominated by an identical earlier check and hoists the checks of loop-invariant pointers out of the counted loops
+    extern void finish(LLVMValueRef function);
+}
@@ -9,7 +9,9 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include "./FuncSignature.hpp"
+#include "./Symbol.hpp"
 #include "./ast.hpp"
 
 class NodeFunc;
@@ -74,15 +76,58 @@ public:
 private:
     FuncRegistry() = default;
 
-    // Primary storage: base name -> vector of overloads
-    std::map<std::string, std::vector<NodeFunc*>> functionsByName;
+    struct Candidate {
+        NodeFunc* func;
+        bool isStable;              // The parameter types are not replaced after the registration
+        std::vector<uint32_t> key;  // Types::key of the parameters, only for the stable ones
+    };
 
-    // Method storage: struct name -> method name -> vector of overloads
-    std::map<std::string, std::map<std::string, std::vector<NodeFunc*>>> methodsByStruct;
+    // Overloads registered under one name, bucketed by the number of parameters
+    struct OverloadSet {
+        std::string name;
+        std::vector<NodeFunc*> all; // In the registration order
+        std::unordered_map<size_t, std::vector<Candidate>> byArity;
+
+        // Resolved calls (argument keys -> best overload or nullptr), dropped when an overload is added
+        // or when the generation of the registry changes.
+        // Not used once a template overload is added: the types of its parameters are replaced in place
+        bool isStable = true;
+        mutable std::unordered_map<std::string, NodeFunc*> resolved;
+        mutable uint64_t resolvedGeneration = 0;
+    };
+
+    struct StructMethods {
+        std::unordered_map<Symbol, OverloadSet> byName;
+
+        // "name" -> the sets of "name[...]" and "name<...>", sorted by their names
+        std::unordered_map<Symbol, std::vector<OverloadSet*>> byBaseName;
+    };
+
+    static void addOverload(OverloadSet& set, NodeFunc* func);
+
+    // Scores the overloads with the same number of parameters, keeping the first best one
+    static void scoreOverloads(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key,
+                               NodeFunc*& bestMatch, int& bestScore);
+
+    // Best overload of the set, memoized per argument keys
+    NodeFunc* resolve(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key) const;
+
+    static NodeFunc* findExactIn(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key);
+
+    const OverloadSet* findSet(const std::string& name, const std::string& structContext) const;
+
+    // Primary storage: base name -> overloads
+    std::unordered_map<Symbol, OverloadSet> functionsByName;
+
+    // Method storage: struct name -> method name -> overloads
+    std::unordered_map<Symbol, StructMethods> methodsByStruct;
 
     // Operator storage: struct name -> operator type -> vector of overloads
     std::map<std::string, std::map<int, std::vector<NodeFunc*>>> operatorsByStruct;
 
+    // Bumped when a struct operator or method is registered: the scores of every set depend on the (=) operators of structs
+    uint64_t generation = 0;
+
     // Index for quick mangled name lookup (migration helper)
-    std::map<std::string, NodeFunc*> mangledNameIndex;
+    std::unordered_map<Symbol, NodeFunc*> mangledNameIndex;
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <llvm-c/Core.h>
+#include "parser.hpp"
+#include <vector>
+
+// Loop modifiers: (unroll: 4, vectorize: 8, interleave: 2, distribute) while/for/foreach (...) {...}
+// They are lowered into the llvm.loop metadata of the branches back to the loop header.
+namespace LoopHints {
+    // Attaches the hints to every branch to the header except the one from the preheader
+    extern void attach(std::vector<DeclarMod>& mods, LLVMBasicBlockRef header, LLVMValueRef preheaderBranch, int loc);
+
+    // With -remarks: called once the module is optimized, reports whether each hint of the unit was honored
+    extern void report(LLVMModuleRef module);
+}
@@ -0,0 +1,68 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+// Interned name. Equal strings share one 32-bit id for the whole compilation,
+// so the tables keyed by symbols hash and compare integers instead of strings.
+class Symbol {
+public:
+    uint32_t id = 0; // 0 is the empty string
+
+    Symbol() = default;
+    explicit Symbol(const std::string& name);
+    explicit Symbol(const char* name);
+
+    // Returns the symbol of the name if it was already interned, otherwise the empty symbol
+    static Symbol lookup(const std::string& name);
+    static std::pair<Symbol, Symbol> lookup(const std::string& first, const std::string& second) {return {lookup(first), lookup(second)};}
+
+    // Number of interned names
+    static size_t count();
+
+    const std::string& str() const;
+    operator const std::string&() const {return str();}
+
+    bool empty() const {return id == 0;}
+    size_t size() const {return str().size();}
+    char operator[](size_t i) const {return str()[i];}
+    size_t find(char c, size_t pos = 0) const {return str().find(c, pos);}
+    size_t find(const std::string& s, size_t pos = 0) const {return str().find(s, pos);}
+    std::string substr(size_t pos, size_t n = std::string::npos) const {return str().substr(pos, n);}
+    const char* c_str() const {return str().c_str();}
+
+    friend bool operator==(Symbol a, Symbol b) {return a.id == b.id;}
+    friend bool operator!=(Symbol a, Symbol b) {return a.id != b.id;}
+
+    // Compare with a name without interning it
+    friend bool operator==(Symbol a, const std::string& b) {return a.str() == b;}
+    friend bool operator!=(Symbol a, const std::string& b) {return a.str() != b;}
+    friend bool operator==(Symbol a, const char* b) {return a.str() == b;}
+    friend bool operator!=(Symbol a, const char* b) {return a.str() != b;}
+    friend bool operator==(const std::string& a, Symbol b) {return a == b.str();}
+    friend bool operator!=(const std::string& a, Symbol b) {return a != b.str();}
+
+    friend std::string operator+(const std::string& a, Symbol b) {return a + b.str();}
+    friend std::string operator+(Symbol a, const std::string& b) {return a.str() + b;}
+    friend std::string operator+(const char* a, Symbol b) {return a + b.str();}
+    friend std::string operator+(Symbol a, const char* b) {return a.str() + b;}
+    friend std::string operator+(Symbol a, char b) {return a.str() + b;}
+};
+
+namespace std {
+    template<> struct hash<Symbol> {
+        size_t operator()(Symbol s) const {return s.id;}
+    };
+
+    template<> struct hash<std::pair<Symbol, Symbol>> {
+        size_t operator()(const std::pair<Symbol, Symbol>& p) const {return hash<uint64_t>{}(((uint64_t)p.first.id << 32) | p.second.id);}
+    };
+}
@@ -7,9 +7,41 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #pragma once
 
 #include <string>
+#include "Arena.hpp"
+
+// Kind of the type, used by classof()/instanceof instead of dynamic_cast
+namespace TypeKind {
+    enum TypeKind : char {
+        Basic,
+        Pointer,
+        Array,
+        Alias,
+        Void,
+        Const,
+        Struct,
+        Byval,
+        TemplateMember,
+        TemplateMemberDefinition,
+        FuncArg,
+        Func,
+        Builtin,
+        Call,
+        Auto,
+        LLVM,
+        Vector,
+        Divided,
+    };
+}
 
 class Type {
 public:
+    TypeKind::TypeKind typeKind;
+
+    explicit Type(TypeKind::TypeKind kind) : typeKind(kind) {}
+
+    // Types live in Arena::current and do not own their element types
+    static void* operator new(size_t size) {return Arena::allocate(size, Arena::TypeObject);}
+    static void operator delete(void* pointer) {Arena::deallocate(pointer);}
     virtual int getSize() = 0;
     virtual Type* check(Type* parent) = 0;
     virtual std::string toString() = 0;
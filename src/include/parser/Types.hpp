@@ -13,6 +13,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/Node.hpp"
 #include "../../include/parser/nodes/NodeBlock.hpp"
 #include "Type.hpp"
+#include "Symbol.hpp"
 
 namespace BasicType {
     enum BasicType : char {
@@ -39,6 +40,8 @@ namespace BasicType {
 
 class TypeBasic : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Basic;}
+
     char type;
 
     TypeBasic(char ty);
@@ -55,6 +58,8 @@ extern std::map<char, TypeBasic*> basicTypes;
 
 class TypePointer : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Pointer;}
+
     Type* instance;
 
     TypePointer(Type* instance);
@@ -63,11 +68,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypePointer() override;
 };
 
 class TypeArray : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Array;}
+
     Node* count;
     Type* element;
 
@@ -77,11 +83,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypeArray() override;
 };
 
 class TypeAlias : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Alias;}
+
     TypeAlias();
     Type* copy() override;
     Type* check(Type* parent) override;
@@ -92,6 +99,8 @@ public:
 
 class TypeVoid : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Void;}
+
     TypeVoid();
     Type* copy() override;
     Type* check(Type* parent) override;
@@ -102,6 +111,8 @@ public:
 
 class TypeConst : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Const;}
+
     Type* instance;
 
     TypeConst(Type* instance);
@@ -110,11 +121,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypeConst() override;
 };
 
 class TypeStruct : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Struct;}
+
     std::string name;
     std::vector<Type*> types;
     
@@ -132,6 +144,8 @@ public:
 
 class TypeByval : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Byval;}
+
     Type* type;
     TypeByval(Type* type);
     Type* copy() override;
@@ -143,6 +157,8 @@ public:
 
 class TypeTemplateMember : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::TemplateMember;}
+
     Type* type;
     Node* value;
 
@@ -152,11 +168,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypeTemplateMember() override;
 };
 
 class TypeTemplateMemberDefinition : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::TemplateMemberDefinition;}
+
     std::string name;
     Type* type;
 
@@ -166,11 +183,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypeTemplateMemberDefinition() override;
 };
 
 class TypeFuncArg : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::FuncArg;}
+
     Type* type;
     std::string name;
 
@@ -180,11 +198,12 @@ public:
     int getSize() override;
     std::string toString() override;
     Type* getElType() override;
-    ~TypeFuncArg() override;
 };
 
 class TypeFunc : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Func;}
+
     Type* main;
     std::vector<TypeFuncArg*> args;
     bool isVarArg;
@@ -195,11 +214,12 @@ public:
     std::string toString() override;
     Type* check(Type* parent) override;
     Type* getElType() override;
-    ~TypeFunc() override;
 };
 
 class TypeBuiltin : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Builtin;}
+
     std::string name;
     std::vector<Node*> args;
     NodeBlock* block;
@@ -214,6 +234,8 @@ public:
 
 class TypeCall : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Call;}
+
     std::string name;
     std::vector<Node*> args;
 
@@ -227,6 +249,8 @@ public:
 
 class TypeAuto : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Auto;}
+
     TypeAuto();
     Type* copy() override;
     Type* check(Type* parent) override;
@@ -237,6 +261,8 @@ public:
 
 class TypeLLVM : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::LLVM;}
+
     LLVMTypeRef tr;
     TypeLLVM(LLVMTypeRef tr);
     Type* copy() override;
@@ -248,6 +274,8 @@ public:
 
 class TypeVector : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Vector;}
+
     Type* mainType;
     int count;
 
@@ -261,6 +289,8 @@ public:
 
 class TypeDivided : public Type {
 public:
+    static bool classof(const Type* type) {return type->typeKind == TypeKind::Divided;}
+
     Type* mainType;
     std::vector<Type*> divided;
 
@@ -293,18 +323,16 @@ namespace Types {
     // Strip all qualifiers (TypeConst, TypePointer, TypeArray) to get innermost type
     extern Type* stripQualifiers(Type* type);
 
-    // Helper for destructors - returns true if type should be deleted
-    inline bool shouldDeleteType(Type* type) {
-        return type != nullptr &&
-               !instanceof<TypeBasic>(type) &&
-               !instanceof<TypeVoid>(type);
-    }
+    // Interned rendering of the type: equal keys mean equal toString(), and key().str() is the cached rendering.
+    // Types are changed in place (replaceTemplates, replaceComptime), so the key is looked up on every call,
+    // but pointers and arrays find it by the key of their element instead of building the string again.
+    extern Symbol key(Type* type);
 
-    // Fast type equality: pointer check first, then structural comparison
+    // Fast type equality: pointer check first, then the interned keys
     inline bool typesEqual(Type* a, Type* b) {
         if (a == b) return true;
         if (a == nullptr || b == nullptr) return false;
-        return a->toString() == b->toString();
+        return key(a) == key(b);
     }
 
     // Type flyweight/interning for common compound types
@@ -312,5 +340,7 @@ namespace Types {
     TypeVector* getVectorType(Type* instance, int count);
     TypeArray* getArrayType(Node* count, Type* element);
     TypeConst* getConstType(Type* instance);
+
+    // Forgets the pooled types; they are owned by the arena of the unit that created them
     void clearTypePools();
 }
@@ -26,6 +26,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "./Types.hpp"
 #include "./nodes/Node.hpp"
 #include "../json.hpp"
+#include "./Symbol.hpp"
 #include "../llvm.hpp"
 #include <vector>
 
@@ -63,17 +64,18 @@ namespace std {
 
 namespace AST {
     extern std::unordered_map<std::string, Type*> aliasTypes;
-    extern std::unordered_map<std::string, Node*> aliasTable;
-    extern std::unordered_map<std::string, NodeVar*> varTable;
-    extern std::unordered_map<std::string, NodeFunc*> funcTable;
-    extern std::unordered_map<std::string, std::vector<NodeFunc*>> funcVersionsTable;
-    extern std::unordered_map<std::string, NodeStruct*> structTable;
-    extern std::unordered_map<std::pair<std::string, std::string>, StructMember> structMembersTable;
-    extern std::unordered_map<std::string, NodeLambda*> lambdaTable;
-    extern std::unordered_map<std::pair<std::string, std::string>, NodeFunc*> methodTable;
+    extern std::unordered_map<Symbol, Node*> aliasTable;
+    extern std::unordered_map<Symbol, NodeVar*> varTable;
+    extern std::unordered_map<Symbol, NodeFunc*> funcTable;
+    extern std::unordered_map<Symbol, std::vector<NodeFunc*>> funcVersionsTable;
+    extern std::unordered_map<Symbol, NodeStruct*> structTable;
+    extern std::unordered_map<std::pair<Symbol, Symbol>, StructMember> structMembersTable;
+    extern std::unordered_map<Symbol, NodeLambda*> lambdaTable;
+    extern std::unordered_map<std::pair<Symbol, Symbol>, NodeFunc*> methodTable;
     extern std::vector<std::string> importedFiles;
     extern std::vector<std::string> addToImport;
     extern std::unordered_map<std::string, std::vector<Node*>> parsed;
+    extern Arena parsedArena; // Owns the nodes of parsed, they outlive every unit
     extern std::string mainFile;
     extern std::string currentFile;
     extern bool debugMode;
@@ -120,14 +122,15 @@ public:
     genSettings settings;
     nlohmann::json options;
 
-    std::unordered_map<std::string, RaveValue> globals;
-    std::unordered_map<std::string, RaveValue> functions;
-    std::unordered_map<std::string, LLVMTypeRef> structures;
+    std::unordered_map<Symbol, RaveValue> globals;
+    std::unordered_map<Symbol, NodeVar*> lazyGlobals; // Imported globals, declared on their first lookup
+    std::unordered_map<Symbol, RaveValue> functions;
+    std::unordered_map<Symbol, LLVMTypeRef> structures;
     std::unordered_map<int32_t, Loop> activeLoops;
 
-    std::unordered_map<std::string, Type*> toReplace;
+    std::unordered_map<Symbol, Type*> toReplace;
     std::unordered_map<std::string, Node*> toReplaceValues;
-    std::unordered_map<std::string, LLVMTypeRef> typeCache;
+    std::unordered_map<Symbol, LLVMTypeRef> typeCache;
 
     LLVMBasicBlockRef currBB;
 
@@ -136,12 +139,16 @@ public:
 
     void error(std::string msg, int line);
     void warning(std::string msg, int line);
+    void remark(std::string msg, std::string file, int line);
 
     LLVMGen(std::string file, genSettings settings, nlohmann::json options);
     ~LLVMGen();
 
     std::string mangle(std::string name, bool isFunc, bool isMethod);
 
+    // Looks up a global variable, declaring it first if it was imported and is not used yet
+    std::unordered_map<Symbol, RaveValue>::iterator findGlobal(Symbol name);
+
     LLVMTypeRef genType(Type* type, int loc);
 
     LLVMTypeRef genBasicType(TypeBasic* basicType);
@@ -162,31 +169,31 @@ public:
 
 class Scope {
 public:
-    std::unordered_map<std::string, RaveValue> localScope;
-    std::unordered_map<std::string, int> args;
+    std::unordered_map<Symbol, RaveValue> localScope;
+    std::unordered_map<Symbol, int> args;
     std::string funcName;
     LLVMBasicBlockRef blockExit;
     bool funcHasRet = false;
-    std::unordered_map<std::string, NodeVar*> localVars;
-    std::unordered_map<std::string, NodeVar*> argVars;
-    std::unordered_map<std::string, Node*> aliasTable;
+    std::unordered_map<Symbol, NodeVar*> localVars;
+    std::unordered_map<Symbol, NodeVar*> argVars;
+    std::unordered_map<Symbol, Node*> aliasTable;
     LLVMBasicBlockRef fnEnd;
     std::vector<Node*> defers;
 
-    Scope(std::string funcName, std::unordered_map<std::string, int> args, std::unordered_map<std::string, NodeVar*> argVars);
+    Scope(std::string funcName, std::unordered_map<Symbol, int> args, std::unordered_map<Symbol, NodeVar*> argVars);
 
-    RaveValue get(std::string name, int loc = -1);
-    RaveValue getWithoutLoad(std::string name, int loc = -1);
-    NodeVar* getVar(std::string name, int loc = -1);
+    RaveValue get(Symbol name, int loc = -1);
+    RaveValue getWithoutLoad(Symbol name, int loc = -1);
+    NodeVar* getVar(Symbol name, int loc = -1);
 
     // Helper: get the struct type of "this" variable, returns nullptr if not applicable
     TypeStruct* getThisStructType(int loc = -1);
 
-    bool has(std::string name);
-    bool hasAtThis(std::string name);
-    bool locatedAtThis(std::string name);
-    void hasChanged(std::string name);
-    void remove(std::string name);
+    bool has(Symbol name);
+    bool hasAtThis(Symbol name);
+    bool locatedAtThis(Symbol name);
+    void hasChanged(Symbol name);
+    void remove(Symbol name);
 };
 
 extern LLVMGen* generator;
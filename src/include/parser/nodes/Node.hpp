@@ -8,6 +8,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <llvm-c/Core.h>
 #include "../Type.hpp"
+#include "../Arena.hpp"
 #include "../../llvm.hpp"
 
 struct RetGenStmt {
@@ -15,10 +16,67 @@ struct RetGenStmt {
     LLVMValueRef value;
 };
 
+// Kind of the node, used by classof()/instanceof instead of dynamic_cast
+namespace NodeKind {
+    enum NodeKind : char {
+        None,
+        AliasType,
+        Array,
+        Asm,
+        Binary,
+        Bitcast,
+        Block,
+        Bool,
+        Builtin,
+        Call,
+        Cast,
+        Char,
+        Cmpxchg,
+        Comptime,
+        ConstStruct,
+        Defer,
+        Done,
+        Float,
+        For,
+        Foreach,
+        Func,
+        Get,
+        Iden,
+        If,
+        Import,
+        Imports,
+        Index,
+        Int,
+        Itop,
+        Lambda,
+        LoopControl,
+        Namespace,
+        Null,
+        Ptoi,
+        Ret,
+        Sizeof,
+        Slice,
+        String,
+        Struct,
+        Switch,
+        Type,
+        Unary,
+        Var,
+        While,
+    };
+}
+
 class Node {
 public:
+    NodeKind::NodeKind nodeKind;
     bool isChecked = false;
 
+    explicit Node(NodeKind::NodeKind kind) : nodeKind(kind) {}
+
+    // Nodes live in Arena::current and do not own their children
+    static void* operator new(size_t size) {return Arena::allocate(size, Arena::NodeObject);}
+    static void operator delete(void* pointer) {Arena::deallocate(pointer);}
+
     virtual RaveValue generate();
     virtual void check();
     virtual void optimize();
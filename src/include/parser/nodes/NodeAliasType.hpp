@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeAliasType : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::AliasType;}
+
     int loc;
     std::string name;
     std::string origName;
@@ -27,5 +29,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeAliasType() override;
 };
\ No newline at end of file
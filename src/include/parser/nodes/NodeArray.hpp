@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeArray : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Array;}
+
     int loc;
     std::vector<Node*> values;
     Type* type;
@@ -28,5 +30,4 @@ public:
     void check() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeArray() override;
 };
\ No newline at end of file
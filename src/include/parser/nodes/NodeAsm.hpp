@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeAsm : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Asm;}
+
     std::string line;
     std::string additions = "";
     std::vector<Node*> values;
@@ -28,5 +30,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeAsm() override;
 };
\ No newline at end of file
@@ -20,6 +20,8 @@ namespace Binary {
 
 class NodeBinary : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Binary;}
+
     char op;
     Node* first;
     Node* second;
@@ -35,5 +37,4 @@ public:
     Node* copy() override;
     void check() override;
     std::pair<std::string, std::string> isOperatorOverload(RaveValue first, RaveValue second, char op);
-    ~NodeBinary() override;
 };
\ No newline at end of file
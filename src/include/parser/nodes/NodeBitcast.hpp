@@ -12,12 +12,13 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeBitcast : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Bitcast;}
+
     Type* type;
     Node* value;
     int loc;
 
     NodeBitcast(Type* type, Node* value, int loc);
-    ~NodeBitcast() override;
     
     void check() override;
     Type* getType() override;
@@ -13,6 +13,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeBlock : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Block;}
+
     std::vector<Node*> nodes;
 
     NodeBlock(std::vector<Node*> nodes);
@@ -22,5 +24,4 @@ public:
     Node* copy() override;
     Node* comptime() override;
     Type* getType() override;
-    ~NodeBlock() override;
 };
@@ -19,6 +19,8 @@ class BigInt;
 
 class NodeBuiltin : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Builtin;}
+
     std::string name;
     std::vector<Node*> args;
     int loc;
@@ -30,7 +32,6 @@ public:
 
     NodeBuiltin(std::string name, std::vector<Node*> args, int loc, NodeBlock* block);
     NodeBuiltin(std::string name, std::vector<Node*> args, int loc, NodeBlock* block, Type* type, bool isImport, bool isTopLevel, int CTId);
-    ~NodeBuiltin() override;
 
     NodeType* asType(int n, bool isCompTime = false);
     Type* asClearType(int n);
@@ -22,6 +22,9 @@ struct CallSettings {
 namespace Template {
     extern std::string fromTypes(std::vector<Type*>& types);
     extern std::vector<Type*> parseTemplateTypes(const std::string& templateStr);
+
+    // Forgets the parsed template arguments and the instantiated templates of the unit
+    extern void clearCache();
 }
 
 namespace Call {
@@ -43,6 +46,8 @@ namespace Call {
 
 class NodeCall : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Call;}
+
     int loc;
     Node* func;
     std::vector<Node*> args;
@@ -58,5 +63,4 @@ public:
     Node* comptime() override;
     Node* copy() override;
     void check() override;
-    ~NodeCall() override;
 };
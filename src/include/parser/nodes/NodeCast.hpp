@@ -11,12 +11,13 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeCast : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Cast;}
+
     Type* type;
     Node* value;
     int loc;
 
     NodeCast(Type* type, Node* value, int loc);
-    ~NodeCast() override;
     RaveValue generate() override;
     Type* getType() override;
     
@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeCmpxchg : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Cmpxchg;}
+
     Node* ptr;
     Node* value1;
     Node* value2;
@@ -26,5 +28,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeCmpxchg() override;
 };
\ No newline at end of file
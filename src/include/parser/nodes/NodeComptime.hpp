@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeComptime : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Comptime;}
+
     Node* node;
     bool isImported = false;
 
@@ -24,5 +26,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeComptime() override;
 };
\ No newline at end of file
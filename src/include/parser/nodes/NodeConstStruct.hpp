@@ -16,6 +16,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeConstStruct : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::ConstStruct;}
+
     std::string structName;
     std::vector<Node*> values;
     int loc;
@@ -28,5 +30,4 @@ public:
     Node* comptime() override;
     Node* copy() override;
     void check() override;
-    ~NodeConstStruct() override;
 };
\ No newline at end of file
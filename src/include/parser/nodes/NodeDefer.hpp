@@ -27,6 +27,8 @@ namespace Defer {
 
 class NodeDefer : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Defer;}
+
     Node* instruction;
     int loc;
     bool isFunctionScope;
@@ -38,5 +40,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeDefer() override;
 };
\ No newline at end of file
@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeDone : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Done;}
+
     RaveValue value;
 
     NodeDone(RaveValue value);
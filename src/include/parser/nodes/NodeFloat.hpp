@@ -15,13 +15,14 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeFloat : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Float;}
+
     std::string value;
     TypeBasic* type = nullptr;
     bool isMustBeFloat = false;
 
     NodeFloat(double value, TypeBasic* type = nullptr, bool isDouble = false);
     NodeFloat(std::string value, TypeBasic* type = nullptr);
-    ~NodeFloat() {if (this->type != nullptr) delete this->type;}
     Type* getType() override;
     
     RaveValue generate() override;
@@ -8,19 +8,24 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <llvm-c/Core.h>
 #include "Node.hpp"
+#include "../parser.hpp"
 #include "../Types.hpp"
 #include <vector>
 #include <string>
 
 class NodeFor : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::For;}
+
     std::vector<Node*> presets;
     Node* cond;
     std::vector<Node*> afters;
     NodeBlock* block;
     int loc;
+    std::vector<DeclarMod> mods; // Loop modifiers, lowered by NodeWhile
 
     NodeFor(std::vector<Node*> presets, Node* cond, std::vector<Node*> afters, NodeBlock* block, int loc);
+    bool isCounted();
     void optimize() override;
     Type* getType() override;
     
@@ -28,5 +33,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeFor() override;
 };
\ No newline at end of file
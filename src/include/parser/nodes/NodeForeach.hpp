@@ -8,6 +8,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <llvm-c/Core.h>
 #include "Node.hpp"
+#include "../parser.hpp"
 #include "../Types.hpp"
 #include <vector>
 #include <string>
@@ -16,13 +17,17 @@ class NodeIden;
 
 class NodeForeach : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Foreach;}
+
     NodeIden* elName;
     NodeBlock* block;
     Node* varData;
     Node* varLength;
     int loc;
+    bool isReference; // foreach (&name; ...) binds a pointer to the element instead of its copy
+    std::vector<DeclarMod> mods; // Loop modifiers, lowered by NodeWhile
 
-    NodeForeach(NodeIden* elName, Node* varData, Node* varLength, NodeBlock* block, int loc);
+    NodeForeach(NodeIden* elName, Node* varData, Node* varLength, NodeBlock* block, int loc, bool isReference = false);
     void optimize() override;
     Type* getType() override;
     
@@ -30,5 +35,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeForeach() override;
 };
\ No newline at end of file
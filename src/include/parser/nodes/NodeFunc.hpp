@@ -21,6 +21,8 @@ struct RetGenStmt;
 
 class NodeFunc : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Func;}
+
     std::string name;           // Mangled name (for backward compatibility during migration)
     std::string origName;       // Original clean function name
     std::string linkName;       // LLVM link name
@@ -34,6 +36,7 @@ public:
     std::vector<FuncArgSet> origArgs;
 
     NodeBlock* block;
+    bool isBlockShared = false; // block belongs to the parsed module, see ownBlock()
 
     std::vector<DeclarMod> mods;
 
@@ -71,9 +74,9 @@ public:
 
     NodeFunc(const std::string& name, std::vector<FuncArgSet> args, NodeBlock* block, bool isExtern, std::vector<DeclarMod> mods, int loc, Type* type, std::vector<std::string> templateNames);
     LLVMTypeRef* getParameters(int callConv);
+    NodeBlock* ownBlock();
     RaveValue generate() override;
     Type* getType() override;
-    ~NodeFunc() override;
     Node* comptime() override;
     Node* copy() override;
     void check() override;
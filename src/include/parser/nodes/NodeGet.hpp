@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeGet : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Get;}
+
     Node* base;
     std::string field;
     int loc;
@@ -27,5 +29,4 @@ public:
     Node* comptime() override;
     Node* copy() override;
     void check() override;
-    ~NodeGet() override;
 };
\ No newline at end of file
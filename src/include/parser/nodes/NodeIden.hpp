@@ -9,6 +9,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <llvm-c/Core.h>
 #include "Node.hpp"
 #include "../Types.hpp"
+#include "../Symbol.hpp"
 #include <vector>
 #include <string>
 
@@ -16,7 +17,9 @@ extern Type* getIdenType(std::string name, int loc);
 
 class NodeIden : public Node {
 public:
-    std::string name;
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Iden;}
+
+    Symbol name;
     int loc;
     bool isMustBePtr = false;
 
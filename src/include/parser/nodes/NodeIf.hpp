@@ -15,6 +15,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeIf : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::If;}
+
     Node* cond = nullptr;
     Node* body = nullptr;
     Node* _else = nullptr;
@@ -31,5 +33,4 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeIf() override;
 };
\ No newline at end of file
@@ -21,6 +21,8 @@ typedef struct {
 
 class NodeImport : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Import;}
+
     ImportFile file;
     std::vector<std::string> functions;
     int loc;
@@ -37,6 +39,8 @@ public:
 
 class NodeImports : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Imports;}
+
     std::vector<NodeImport*> imports;
     int loc;
 
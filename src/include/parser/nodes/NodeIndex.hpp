@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeIndex : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Index;}
+
     Node* element;
     std::vector<Node*> indexes;
     int loc;
@@ -25,7 +27,6 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeIndex() override;
     std::vector<LLVMValueRef> generateIndexes();
     bool isElementConst(Type* type);
 };
\ No newline at end of file
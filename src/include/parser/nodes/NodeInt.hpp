@@ -17,6 +17,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeInt : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Int;}
+
     BigInt value;
     char type;
     Type* isVarVal = nullptr;
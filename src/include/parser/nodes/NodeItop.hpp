@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeItop : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Itop;}
+
     Node* value;
     Type* type;
     int loc;
@@ -22,5 +24,4 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeItop() override;
 };
\ No newline at end of file
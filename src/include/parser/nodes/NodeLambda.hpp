@@ -18,6 +18,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeLambda : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Lambda;}
+
     int loc;
     std::string name;
     LLVMValueRef f;
@@ -33,6 +35,5 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeLambda() override;
     std::vector<LLVMTypeRef> generateTypes(); 
 };
\ No newline at end of file
@@ -19,6 +19,8 @@ enum class LoopControlKind {
 
 class NodeLoopControl : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::LoopControl;}
+
     LoopControlKind kind;
     int loc;
 
@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeNamespace : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Namespace;}
+
     std::vector<std::string> names;
     std::vector<Node*> nodes;
     int loc;
@@ -27,5 +29,4 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeNamespace() override;
 };
\ No newline at end of file
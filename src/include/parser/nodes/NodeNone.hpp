@@ -3,4 +3,9 @@
 #include <llvm-c/Core.h>
 #include "Node.hpp"
 
-class NodeNone : public Node {};
+class NodeNone : public Node {
+public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::None;}
+
+    NodeNone() : Node(NodeKind::None) {}
+};
@@ -14,6 +14,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeNull : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Null;}
+
     Type* type;
     int loc;
 
@@ -23,5 +25,4 @@ public:
     void check() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeNull() override;
 };
\ No newline at end of file
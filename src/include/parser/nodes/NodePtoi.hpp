@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodePtoi : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Ptoi;}
+
     Node* value;
     int loc;
 
@@ -21,5 +23,4 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodePtoi() override;
 };
\ No newline at end of file
@@ -15,6 +15,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeRet : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Ret;}
+
     Node* value;
     int loc;
 
@@ -25,7 +27,6 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeRet() override;
     Loop getParentBlock(int n = -1);
     void setParentBlock(Loop value, int n = -1);
 };
@@ -12,6 +12,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeSizeof : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Sizeof;}
+
     Node* value;
     int loc;
 
@@ -21,5 +23,4 @@ public:
     Node* comptime() override;
     Node* copy() override;
     void check() override;
-    ~NodeSizeof() override;
 };
\ No newline at end of file
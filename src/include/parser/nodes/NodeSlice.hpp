@@ -16,6 +16,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeSlice : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Slice;}
+
     Node* base;
     Node* start;
     Node* end;
@@ -28,5 +30,4 @@ public:
     Node* comptime() override;
     Node* copy() override;
     void check() override;
-    ~NodeSlice() override;
 };
\ No newline at end of file
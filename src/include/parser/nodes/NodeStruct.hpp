@@ -12,6 +12,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <map>
 #include "../parser.hpp"
 
 extern Type* checkForTemplated(Type* type);
@@ -25,6 +26,8 @@ struct StructPredefined {
 
 class NodeStruct : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Struct;}
+
     std::string name;
     std::vector<Node*> elements;
     std::vector<NodeVar*> variables;
@@ -40,6 +43,7 @@ public:
     std::unordered_map<char, std::unordered_map<std::string, NodeFunc*>> operators;
     std::vector<Node*> oldElements;
     std::vector<std::string> templateNames;
+    std::map<std::vector<uint32_t>, LLVMTypeRef> instances; // genWithTemplate() results by the keys of the template types
     std::vector<DeclarMod> mods;
     std::string dataVar;
     std::string lengthVar;
@@ -53,7 +57,6 @@ public:
     bool isImported = false;
 
     NodeStruct(std::string name, std::vector<Node*> elements, int loc, std::string extends, std::vector<std::string> templateNames, std::vector<DeclarMod> mods);
-    ~NodeStruct() override;
     
     LLVMTypeRef asConstType();
     std::vector<LLVMTypeRef> getParameters(bool isLinkOnce);
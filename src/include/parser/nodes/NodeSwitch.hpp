@@ -15,6 +15,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeSwitch : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Switch;}
+
     Node* expr = nullptr;
     Node* _default = nullptr;
     std::vector<std::pair<std::vector<Node*>, Node*>> statements;
@@ -26,5 +28,8 @@ public:
     RaveValue generate() override;
     Node* comptime() override;
     Node* copy() override;
-    ~NodeSwitch() override;
+
+private:
+    bool generateTable(RaveValue value);
+    void generateBranch(LLVMBasicBlockRef block, Node* body, LLVMBasicBlockRef end);
 };
\ No newline at end of file
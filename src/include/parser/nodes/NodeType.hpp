@@ -16,6 +16,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeType : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Type;}
+
     Type* type;
     int loc;
 
@@ -26,5 +28,4 @@ public:
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeType() override;
 };
\ No newline at end of file
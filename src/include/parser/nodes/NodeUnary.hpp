@@ -20,6 +20,8 @@ namespace Unary {
 
 class NodeUnary : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Unary;}
+
     int loc;
     char type;
     Node* base;
@@ -33,5 +35,4 @@ public:
     Node* comptime() override;
     RaveValue generate() override;
     Node* copy() override;
-    ~NodeUnary() override;
 };
\ No newline at end of file
@@ -15,6 +15,8 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 class NodeVar : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::Var;}
+
     std::string name;
     std::string origName;
     std::string linkName;
@@ -38,7 +40,6 @@ public:
     bool isUsed = false;
 
     NodeVar(std::string name, Node* value, bool isExtern, bool isConst, bool isGlobal, std::vector<DeclarMod> mods, int loc, Type* type, bool isVolatile, bool isChanged, bool noZeroInit);
-    ~NodeVar() override;
 
     RaveValue generate() override;
     Type* getType() override;
@@ -9,21 +9,31 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../Types.hpp"
 #include <llvm-c/Core.h>
 #include "Node.hpp"
+#include "../parser.hpp"
 #include <vector>
 #include <string>
 
 class NodeWhile : public Node {
 public:
+    static bool classof(const Node* node) {return node->nodeKind == NodeKind::While;}
+
     Node* cond;
     Node* body;
     int loc;
 
+    // Set by NodeFor/NodeForeach for loops over an induction variable: the condition has no side effects,
+    // so it is tested once more before the loop and the checks of the body can be hoisted there
+    bool isCounted = false;
+
+    // Loop modifiers (unroll, vectorize, interleave, distribute), see LoopHints
+    std::vector<DeclarMod> mods;
+
     NodeWhile(Node* cond, Node* body, int loc);
+    static bool isPure(Node* node);
     void optimize() override;
     Type* getType() override;
     RaveValue generate() override;
     Node* copy() override;
     Node* comptime() override;
     void check() override;
-    ~NodeWhile() override;
 };
\ No newline at end of file
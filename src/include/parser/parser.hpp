@@ -25,7 +25,7 @@ struct DeclarMod {
 
 class Parser {
 public:
-    std::vector<Token*> tokens;
+    const std::vector<Token>& tokens; // Owned by the lexer
     int idx = 0;
     std::vector<Node*> nodes;
     std::string file;
@@ -40,14 +40,14 @@ public:
 
     void checkEOF(std::string msg);
 
-    Token* skipStmt();
-    Token* skip(int openType, int closeType);
+    const Token* skipStmt();
+    const Token* skip(int openType, int closeType);
 
-    Token* peek();
-    Token* next(int add = 1);
-    Token* expect(int type, std::string errStr, int add = 1);
+    const Token* peek();
+    const Token* next(int add = 1);
+    const Token* expect(int type, std::string errStr, int add = 1);
 
-    Parser(std::vector<Token*> tokens, std::string file);
+    Parser(const std::vector<Token>& tokens, std::string file);
 
     void parseAll();
     void parseTopLevel(std::vector<Node*>& list, std::string s = "");
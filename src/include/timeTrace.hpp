@@ -0,0 +1,48 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <string>
+#include <cstdio>
+
+// Compile-time profiler (--time-trace): nested spans with microsecond timestamps, written as a Chrome/Perfetto trace.
+namespace TimeTrace {
+    // Enable/disable recording globally
+    extern bool enabled;
+
+    // Opens a span on the current thread. Spans are closed in the reverse order.
+    extern void begin(const std::string& name, const std::string& detail);
+
+    // Closes the innermost open span of the current thread.
+    extern void end();
+
+    // Forgets the finished spans (a forked worker reports only its own ones).
+    extern void clear();
+
+    // Writes the finished spans to the file (one per line), and reads the spans written by a worker.
+    extern void save(FILE* file);
+    extern void load(FILE* file);
+
+    // Writes the trace in the Chrome JSON format.
+    extern void write(const std::string& path);
+
+    // Span for the current C++ scope
+    struct Scope {
+        bool active;
+
+        Scope(const std::string& name, const std::string& detail) : active(enabled) {
+            if (active) begin(name, detail);
+        }
+
+        ~Scope() {
+            if (active) end();
+        }
+    };
+}
+
+// Span for the current C++ scope - the detail is only computed when tracing is enabled
+#define TIME_TRACE_SCOPE(name, detail) TimeTrace::Scope timeTraceScope(name, TimeTrace::enabled ? std::string(detail) : std::string())
@@ -11,6 +11,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <cctype>
 #include <locale>
 #include <vector>
+#include <cassert>
 
 static std::string replaceAll(std::string str, std::string substr1, std::string substr2) {
     for (size_t index = str.find(substr1, 0); index != std::string::npos && substr1.length(); index = str.find(substr1, index + substr2.length()))
@@ -93,9 +94,27 @@ static std::vector<std::string> filesInDirectory(std::string directory) {
 }
 #endif
 
+// Kind-based RTTI: Base::classof() checks the kind stored in Node/Type, so no dynamic_cast is involved
 template<typename Base, typename T>
-static bool instanceof(const T* ptr) {
-    return dynamic_cast<const Base*>(ptr) != nullptr;
+static inline bool isa(const T* ptr) {
+    return Base::classof(ptr);
+}
+
+template<typename Base, typename T>
+static inline Base* cast(T* ptr) {
+    assert(ptr != nullptr && isa<Base>(ptr));
+    return static_cast<Base*>(ptr);
+}
+
+template<typename Base, typename T>
+static inline Base* dyn_cast(T* ptr) {
+    return (ptr != nullptr && isa<Base>(ptr)) ? static_cast<Base*>(ptr) : nullptr;
+}
+
+// Null-safe isa<>
+template<typename Base, typename T>
+static inline bool instanceof(const T* ptr) {
+    return ptr != nullptr && isa<Base>(ptr);
 }
 
 struct ShellResult {
@@ -143,7 +162,7 @@ typedef struct genSettings {
     bool recompileStd = false;
     bool noChecks = false;
     bool outDebugInfo = false;
-    std::string linkParams = "";
+    std::vector<std::string> linkParams;
 
     // X86, X86_64 features
     bool popcnt = true;
@@ -173,8 +192,14 @@ typedef struct genSettings {
     bool noFastMath = false;
     bool noPrivateInlining = false;
     bool noIoInit = false;
-
-    std::string linker = "lld";
+    bool noAstCache = false;
+    bool incremental = false;
+    bool lto = false;
+    bool remarks = false;
+
+    std::string linker = "";
+    int jobs = 1;
+    int codegenThreads = 1;
     std::vector<std::string> importDirectories;
 } genSettings;
 
@@ -199,6 +224,17 @@ static inline std::string trim(std::string s) {
     return rtrim(ltrim(s));
 }
 
+// 64-bit FNV-1a hash of the data as 16 hex digits (keys of the on-disk caches)
+static inline std::string hashString(const std::string& data) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {hash ^= c; hash *= 1099511628211ULL;}
+
+    const char* digits = "0123456789abcdef";
+    std::string result(16, '0');
+    for (int i=15; i>=0; i--) {result[i] = digits[hash & 15]; hash >>= 4;}
+    return result;
+}
+
 #if defined(_WIN32)
 #include <algorithm> // For transform() in get_exe_path()
 #define WIN32_LEAN_AND_MEAN
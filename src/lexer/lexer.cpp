@@ -6,6 +6,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <chrono>
 #include "../include/compiler.hpp"
+#include "../include/timeTrace.hpp"
 #include "../include/lexer/tokens.hpp"
 #include "../include/lexer/lexer.hpp"
 #include "../include/utils.hpp"
@@ -14,7 +15,12 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <vector>
 #include <stdint.h>
 #include <regex>
-#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 
 std::string Lexer::unescape(const std::string& str) {
     static const std::unordered_map<std::string, char> escapes = {
@@ -47,33 +53,118 @@ std::string Lexer::unescape(const std::string& str) {
     return result;
 }
 
-std::string Lexer::getIdentifier() {
-    static std::unordered_set<char> specialChars = {
-        '+', '-', '*', '/', '>', '<', ',', '.', ';', '(', ')', '[', ']', '&',
-        '\'', '"', '~', '=', '{', '}', '!', ' ', '\n', '\r', '@'
-    };
+// 256-entry character classes of the scanner
+enum CharClass : uint8_t {
+    Stop = 1, // Ends an identifier
+    Colon = 2, // Ends an identifier, unless it is a part of '::'
+    Space = 4, // Skipped between tokens (newlines are counted separately)
+    Digit = 8
+};
 
-    std::string buffer = "";
+struct CharClasses {
+    uint8_t table[256] = {};
 
-    while (specialChars.find(peek()) == specialChars.end()) {
-        if (peek() == ':' && this->text[this->idx + 1] == ':') {
-            buffer += "::";
-            idx += 2;
-        }
-        else {
-            if (peek() == ':') break;
-            buffer += peek();
-            idx += 1;
+    CharClasses() {
+        for (char c : std::string("+-*/><,.;()[]&'\"~={}! \n\r@")) table[(uint8_t)c] |= CharClass::Stop;
+        for (char c = '0'; c <= '9'; c++) table[(uint8_t)c] |= CharClass::Digit;
+        table[(uint8_t)':'] |= CharClass::Colon;
+        table[(uint8_t)' '] |= CharClass::Space;
+        table[(uint8_t)'\t'] |= CharClass::Space;
+        table[(uint8_t)'\r'] |= CharClass::Space;
+    }
+
+    inline bool is(char c, uint8_t classes) const {return (table[(uint8_t)c] & classes) != 0;}
+};
+
+static const CharClasses charClasses;
+
+// Skips ' ', '\t' and '\r' starting from idx. Runs of indentation are skipped 16 (SSE2) or 8 (SWAR) bytes at a time.
+static size_t skipSpaces(const std::string& text, size_t idx) {
+    const char* data = text.data();
+
+#if defined(__SSE2__)
+    const __m128i spaces = _mm_set1_epi8(' '), tabs = _mm_set1_epi8('\t');
+
+    while (idx + 16 <= text.size()) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + idx));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, spaces), _mm_cmpeq_epi8(chunk, tabs)));
+
+        if (mask != 0xFFFF) {
+            idx += __builtin_ctz(~mask);
+            break;
         }
+
+        idx += 16;
+    }
+#else
+    uint64_t word;
+
+    while (idx + 8 <= text.size()) {
+        std::memcpy(&word, data + idx, 8);
+        if (word != 0x2020202020202020ULL) break;
+        idx += 8;
     }
+#endif
 
-    return buffer;
+    while (charClasses.is(data[idx], CharClass::Space)) idx += 1;
+    return idx;
 }
 
-std::string Lexer::getString() {
+// Skips the body of a block comment (after '/*') and counts its newlines. Returns the index after '*/'.
+static size_t skipBlockComment(const std::string& text, size_t idx, int32_t& line) {
+    const char* data = text.data();
+    const char* end = data + text.size();
+    const char* current = data + idx;
+
+    while (current < end) {
+        const char* star = (const char*)std::memchr(current, '*', end - current);
+        if (star == nullptr) star = end;
+
+        line += std::count(current, star, '\n');
+        if (star + 1 < end && star[1] == '/') return (star - data) + 2;
+
+        current = star + 1;
+    }
+
+    return text.size() + 1;
+}
+
+StringView Lexer::getIdentifier() {
+    const char* data = text.data();
+    size_t start = idx;
+
+    while (true) {
+        char c = data[idx];
+
+        if (!charClasses.is(c, CharClass::Stop | CharClass::Colon)) idx += 1;
+        else if (c == ':' && data[idx + 1] == ':') idx += 2;
+        else break;
+    }
+
+    return view(start);
+}
+
+// Returns the literal between idx and the closing quote as a view if it has no escapes, and skips it.
+StringView Lexer::getPlainLiteral(char quote) {
+    const char* data = text.data();
+    const char* end = (const char*)std::memchr(data + idx, quote, text.size() - idx);
+
+    if (end == nullptr || std::memchr(data + idx, '\\', end - (data + idx)) != nullptr) return StringView();
+
+    StringView literal(data + idx, end - (data + idx));
+    idx = (end - data) + 1;
+    return literal;
+}
+
+StringView Lexer::getString() {
     idx += 1;
+    if (text[idx] == '"') {idx += 1; return "";}
+
+    StringView plain = getPlainLiteral('"');
+    if (plain.size() > 0) return plain;
+
     std::string buffer;
-    while (peek() != '"') {
+    while (idx < text.size() && peek() != '"') {
         if (peek() == '\\') {
             idx += 1;
             if (peek() == '"') buffer += "\"";
@@ -81,201 +172,209 @@ std::string Lexer::getString() {
             else if (peek() == 'r') buffer += "\r";
             else if (peek() == 't') buffer += "\t";
             else if (isdigit(peek())) {
-                std::string buffer2;
-                for (; isdigit(peek()); idx++) buffer2 += peek();
-                buffer += unescape(buffer2);
+                size_t start = idx;
+                while (isdigit(peek())) idx += 1;
+                buffer += unescape(text.substr(start, idx - start));
             }
             else buffer += peek();
+            idx += 1;
+        }
+        else {
+            // Copy the whole run up to the next escape or the closing quote
+            size_t start = idx;
+            while (idx < text.size() && peek() != '"' && peek() != '\\') idx += 1;
+            buffer.append(text, start, idx - start);
         }
-        else buffer += peek();
-        idx += 1;
     }
 
     if (peek() == '"') idx += 1;
-    return unescape(buffer);
+    literals.push_back(unescape(buffer));
+    return literals.back();
 }
 
-std::string Lexer::getChar() {
+StringView Lexer::getChar() {
     idx += 1;
-    std::string buffer = "", buffer2 = "";
-    while (peek() != '\'') {
+    if (text[idx] == '\'') {idx += 1; return "";}
+
+    StringView plain = getPlainLiteral('\'');
+    if (plain.size() > 0) return plain;
+
+    std::string buffer = "";
+    while (idx < text.size() && peek() != '\'') {
         if (peek() == '\\' && text[idx + 1] == '\'') {buffer += "'"; idx += 2;}
         else if (peek() == '\\' && isdigit(text[idx + 1])) {
-            buffer2 += peek();
+            size_t start = idx;
             idx += 1;
-            for (; isdigit(peek()); idx++) buffer2 += peek();
-            buffer += unescape(buffer2);
-            buffer2 = "";
+            while (isdigit(peek())) idx += 1;
+            buffer += unescape(text.substr(start, idx - start));
         }
         else if (peek() == '\\' && text[idx + 1] == '\\') {buffer += "\\"; idx += 2;}
         else {buffer += peek(); idx += 1;}
     }
 
     next();
-    return unescape(buffer);
+    literals.push_back(unescape(buffer));
+    return literals.back();
 }
 
-std::string Lexer::getDigit(char numType) {
-    std::string buffer = "";
+StringView Lexer::getDigit(char numType) {
     bool isHexadecimal = (numType == TokType::HexNumber);
-    char currentChar;
 
     if (isHexadecimal) idx += 2;
-    while ((currentChar = peek()) != '\0' && (isdigit(currentChar) || (isHexadecimal && isxdigit(currentChar)))) {
-        buffer += currentChar;
-        idx += 1;
-    }
+    size_t start = idx;
+
+    if (isHexadecimal) while (isxdigit((unsigned char)peek())) idx += 1;
+    else while (charClasses.is(peek(), CharClass::Digit)) idx += 1;
 
-    return buffer;
+    return view(start);
 }
 
-Lexer::Lexer(std::string text, int offset) {
-    this->text = text + " ";
+Lexer::Lexer(std::string source, int offset) {
+    this->text = std::move(source);
+    this->text += " ";
     this->line = 0 - offset;
 
+    TIME_TRACE_SCOPE("Lex", std::to_string(this->text.size() - 1) + " bytes");
     auto start = std::chrono::steady_clock::now();
 
+    // Most tokens are a few bytes long
+    tokens.reserve(this->text.size() / 4);
+
     while (idx < this->text.size()) {
-        while (peek() == '\n' || peek() == '\r' || peek() == ' ' || peek() == '\t') {
-            if (peek() == '\n') line += 1;
-            idx += 1;
+        while (true) {
+            if (peek() == '\n') {line += 1; idx += 1;}
+            else if (charClasses.is(peek(), CharClass::Space)) idx = skipSpaces(this->text, idx);
+            else break;
         }
 
         if (peek() == '\0' || peek() == 0 || peek() == EOF) break;
 
         switch (peek()) {
             case '+':
-                if (next() == '=') {tokens.push_back(new Token(TokType::PluEqu, "+=", line)); idx += 1;}
-                else if (peek() == '+') {tokens.push_back(new Token(TokType::PluEqu)); tokens.push_back(new Token(TokType::Number, "1")); idx += 1;}
-                else tokens.push_back(new Token(TokType::Plus, "+", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::PluEqu, "+=", line)); idx += 1;}
+                else if (peek() == '+') {tokens.push_back(Token(TokType::PluEqu)); tokens.push_back(Token(TokType::Number, "1")); idx += 1;}
+                else tokens.push_back(Token(TokType::Plus, "+", line));
                 break;
             case '-':
-                if (next() == '=') {tokens.push_back(new Token(TokType::MinEqu, "-=", line)); idx += 1;}
-                else if (peek() == '-') {tokens.push_back(new Token(TokType::MinEqu)); tokens.push_back(new Token(TokType::Number, "1")); idx += 1;}
-                else tokens.push_back(new Token(TokType::Minus, "-", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::MinEqu, "-=", line)); idx += 1;}
+                else if (peek() == '-') {tokens.push_back(Token(TokType::MinEqu)); tokens.push_back(Token(TokType::Number, "1")); idx += 1;}
+                else tokens.push_back(Token(TokType::Minus, "-", line));
                 break;
             case '*':
-                if (next() == '=') {tokens.push_back(new Token(TokType::MulEqu, "*=", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::Multiply, "*", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::MulEqu, "*=", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::Multiply, "*", line));
                 break;
             case '/':
                 next();
-                if (peek() == '=') {tokens.push_back(new Token(TokType::DivEqu, "/=", line)); idx += 1;}
-                else if (peek() == '/') {while (peek() != '\n') idx += 1;}
-                else if (peek() == '*') {
-                    idx += 1;
-                    while (peek() != '*' || this->text[idx + 1] != '/') {
-                        if (peek() == '\n') line += 1;
-                        if (idx+1 >= text.size()) break;
-                        next();
-                    }
-                    idx += 2;
+                if (peek() == '=') {tokens.push_back(Token(TokType::DivEqu, "/=", line)); idx += 1;}
+                else if (peek() == '/') {
+                    const char* end = (const char*)std::memchr(this->text.data() + idx, '\n', this->text.size() - idx);
+                    idx = (end != nullptr) ? (end - this->text.data()) : this->text.size();
                 }
-                else tokens.push_back(new Token(TokType::Divide, "/", line));
+                else if (peek() == '*') idx = skipBlockComment(this->text, idx + 1, line);
+                else tokens.push_back(Token(TokType::Divide, "/", line));
                 break;
             case '&':
-                if (next() == '&') {tokens.push_back(new Token(TokType::And, "&&", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::Amp, "&", line));
+                if (next() == '&') {tokens.push_back(Token(TokType::And, "&&", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::Amp, "&", line));
                 break;
             case '|':
-                if (next() == '|') {tokens.push_back(new Token(TokType::Or, "||", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::BitOr, "|", line));
+                if (next() == '|') {tokens.push_back(Token(TokType::Or, "||", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::BitOr, "|", line));
                 break;
-            case '(': tokens.push_back(new Token(TokType::Rpar,"(",line)); idx += 1; break;
-            case ')': tokens.push_back(new Token(TokType::Lpar,")",line)); idx += 1; break;
-            case '{': tokens.push_back(new Token(TokType::Rbra,"{",line)); idx += 1; break;
-            case '}': tokens.push_back(new Token(TokType::Lbra,"}",line)); idx += 1; break;
-            case '[': tokens.push_back(new Token(TokType::Rarr,"[",line)); idx += 1; break;
-            case ']': tokens.push_back(new Token(TokType::Larr,"]",line)); idx += 1; break;
-            case ',': tokens.push_back(new Token(TokType::Comma,",",line)); idx += 1; break;
-            case ':': tokens.push_back(new Token(TokType::ValSel,":",line)); idx += 1; break;
-            case ';': tokens.push_back(new Token(TokType::Semicolon,";",line)); idx += 1; break;
-            case '%': tokens.push_back(new Token(TokType::Rem,"%",line)); idx += 1; break;
-            case '@': idx += 1; tokens.push_back(new Token(TokType::Builtin,"@"+getIdentifier(),line)); break;
-            case '"': tokens.push_back(new Token(TokType::String,getString(),line)); break;
-            case '\'': tokens.push_back(new Token(TokType::Char,getChar(),line)); break;
+            case '(': tokens.push_back(Token(TokType::Rpar,"(",line)); idx += 1; break;
+            case ')': tokens.push_back(Token(TokType::Lpar,")",line)); idx += 1; break;
+            case '{': tokens.push_back(Token(TokType::Rbra,"{",line)); idx += 1; break;
+            case '}': tokens.push_back(Token(TokType::Lbra,"}",line)); idx += 1; break;
+            case '[': tokens.push_back(Token(TokType::Rarr,"[",line)); idx += 1; break;
+            case ']': tokens.push_back(Token(TokType::Larr,"]",line)); idx += 1; break;
+            case ',': tokens.push_back(Token(TokType::Comma,",",line)); idx += 1; break;
+            case ':': tokens.push_back(Token(TokType::ValSel,":",line)); idx += 1; break;
+            case ';': tokens.push_back(Token(TokType::Semicolon,";",line)); idx += 1; break;
+            case '%': tokens.push_back(Token(TokType::Rem,"%",line)); idx += 1; break;
+            case '@': {
+                size_t start = idx;
+                idx += 1; getIdentifier();
+                tokens.push_back(Token(TokType::Builtin, view(start), line));
+                break;
+            }
+            case '"': tokens.push_back(Token(TokType::String,getString(),line)); break;
+            case '\'': tokens.push_back(Token(TokType::Char,getChar(),line)); break;
             case '.':
-                if (next() == '.') {tokens.push_back(new Token(TokType::SliceOper, "..", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::Dot, ".", line));
+                if (next() == '.') {tokens.push_back(Token(TokType::SliceOper, "..", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::Dot, ".", line));
                 break;
             case '~':
                 if ((idx + 5) < this->text.size()) {
                     int oldIdx = idx;
                     if (next() == 't' && next() == 'h' && next() == 'i' && next() == 's') {
-                        if (next() != '.') {tokens.push_back(new Token(TokType::Identifier, "~this", line)); idx += 1;}
-                        else {tokens.push_back(new Token(TokType::Destructor, "~", line)); idx = oldIdx + 1;}
+                        if (next() != '.') {tokens.push_back(Token(TokType::Identifier, "~this", line)); idx += 1;}
+                        else {tokens.push_back(Token(TokType::Destructor, "~", line)); idx = oldIdx + 1;}
                     }
-                    else {tokens.push_back(new Token(TokType::Destructor, "~", line)); idx = oldIdx + 1;}
+                    else {tokens.push_back(Token(TokType::Destructor, "~", line)); idx = oldIdx + 1;}
                 }
-                else {tokens.push_back(new Token(TokType::Destructor, "~", line)); idx += 1;}
+                else {tokens.push_back(Token(TokType::Destructor, "~", line)); idx += 1;}
                 break;
             case '>':
-                if (next() == '=') {tokens.push_back(new Token(TokType::MoreEqual, ">=", line)); idx += 1;}
-                else if (peek() == '.') {tokens.push_back(new Token(TokType::BitRight, ">>", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::More, ">", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::MoreEqual, ">=", line)); idx += 1;}
+                else if (peek() == '.') {tokens.push_back(Token(TokType::BitRight, ">>", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::More, ">", line));
                 break;
             case '<':
-                if (next() == '=') {tokens.push_back(new Token(TokType::LessEqual, "<=", line)); idx += 1;}
-                else if (peek() == '.') {tokens.push_back(new Token(TokType::BitLeft, "<.", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::Less, "<", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::LessEqual, "<=", line)); idx += 1;}
+                else if (peek() == '.') {tokens.push_back(Token(TokType::BitLeft, "<.", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::Less, "<", line));
                 break;
             case '=':
-                if (next() == '=') {tokens.push_back(new Token(TokType::Equal, "==", line)); idx += 1;}
-                else if (peek() == '>') {tokens.push_back(new Token(TokType::ShortRet, "=>", line)); idx += 1;}
-                else tokens.push_back(new Token(TokType::Equ, "=", line));
+                if (next() == '=') {tokens.push_back(Token(TokType::Equal, "==", line)); idx += 1;}
+                else if (peek() == '>') {tokens.push_back(Token(TokType::ShortRet, "=>", line)); idx += 1;}
+                else tokens.push_back(Token(TokType::Equ, "=", line));
                 break;
             case '!':
-                if (next() == '=') {tokens.push_back(new Token(TokType::Nequal, "!=", line)); idx += 1;}
-                else if (peek() == '!') {tokens.push_back(new Token(TokType::BitXor, "!!", line)); idx += 1;}
+                if (next() == '=') {tokens.push_back(Token(TokType::Nequal, "!=", line)); idx += 1;}
+                else if (peek() == '!') {tokens.push_back(Token(TokType::BitXor, "!!", line)); idx += 1;}
                 else if (peek() == 'i' && text[idx + 1] == 'n' && (text[idx + 2] == ' ' || text[idx + 2] == '\n' || text[idx + 2] == '\t')) {
                     idx += 3;
-                    tokens.push_back(new Token(TokType::NeIn, "!in", line));
+                    tokens.push_back(Token(TokType::NeIn, "!in", line));
                 }
-                else tokens.push_back(new Token(TokType::Ne, "!", line));
+                else tokens.push_back(Token(TokType::Ne, "!", line));
                 break;
             default:
                 if (isdigit(peek())) {
                     idx += 1;
                     if (peek() != 'x') {
                         bool isFloat = false;
-                        std::string buffer = "";
                         idx -= 1;
+                        size_t start = idx;
 
-                        while (isdigit(peek()) || (peek() == '.' && this->text[idx + 1] != '.')) {
-                            if (peek() == '.') {
-                                isFloat = true;
-                                buffer += ".";
-                                idx += 1;
-                                continue;
-                            }
-
-                            buffer += peek();
+                        while (charClasses.is(peek(), CharClass::Digit) || (peek() == '.' && this->text[idx + 1] != '.')) {
+                            if (peek() == '.') isFloat = true;
                             idx += 1;
                         }
 
-                        tokens.push_back(new Token(isFloat ? TokType::FloatNumber : TokType::Number, buffer, line));
+                        tokens.push_back(Token(isFloat ? TokType::FloatNumber : TokType::Number, view(start), line));
                     }
                     else {
                         idx -= 1;
-                        tokens.push_back(new Token(TokType::HexNumber, getDigit(TokType::HexNumber), line));
+                        tokens.push_back(Token(TokType::HexNumber, getDigit(TokType::HexNumber), line));
                     }
                 }
                 else {
-                    std::string identifier = getIdentifier();
-                    if (identifier == "true") tokens.push_back(new Token(TokType::True, "true", line));
-                    else if (identifier == "false") tokens.push_back(new Token(TokType::False, "false", line));
-                    else if (identifier == "in") tokens.push_back(new Token(TokType::In, "in", line));
-                    else tokens.push_back(new Token(TokType::Identifier, identifier, line));
+                    StringView identifier = getIdentifier();
+                    if (identifier == "true") tokens.push_back(Token(TokType::True, "true", line));
+                    else if (identifier == "false") tokens.push_back(Token(TokType::False, "false", line));
+                    else if (identifier == "in") tokens.push_back(Token(TokType::In, "in", line));
+                    else tokens.push_back(Token(TokType::Identifier, identifier, line));
                 }
                 break;
         }
     }
 
-    tokens.push_back(new Token(TokType::Eof, "EOF", (tokens.size() > 0 ? tokens[tokens.size() - 1]->line : -1)));
+    tokens.push_back(Token(TokType::Eof, "EOF", (tokens.size() > 0 ? tokens.back().line : -1)));
 
     auto end = std::chrono::steady_clock::now();
 
-    Compiler::lexTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    Compiler::lexTime += std::chrono::duration<double, std::milli>(end - start).count();
 }
 
 std::string tokenToString(char type) {
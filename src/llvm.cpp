@@ -70,7 +70,7 @@ RaveValue LLVM::call(RaveValue fn, std::vector<RaveValue> args, const char* name
 
         if (instanceof<TypeStruct>(argType)) {
             TypeStruct* tstruct = static_cast<TypeStruct*>(argType);
-            if (AST::structTable.find(tstruct->name) == AST::structTable.end() && generator->toReplace.find(tstruct->name) == generator->toReplace.end())
+            if (AST::structTable.find(Symbol::lookup(tstruct->name)) == AST::structTable.end() && generator->toReplace.find(Symbol::lookup(tstruct->name)) == generator->toReplace.end())
                 types[i] = generator->genType(args[i].type->getElType(), -2);
             else types[i] = generator->genType(argType, -2);
         }
@@ -92,6 +92,19 @@ RaveValue LLVM::call(RaveValue fn, std::vector<RaveValue> args, const char* name
     return result;
 }
 
+// Call of llvm.expect.i1: the condition is expected to be equal to "expected".
+RaveValue LLVM::expect(RaveValue condition, bool expected, const char* name) {
+    if (generator->functions.find(Symbol::lookup("llvm.expect.i1")) == generator->functions.end()) {
+        generator->functions[Symbol("llvm.expect.i1")] = {LLVMAddFunction(generator->lModule, "llvm.expect.i1", LLVMFunctionType(
+        LLVMInt1TypeInContext(generator->context),
+        std::vector<LLVMTypeRef>({LLVMInt1TypeInContext(generator->context), LLVMInt1TypeInContext(generator->context)}).data(),
+        2, false
+        )), new TypeFunc(basicTypes[BasicType::Bool], {new TypeFuncArg(basicTypes[BasicType::Bool], "v1"), new TypeFuncArg(basicTypes[BasicType::Bool], "v2")}, false)};
+    }
+
+    return LLVM::call(generator->functions[Symbol("llvm.expect.i1")], {condition, {LLVM::makeInt(1, expected ? 1 : 0, false), basicTypes[BasicType::Bool]}}, name);
+}
+
 // Wrapper for the LLVMConstInBoundsGEP2 function using RaveValue.
 RaveValue LLVM::cInboundsGep(RaveValue ptr, LLVMValueRef* indices, unsigned int indicesCount) {
     return {LLVMConstInBoundsGEP2(generator->genType(ptr.type->getElType(), -1), ptr.value, indices, indicesCount), ptr.type->getElType()};
@@ -109,12 +122,12 @@ RaveValue LLVM::structGep(RaveValue ptr, unsigned int idx, const char* name) {
     return {LLVMBuildStructGEP2(
         generator->builder, generator->genType(ts, -1),
         ptr.value, idx, name
-    ), Types::getPointerType(AST::structTable[ts->name]->variables[idx]->getType())};
+    ), Types::getPointerType(AST::structTable[Symbol(ts->name)]->variables[idx]->getType())};
 }
 
 // Wrapper for the LLVMBuildAlloca function using RaveValue. Builds alloca at the first basic block for saving stack memory (C behaviour).
 RaveValue LLVM::alloc(Type* type, const char* name) {
-    LLVMPositionBuilder(generator->builder, LLVMGetFirstBasicBlock(generator->functions[currScope->funcName].value), LLVMGetFirstInstruction(LLVMGetFirstBasicBlock(generator->functions[currScope->funcName].value)));
+    LLVMPositionBuilder(generator->builder, LLVMGetFirstBasicBlock(generator->functions[Symbol(currScope->funcName)].value), LLVMGetFirstInstruction(LLVMGetFirstBasicBlock(generator->functions[Symbol(currScope->funcName)].value)));
     LLVMValueRef value = LLVMBuildAlloca(generator->builder, generator->genType(type, -1), name);
     LLVMPositionBuilderAtEnd(generator->builder, generator->currBB);
     return {value, Types::getPointerType(type)};
@@ -160,7 +173,7 @@ LLVMBasicBlockRef LLVM::makeBlock(std::string name, LLVMValueRef function) {
 }
 
 LLVMBasicBlockRef LLVM::makeBlock(std::string name, std::string fName) {
-    return LLVM::makeBlock(name, generator->functions[fName].value);
+    return LLVM::makeBlock(name, generator->functions[Symbol(fName)].value);
 }
 
 void LLVM::makeAsPointer(RaveValue& value) {
@@ -6,10 +6,12 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <iostream>
 #include <fstream>
+#include <climits>
 #include "./include/lexer/lexer.hpp"
 #include "./include/parser/parser.hpp"
 #include "./include/compiler.hpp"
 #include "./include/version.hpp"
+#include "./include/timeTrace.hpp"
 
 #define R128_IMPLEMENTATION
 #include "./include/r128.h"
@@ -22,6 +24,21 @@ std::string exePath;
 bool helpCalled = false;
 bool versionCalled = false;
 
+// Value of the option that takes a non-negative count (0 - choose automatically)
+static int countArgument(std::vector<std::string>& arguments, size_t i) {
+    if (i + 1 >= arguments.size()) Compiler::error("option \033[1m" + arguments[i] + "\033[22m requires a number!");
+
+    const std::string& value = arguments[i + 1];
+    size_t end = 0;
+    long count = -1;
+
+    try {count = std::stol(value, &end);}
+    catch (const std::exception&) {}
+
+    if (end != value.size() || count < 0 || count > INT_MAX) Compiler::error("option \033[1m" + arguments[i] + "\033[22m requires a non-negative number, got \033[1m" + value + "\033[22m!");
+    return (int)count;
+}
+
 // Analyzing command-line arguments.
 genSettings analyzeArguments(std::vector<std::string>& arguments) {
     genSettings settings;
@@ -30,7 +47,7 @@ genSettings analyzeArguments(std::vector<std::string>& arguments) {
         else if (arguments[i] == "-o" || arguments[i] == "--out") {outFile = arguments[i + 1]; i += 1;} // Output file
         else if (arguments[i] == "-np" || arguments[i] == "--noPrelude") settings.noPrelude = true; // Disables importing of std/prelude
         else if (arguments[i] == "-eml" || arguments[i] == "--emitLLVM" || arguments[i] == "-emit-llvm") settings.emitLLVM = true; // Enables output of .ll files
-        else if (arguments[i] == "-l" || arguments[i] == "--link") {settings.linkParams += "-l" + arguments[i + 1] + " "; i += 1;} // Adds library to the linker
+        else if (arguments[i] == "-l" || arguments[i] == "--link") {settings.linkParams.push_back("-l" + arguments[i + 1]); i += 1;} // Adds library to the linker
         else if (arguments[i] == "-rcs" || arguments[i] == "--recompileStd") settings.recompileStd = true; // Recompiles the standard library
         else if (arguments[i] == "-c") {settings.onlyObject = true; settings.isStatic = true;} // Enables onlyObject mode
         else if (arguments[i] == "-ne" || arguments[i] == "--noEntry") settings.noEntry = true; // Disables 'main' function as entry
@@ -42,10 +59,11 @@ genSettings analyzeArguments(std::vector<std::string>& arguments) {
         else if (arguments[i] == "-O3") settings.optLevel = 3; // Sets the optimization level to 3
         else if (arguments[i] == "-Ofast") {settings.optLevel = 3; settings.noChecks = true;} // Sets the optimization level to 3, disables runtime checks (Ofast mode)
         else if (arguments[i].find("-O") == 0) settings.optLevel = 1; // Sets the optimization level to 1 as undefined
-        else if (arguments[i] == "-s" || arguments[i] == "--shared") {settings.linkParams += "-shared "; settings.isPIE = true; settings.isPIC = false;} // Enables shared mode for linker
+        else if (arguments[i] == "-s" || arguments[i] == "--shared") {settings.linkParams.push_back("-shared"); settings.isPIE = true; settings.isPIC = false;} // Enables shared mode for linker
         else if (arguments[i] == "-sof" || arguments[i] == "--saveObjectFiles") settings.saveObjectFiles = true; // Saves object files after completing of linking
         else if (arguments[i] == "-dw" || arguments[i] == "--disableWarnings") settings.disableWarnings = true; // Disables any warnings
         else if (arguments[i] == "--debug") Compiler::debugMode = true; // Enables debug mode
+        else if (arguments[i] == "--time-trace") TimeTrace::enabled = true; // Writes a Chrome trace of the compilation
         else if (arguments[i] == "-t" || arguments[i] == "--target") {outType = arguments[i + 1]; i += 1;} // Sets the target platform type
         else if (arguments[i] == "-h" || arguments[i] == "--help") helpCalled = true; // Outputs all possible arguments
         else if (arguments[i] == "-native") settings.isNative = true; // Enables native mode (for better optimizations)
@@ -71,11 +89,21 @@ genSettings analyzeArguments(std::vector<std::string>& arguments) {
         else if (arguments[i] == "-nfm" || arguments[i] == "--noFastMath") settings.noFastMath = true; // Disables fast math
         else if (arguments[i] == "-npi" || arguments[i] == "--noPrivateInlining") settings.noPrivateInlining = true; // Disables inlining of private functions
         else if (arguments[i] == "-nio" || arguments[i] == "--noIoInit") settings.noIoInit = true; // Disables io initialize (temporarily does nothing)
+        else if (arguments[i] == "-nac" || arguments[i] == "--noAstCache") settings.noAstCache = true; // Disables the on-disk cache of parsed imports
+        else if (arguments[i] == "-inc" || arguments[i] == "--incremental") settings.incremental = true; // Reuses objects of unchanged files
+        else if (arguments[i] == "-flto") settings.lto = true; // Link-time optimization of the whole program
+        else if (arguments[i] == "-rmk" || arguments[i] == "--remarks") settings.remarks = true; // Reports whether the loop modifiers were honored
+        else if (arguments[i] == "-j" || arguments[i] == "--jobs") {settings.jobs = countArgument(arguments, i); i += 1;}
+        else if (arguments[i] == "--linker") {
+            if (i + 1 < arguments.size()) settings.linker = arguments[i + 1];
+            i += 1;
+        }
+        else if (arguments[i] == "-cgt" || arguments[i] == "--codegen-threads") {settings.codegenThreads = countArgument(arguments, i); i += 1;}
         else if (arguments[i] == "-I" || arguments[i] == "--importDirectory") {
             if (i + 1 < arguments.size()) settings.importDirectories.push_back(arguments[i + 1]);
             i += 1;
         }
-        else if (arguments[i][0] == '-') settings.linkParams += arguments[i] + " "; // Adds unknown argument to the linker
+        else if (arguments[i][0] == '-') settings.linkParams.push_back(arguments[i]); // Adds unknown argument to the linker
         else files.push_back(arguments[i]);
     }
 
@@ -110,7 +138,7 @@ int main(int argc, char** argv) {
         + "\n\t--noStd (-ns) - Do not link with standart library."
         + "\n\t--noEntry (-ne) - Passes information to the compiler that there is no start point (main) in the code."
         + "\n\t--noPrelude (-np) - Disable automatic import of <std/prelude> and <std/memory>."
-        + "\n\t--noChecks (-nc) - Disables runtime checks (automatically at -Ofast)."
+        + "\n\t--noChecks (-nc) - Disables runtime checks (they are kept at every optimization level except -Ofast)."
         + "\n\t--saveObjectfiles (-sof) - Save the object files after compilation."
         + "\n\t--disableWarnings (-dw) - Disables warnings."
         + "\n\t--shared (-s) - Creates a shared output files."
@@ -123,7 +151,15 @@ int main(int argc, char** argv) {
         + "\n\t--noFastMath (-nfm) - Disable fast math."
         + "\n\t--noPrivateInlining (-npi) - Disable inlining of private functions."
         + "\n\t--noIoInit (-nio) - Disable the automatic std::io:initialize call at the beginning of 'main'."
+        + "\n\t--noAstCache (-nac) - Do not read or write the cache of parsed imports (std/.cache)."
         + "\n\t--importDirectory (-I) <dir> - Add directory to import search path (can be used multiple times)."
+        + "\n\t--incremental (-inc) - Keep object files and reuse them while the file, its imports and the settings are unchanged."
+        + "\n\t-flto - Keep every file in LLVM bitcode and optimize the whole program at once before the codegen."
+        + "\n\t--remarks (-rmk) - Report whether the loop modifiers (unroll, vectorize, interleave, distribute) were honored by the optimizer (without -flto). For interleave it only reports whether the loop was processed by the vectorizer, not the interleave count."
+        + "\n\t--jobs (-j) <n> - Compile up to <n> files at the same time (0 - one per CPU core)."
+        + "\n\t--linker <name> - Link with the <name> linker (-fuse-ld=<name>) if it is installed; the compiler's default linker otherwise."
+        + "\n\t--time-trace - Write a Chrome/Perfetto trace of the compilation to <output>.time-trace.json."
+        + "\n\t--codegen-threads (-cgt) <n> - Split every module into <n> parts and emit them on <n> threads (0 - one per CPU core)."
         + "\nFor bug reporting, you can use Issues at https://github.com/Ttimofeyka/Rave.";
         std::cout << help << std::endl;
         return 0;
@@ -133,23 +169,24 @@ int main(int argc, char** argv) {
         if (options.recompileStd) {
             Compiler::initialize(outFile, outType, options, {""});
             auto stdFiles = filesInDirectory(exePath + "std");
+            std::vector<std::string> units;
             for (size_t i=0; i<stdFiles.size(); i++) {
-                if (stdFiles[i].find(".ll") == std::string::npos && stdFiles[i].find(".rave") != std::string::npos) {
-                    std::string compiledFile = replaceExtension(exePath + "std/" + stdFiles[i], ".rave", ".o");
-                    Compiler::compile(exePath + "std/" + stdFiles[i]);
-
-                    if (options.emitLLVM) {
-                        char* err;
-                        LLVMPrintModuleToFile(generator->lModule, (exePath + "std/" + stdFiles[i] + ".ll").c_str(), &err);
-                    }
-
-                    std::ifstream src(compiledFile, std::ios::binary);
-                    std::ofstream dst(replaceExtension(compiledFile, ".o", std::string(".") + Compiler::outType + ".o"), std::ios::binary);
-                    dst << src.rdbuf();
-                }
+                if (stdFiles[i].find(".ll") == std::string::npos && stdFiles[i].find(".rave") != std::string::npos) units.push_back(exePath + "std/" + stdFiles[i]);
             }
 
-            std::cout << "Time spent by lexer: " << std::to_string(Compiler::lexTime) << "ms\nTime spent by parser: " << std::to_string(Compiler::parseTime) << "ms\nTime spent by generator: " << std::to_string(Compiler::genTime) << "ms" << std::endl;
+            Compiler::setupTarget();
+            Compiler::compileUnits(units, [](std::string file) {
+                Compiler::compile(file);
+
+                if (options.emitLLVM) {
+                    char* err;
+                    LLVMPrintModuleToFile(generator->lModule, (file + ".ll").c_str(), &err);
+                }
+            });
+
+            if (TimeTrace::enabled) TimeTrace::write(exePath + "std/std.time-trace.json");
+
+            std::cout << "Time spent on startup: " << std::to_string(Compiler::startupTime) << "ms\nTime spent by lexer: " << std::to_string(Compiler::lexTime) << "ms\nTime spent by parser: " << std::to_string(Compiler::parseTime) << "ms\nTime spent by generator: " << std::to_string(Compiler::genTime) << "ms" << std::endl;
             return 0;
         }
         std::cout << "\033[0;31mError: no files to compile!\033[0;0m" << std::endl;
@@ -0,0 +1,783 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../include/parser/ASTCache.hpp"
+#include "../include/parser/ast.hpp"
+#include "../include/parser/parser.hpp"
+#include "../include/parser/nodes/NodeAliasType.hpp"
+#include "../include/parser/nodes/NodeArray.hpp"
+#include "../include/parser/nodes/NodeAsm.hpp"
+#include "../include/parser/nodes/NodeBinary.hpp"
+#include "../include/parser/nodes/NodeBitcast.hpp"
+#include "../include/parser/nodes/NodeBlock.hpp"
+#include "../include/parser/nodes/NodeBool.hpp"
+#include "../include/parser/nodes/NodeBuiltin.hpp"
+#include "../include/parser/nodes/NodeCall.hpp"
+#include "../include/parser/nodes/NodeCast.hpp"
+#include "../include/parser/nodes/NodeChar.hpp"
+#include "../include/parser/nodes/NodeCmpxchg.hpp"
+#include "../include/parser/nodes/NodeComptime.hpp"
+#include "../include/parser/nodes/NodeConstStruct.hpp"
+#include "../include/parser/nodes/NodeDefer.hpp"
+#include "../include/parser/nodes/NodeFloat.hpp"
+#include "../include/parser/nodes/NodeFor.hpp"
+#include "../include/parser/nodes/NodeForeach.hpp"
+#include "../include/parser/nodes/NodeFunc.hpp"
+#include "../include/parser/nodes/NodeGet.hpp"
+#include "../include/parser/nodes/NodeIden.hpp"
+#include "../include/parser/nodes/NodeIf.hpp"
+#include "../include/parser/nodes/NodeImport.hpp"
+#include "../include/parser/nodes/NodeIndex.hpp"
+#include "../include/parser/nodes/NodeInt.hpp"
+#include "../include/parser/nodes/NodeItop.hpp"
+#include "../include/parser/nodes/NodeLambda.hpp"
+#include "../include/parser/nodes/NodeLoopControl.hpp"
+#include "../include/parser/nodes/NodeNamespace.hpp"
+#include "../include/parser/nodes/NodeNone.hpp"
+#include "../include/parser/nodes/NodeNull.hpp"
+#include "../include/parser/nodes/NodePtoi.hpp"
+#include "../include/parser/nodes/NodeRet.hpp"
+#include "../include/parser/nodes/NodeSizeof.hpp"
+#include "../include/parser/nodes/NodeSlice.hpp"
+#include "../include/parser/nodes/NodeString.hpp"
+#include "../include/parser/nodes/NodeStruct.hpp"
+#include "../include/parser/nodes/NodeSwitch.hpp"
+#include "../include/parser/nodes/NodeType.hpp"
+#include "../include/parser/nodes/NodeUnary.hpp"
+#include "../include/parser/nodes/NodeVar.hpp"
+#include "../include/parser/nodes/NodeWhile.hpp"
+#include "../include/version.hpp"
+#include "../include/compiler.hpp"
+#include <fstream>
+#include <cstdint>
+
+#ifdef _WIN32
+   #include <process.h>
+   #define getpid _getpid
+#else
+   #include <unistd.h>
+#endif
+
+#ifndef __has_include
+  static_assert(false, "__has_include not supported");
+#else
+#if __cplusplus >= 201703L && __has_include(<filesystem>)
+#include <filesystem>
+    namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#    include <experimental/filesystem>
+    namespace fs = std::experimental::filesystem;
+#elif __has_include(<boost/filesystem.hpp>)
+#include <boost/filesystem.hpp>
+    namespace fs = boost::filesystem;
+#  endif
+#endif
+
+// Must be increased every time the layout below (or the parse state of any node) changes.
+#define RAST_FORMAT 3
+#define RAST_MAGIC "RAST"
+
+namespace ASTCache {
+    enum NodeTag : unsigned char {
+        NNull, NAliasType, NArray, NAsm, NBinary, NBitcast, NBlock, NBool, NBuiltin, NCall, NCast, NChar, NCmpxchg, NComptime,
+        NConstStruct, NDefer, NFloat, NFor, NForeach, NFunc, NGet, NIden, NIf, NImport, NImports, NIndex, NInt, NItop, NLambda,
+        NLoopControl, NNamespace, NNone, NNullValue, NPtoi, NRet, NSizeof, NSlice, NString, NStruct, NSwitch, NType, NUnary, NVar, NWhile
+    };
+
+    enum TypeTag : unsigned char {
+        TNull, TBasic, TVoid, TPointer, TArray, TAlias, TConst, TStruct, TByval, TTemplateMember, TTemplateMemberDefinition,
+        TFuncArg, TFunc, TBuiltin, TCall, TAuto, TVector, TDivided
+    };
+
+    // Serializer of the parse state. Nodes that cannot be stored (e.g. already generated values) mark the whole entry as invalid.
+    class Writer {
+    public:
+        std::string buffer;
+        bool isValid = true;
+
+        void u8(unsigned char value) {buffer.push_back((char)value);}
+        void boolean(bool value) {u8(value ? 1 : 0);}
+
+        void i32(int value) {
+            uint32_t v = (uint32_t)value;
+            for (int i=0; i<4; i++) buffer.push_back((char)((v >> (i * 8)) & 0xFF));
+        }
+
+        void str(const std::string& value) {i32((int)value.size()); buffer += value;}
+
+        void strings(const std::vector<std::string>& values) {
+            i32((int)values.size());
+            for (const auto& value : values) str(value);
+        }
+
+        void nodes(const std::vector<Node*>& values) {
+            i32((int)values.size());
+            for (Node* value : values) node(value);
+        }
+
+        void types(const std::vector<Type*>& values) {
+            i32((int)values.size());
+            for (Type* value : values) type(value);
+        }
+
+        void mods(const std::vector<DeclarMod>& values) {
+            i32((int)values.size());
+            for (const auto& mod : values) {str(mod.name); node(mod.value);}
+        }
+
+        void type(Type* value);
+        void node(Node* value);
+    };
+
+    void Writer::type(Type* value) {
+        if (value == nullptr) {u8(TNull); return;}
+
+        switch (value->typeKind) {
+            case TypeKind::Basic: u8(TBasic); u8((unsigned char)((TypeBasic*)value)->type); break;
+            case TypeKind::Void: u8(TVoid); break;
+            case TypeKind::Pointer: u8(TPointer); type(((TypePointer*)value)->instance); break;
+            case TypeKind::Array: u8(TArray); node(((TypeArray*)value)->count); type(((TypeArray*)value)->element); break;
+            case TypeKind::Alias: u8(TAlias); break;
+            case TypeKind::Const: u8(TConst); type(((TypeConst*)value)->instance); break;
+            case TypeKind::Struct: u8(TStruct); str(((TypeStruct*)value)->name); types(((TypeStruct*)value)->types); break;
+            case TypeKind::Byval: u8(TByval); type(((TypeByval*)value)->type); break;
+            case TypeKind::TemplateMember:
+                u8(TTemplateMember);
+                type(((TypeTemplateMember*)value)->type);
+                node(((TypeTemplateMember*)value)->value);
+                break;
+            case TypeKind::TemplateMemberDefinition:
+                u8(TTemplateMemberDefinition);
+                type(((TypeTemplateMemberDefinition*)value)->type);
+                str(((TypeTemplateMemberDefinition*)value)->name);
+                break;
+            case TypeKind::FuncArg: u8(TFuncArg); type(((TypeFuncArg*)value)->type); str(((TypeFuncArg*)value)->name); break;
+            case TypeKind::Func: {
+                TypeFunc* tf = (TypeFunc*)value;
+                u8(TFunc);
+                type(tf->main);
+                i32((int)tf->args.size());
+                for (TypeFuncArg* arg : tf->args) type(arg);
+                boolean(tf->isVarArg);
+                break;
+            }
+            case TypeKind::Builtin:
+                u8(TBuiltin);
+                str(((TypeBuiltin*)value)->name);
+                nodes(((TypeBuiltin*)value)->args);
+                node(((TypeBuiltin*)value)->block);
+                break;
+            case TypeKind::Call: u8(TCall); str(((TypeCall*)value)->name); nodes(((TypeCall*)value)->args); break;
+            case TypeKind::Auto: u8(TAuto); break;
+            case TypeKind::Vector: u8(TVector); type(((TypeVector*)value)->mainType); i32(((TypeVector*)value)->count); break;
+            case TypeKind::Divided: u8(TDivided); type(((TypeDivided*)value)->mainType); types(((TypeDivided*)value)->divided); break;
+
+            // Wraps an LLVM type, which only exists while the module is generated
+            case TypeKind::LLVM: u8(TNull); isValid = false; break;
+        }
+    }
+
+    void Writer::node(Node* value) {
+        if (value == nullptr) {u8(NNull); return;}
+
+        switch (value->nodeKind) {
+            case NodeKind::Iden: {NodeIden* n = (NodeIden*)value; u8(NIden); str(n->name); i32(n->loc); boolean(n->isMustBePtr); break;}
+            case NodeKind::Call: {NodeCall* n = (NodeCall*)value; u8(NCall); i32(n->loc); node(n->func); nodes(n->args); break;}
+            case NodeKind::Int: {
+                NodeInt* n = (NodeInt*)value;
+                u8(NInt); str(n->value.to_string()); u8((unsigned char)n->type); type(n->isVarVal); u8(n->sys);
+                boolean(n->isUnsigned); boolean(n->isMustBeLong); boolean(n->isMustBeChar); boolean(n->isMustBeShort);
+                break;
+            }
+            case NodeKind::Binary: {NodeBinary* n = (NodeBinary*)value; u8(NBinary); u8((unsigned char)n->op); node(n->first); node(n->second); i32(n->loc); boolean(n->isStatic); break;}
+            case NodeKind::Get: {NodeGet* n = (NodeGet*)value; u8(NGet); node(n->base); str(n->field); boolean(n->isMustBePtr); i32(n->loc); boolean(n->isPtrForIndex); break;}
+            case NodeKind::Block: {NodeBlock* n = (NodeBlock*)value; u8(NBlock); nodes(n->nodes); break;}
+            case NodeKind::Var: {
+                NodeVar* n = (NodeVar*)value;
+                u8(NVar); str(n->name); node(n->value); boolean(n->isExtern); boolean(n->isConst); boolean(n->isGlobal);
+                mods(n->mods); i32(n->loc); type(n->type); boolean(n->isVolatile); boolean(n->isChanged); boolean(n->noZeroInit);
+                break;
+            }
+            case NodeKind::String: {NodeString* n = (NodeString*)value; u8(NString); str(n->value); boolean(n->isWide); break;}
+            case NodeKind::If: {
+                NodeIf* n = (NodeIf*)value;
+                u8(NIf); node(n->cond); node(n->body); node(n->_else); i32(n->loc);
+                boolean(n->isStatic); boolean(n->isLikely); boolean(n->isUnlikely);
+                break;
+            }
+            case NodeKind::Ret: {NodeRet* n = (NodeRet*)value; u8(NRet); node(n->value); i32(n->loc); break;}
+            case NodeKind::Index: {NodeIndex* n = (NodeIndex*)value; u8(NIndex); node(n->element); nodes(n->indexes); i32(n->loc); break;}
+            case NodeKind::Unary: {NodeUnary* n = (NodeUnary*)value; u8(NUnary); i32(n->loc); u8((unsigned char)n->type); node(n->base); break;}
+            case NodeKind::Type: {NodeType* n = (NodeType*)value; u8(NType); type(n->type); i32(n->loc); break;}
+            case NodeKind::Func: {
+                NodeFunc* n = (NodeFunc*)value;
+                u8(NFunc); str(n->name);
+                i32((int)n->args.size());
+                for (const auto& arg : n->args) {str(arg.name); type(arg.type); types(arg.internalTypes);}
+                node(n->block); boolean(n->isExtern); mods(n->mods); i32(n->loc); type(n->type); strings(n->templateNames);
+                break;
+            }
+            case NodeKind::Builtin: {
+                NodeBuiltin* n = (NodeBuiltin*)value;
+                u8(NBuiltin); str(n->name); nodes(n->args); i32(n->loc); node(n->block); type(n->type);
+                boolean(n->isImport); boolean(n->isTopLevel); i32(n->CTId);
+                break;
+            }
+            case NodeKind::Cast: {NodeCast* n = (NodeCast*)value; u8(NCast); type(n->type); node(n->value); i32(n->loc); break;}
+            case NodeKind::Bool: {NodeBool* n = (NodeBool*)value; u8(NBool); boolean(n->value); break;}
+            case NodeKind::Char: {NodeChar* n = (NodeChar*)value; u8(NChar); str(n->value); boolean(n->isWide); break;}
+            case NodeKind::Float: {
+                NodeFloat* n = (NodeFloat*)value;
+                u8(NFloat); str(n->value);
+                u8(n->type == nullptr ? 0xFF : (unsigned char)n->type->type);
+                boolean(n->isMustBeFloat);
+                break;
+            }
+            case NodeKind::Null: {NodeNull* n = (NodeNull*)value; u8(NNullValue); type(n->type); i32(n->loc); break;}
+            case NodeKind::While: {NodeWhile* n = (NodeWhile*)value; u8(NWhile); node(n->cond); node(n->body); i32(n->loc); mods(n->mods); break;}
+            case NodeKind::For: {NodeFor* n = (NodeFor*)value; u8(NFor); nodes(n->presets); node(n->cond); nodes(n->afters); node(n->block); i32(n->loc); mods(n->mods); break;}
+            case NodeKind::Foreach: {
+                NodeForeach* n = (NodeForeach*)value;
+                u8(NForeach); node(n->elName); node(n->varData); node(n->varLength); node(n->block); i32(n->loc); boolean(n->isReference); mods(n->mods);
+                break;
+            }
+            case NodeKind::Struct: {
+                NodeStruct* n = (NodeStruct*)value;
+                u8(NStruct); str(n->name); nodes(n->elements); i32(n->loc); str(n->extends); strings(n->templateNames); mods(n->mods);
+                break;
+            }
+            case NodeKind::Namespace: {NodeNamespace* n = (NodeNamespace*)value; u8(NNamespace); strings(n->names); nodes(n->nodes); i32(n->loc); break;}
+            case NodeKind::Import: {NodeImport* n = (NodeImport*)value; u8(NImport); str(n->file.file); boolean(n->file.isGlobal); strings(n->functions); i32(n->loc); break;}
+            case NodeKind::Imports: {
+                NodeImports* n = (NodeImports*)value;
+                u8(NImports);
+                i32((int)n->imports.size());
+                for (NodeImport* imp : n->imports) node(imp);
+                i32(n->loc);
+                break;
+            }
+            case NodeKind::AliasType: {NodeAliasType* n = (NodeAliasType*)value; u8(NAliasType); str(n->name); type(n->value); i32(n->loc); break;}
+            case NodeKind::Array: {NodeArray* n = (NodeArray*)value; u8(NArray); i32(n->loc); nodes(n->values); break;}
+            case NodeKind::Asm: {
+                NodeAsm* n = (NodeAsm*)value;
+                u8(NAsm); str(n->line); boolean(n->isVolatile); type(n->type); str(n->additions); nodes(n->values); i32(n->loc);
+                break;
+            }
+            case NodeKind::Bitcast: {NodeBitcast* n = (NodeBitcast*)value; u8(NBitcast); type(n->type); node(n->value); i32(n->loc); break;}
+            case NodeKind::Cmpxchg: {NodeCmpxchg* n = (NodeCmpxchg*)value; u8(NCmpxchg); node(n->ptr); node(n->value1); node(n->value2); i32(n->loc); break;}
+            case NodeKind::Comptime: {NodeComptime* n = (NodeComptime*)value; u8(NComptime); node(n->node); boolean(n->isImported); break;}
+            case NodeKind::ConstStruct: {NodeConstStruct* n = (NodeConstStruct*)value; u8(NConstStruct); str(n->structName); nodes(n->values); i32(n->loc); break;}
+            case NodeKind::Defer: {NodeDefer* n = (NodeDefer*)value; u8(NDefer); i32(n->loc); node(n->instruction); boolean(n->isFunctionScope); break;}
+            case NodeKind::Itop: {NodeItop* n = (NodeItop*)value; u8(NItop); node(n->value); type(n->type); i32(n->loc); break;}
+            case NodeKind::Lambda: {NodeLambda* n = (NodeLambda*)value; u8(NLambda); i32(n->loc); type(n->tf); node(n->block); str(n->name); break;}
+            case NodeKind::LoopControl: {NodeLoopControl* n = (NodeLoopControl*)value; u8(NLoopControl); u8((unsigned char)n->kind); i32(n->loc); break;}
+            case NodeKind::Ptoi: {NodePtoi* n = (NodePtoi*)value; u8(NPtoi); node(n->value); i32(n->loc); break;}
+            case NodeKind::Sizeof: {NodeSizeof* n = (NodeSizeof*)value; u8(NSizeof); node(n->value); i32(n->loc); break;}
+            case NodeKind::Slice: {NodeSlice* n = (NodeSlice*)value; u8(NSlice); node(n->base); node(n->start); node(n->end); i32(n->loc); break;}
+            case NodeKind::Switch: {
+                NodeSwitch* n = (NodeSwitch*)value;
+                u8(NSwitch); node(n->expr); node(n->_default);
+                i32((int)n->statements.size());
+                for (const auto& statement : n->statements) {nodes(statement.first); node(statement.second);}
+                i32(n->loc);
+                break;
+            }
+            case NodeKind::None: u8(NNone); break;
+
+            // Holds a generated value, which only exists while the module is generated
+            case NodeKind::Done: u8(NNull); isValid = false; break;
+        }
+    }
+
+    // Deserializer. Every node is rebuilt through its parser-facing constructor, so it ends up in the same state as after Parser::parseAll.
+    class Reader {
+    public:
+        const std::string& buffer;
+        size_t pos = 0;
+        bool isValid = true;
+
+        Reader(const std::string& buffer) : buffer(buffer) {}
+
+        unsigned char u8() {
+            if (pos >= buffer.size()) {isValid = false; return 0;}
+            return (unsigned char)buffer[pos++];
+        }
+
+        bool boolean() {return u8() != 0;}
+
+        int i32() {
+            if (pos + 4 > buffer.size()) {isValid = false; pos = buffer.size(); return 0;}
+            uint32_t v = 0;
+            for (int i=0; i<4; i++) v |= ((uint32_t)(unsigned char)buffer[pos++]) << (i * 8);
+            return (int)v;
+        }
+
+        // Guards container sizes against corrupted entries
+        size_t count() {
+            int n = i32();
+            if (n < 0 || (size_t)n > buffer.size() - pos) {isValid = false; return 0;}
+            return (size_t)n;
+        }
+
+        std::string str() {
+            size_t n = count();
+            std::string value = buffer.substr(pos, n);
+            pos += n;
+            return value;
+        }
+
+        std::vector<std::string> strings() {
+            std::vector<std::string> values(count());
+            for (size_t i=0; i<values.size() && isValid; i++) values[i] = str();
+            return values;
+        }
+
+        std::vector<Node*> nodes() {
+            std::vector<Node*> values(count());
+            for (size_t i=0; i<values.size() && isValid; i++) values[i] = node();
+            return values;
+        }
+
+        std::vector<Type*> types() {
+            std::vector<Type*> values(count());
+            for (size_t i=0; i<values.size() && isValid; i++) values[i] = type();
+            return values;
+        }
+
+        std::vector<DeclarMod> mods() {
+            std::vector<DeclarMod> values(count());
+            for (size_t i=0; i<values.size() && isValid; i++) {
+                values[i].name = str();
+                values[i].value = node();
+            }
+            return values;
+        }
+
+        NodeBlock* block() {
+            Node* value = node();
+            if (value != nullptr && !instanceof<NodeBlock>(value)) {isValid = false; return nullptr;}
+            return (NodeBlock*)value;
+        }
+
+        Type* type();
+        Node* node();
+    };
+
+    Type* Reader::type() {
+        if (!isValid) return nullptr;
+
+        switch (u8()) {
+            case TNull: return nullptr;
+            case TBasic: {
+                char basic = (char)u8();
+                if (basicTypes.find(basic) == basicTypes.end()) {isValid = false; return nullptr;}
+                return basicTypes[basic];
+            }
+            case TVoid: return typeVoid;
+            case TPointer: return new TypePointer(type());
+            case TArray: {
+                Node* count = node();
+                return new TypeArray(count, type());
+            }
+            case TAlias: return new TypeAlias();
+            case TConst: return new TypeConst(type());
+            case TStruct: {
+                std::string name = str();
+                return new TypeStruct(name, types());
+            }
+            case TByval: return new TypeByval(type());
+            case TTemplateMember: {
+                Type* tp = type();
+                return new TypeTemplateMember(tp, node());
+            }
+            case TTemplateMemberDefinition: {
+                Type* tp = type();
+                return new TypeTemplateMemberDefinition(tp, str());
+            }
+            case TFuncArg: {
+                Type* tp = type();
+                return new TypeFuncArg(tp, str());
+            }
+            case TFunc: {
+                Type* main = type();
+                std::vector<TypeFuncArg*> args(count());
+                for (size_t i=0; i<args.size() && isValid; i++) {
+                    Type* arg = type();
+                    if (!instanceof<TypeFuncArg>(arg)) {isValid = false; return nullptr;}
+                    args[i] = (TypeFuncArg*)arg;
+                }
+                return new TypeFunc(main, args, boolean());
+            }
+            case TBuiltin: {
+                std::string name = str();
+                std::vector<Node*> args = nodes();
+                return new TypeBuiltin(name, args, block());
+            }
+            case TCall: {
+                std::string name = str();
+                return new TypeCall(name, nodes());
+            }
+            case TAuto: return new TypeAuto();
+            case TVector: {
+                Type* mainType = type();
+                return new TypeVector(mainType, i32());
+            }
+            case TDivided: {
+                Type* mainType = type();
+                return new TypeDivided(mainType, types());
+            }
+            default: isValid = false; return nullptr;
+        }
+    }
+
+    Node* Reader::node() {
+        if (!isValid) return nullptr;
+
+        switch (u8()) {
+            case NNull: return nullptr;
+            case NIden: {
+                std::string name = str();
+                int loc = i32();
+                return new NodeIden(name, loc, boolean());
+            }
+            case NCall: {
+                int loc = i32();
+                Node* func = node();
+                return new NodeCall(loc, func, nodes());
+            }
+            case NInt: {
+                std::string value = str();
+                char type = (char)u8();
+                Type* isVarVal = this->type();
+                unsigned char sys = u8();
+                bool isUnsigned = boolean();
+                bool isMustBeLong = boolean();
+                if (!isValid) return nullptr;
+
+                NodeInt* n = new NodeInt(BigInt(value), type, isVarVal, sys, isUnsigned, isMustBeLong);
+                n->isMustBeChar = boolean();
+                n->isMustBeShort = boolean();
+                return n;
+            }
+            case NBinary: {
+                char op = (char)u8();
+                Node* first = node();
+                Node* second = node();
+                int loc = i32();
+                return new NodeBinary(op, first, second, loc, boolean());
+            }
+            case NGet: {
+                Node* base = node();
+                std::string field = str();
+                bool isMustBePtr = boolean();
+                NodeGet* n = new NodeGet(base, field, isMustBePtr, i32());
+                n->isPtrForIndex = boolean();
+                return n;
+            }
+            case NBlock: return new NodeBlock(nodes());
+            case NVar: {
+                std::string name = str();
+                Node* value = node();
+                bool isExtern = boolean();
+                bool isConst = boolean();
+                bool isGlobal = boolean();
+                std::vector<DeclarMod> mods = this->mods();
+                int loc = i32();
+                Type* type = this->type();
+                bool isVolatile = boolean();
+                bool isChanged = boolean();
+                return new NodeVar(name, value, isExtern, isConst, isGlobal, mods, loc, type, isVolatile, isChanged, boolean());
+            }
+            case NString: {
+                std::string value = str();
+                return new NodeString(value, boolean());
+            }
+            case NIf: {
+                Node* cond = node();
+                Node* body = node();
+                Node* _else = node();
+                int loc = i32();
+                NodeIf* n = new NodeIf(cond, body, _else, loc, boolean());
+                n->isLikely = boolean();
+                n->isUnlikely = boolean();
+                return n;
+            }
+            case NRet: {
+                Node* value = node();
+                return new NodeRet(value, i32());
+            }
+            case NIndex: {
+                Node* element = node();
+                std::vector<Node*> indexes = nodes();
+                return new NodeIndex(element, indexes, i32());
+            }
+            case NUnary: {
+                int loc = i32();
+                char type = (char)u8();
+                return new NodeUnary(loc, type, node());
+            }
+            case NType: {
+                Type* tp = type();
+                return new NodeType(tp, i32());
+            }
+            case NFunc: {
+                std::string name = str();
+                std::vector<FuncArgSet> args(count());
+                for (size_t i=0; i<args.size() && isValid; i++) {
+                    args[i].name = str();
+                    args[i].type = type();
+                    args[i].internalTypes = types();
+                }
+
+                NodeBlock* block = this->block();
+                bool isExtern = boolean();
+                std::vector<DeclarMod> mods = this->mods();
+                int loc = i32();
+                Type* type = this->type();
+                return new NodeFunc(name, args, block, isExtern, mods, loc, type, strings());
+            }
+            case NBuiltin: {
+                std::string name = str();
+                std::vector<Node*> args = nodes();
+                int loc = i32();
+                NodeBlock* block = this->block();
+                Type* type = this->type();
+                bool isImport = boolean();
+                bool isTopLevel = boolean();
+                return new NodeBuiltin(name, args, loc, block, type, isImport, isTopLevel, i32());
+            }
+            case NCast: {
+                Type* tp = type();
+                Node* value = node();
+                return new NodeCast(tp, value, i32());
+            }
+            case NBool: return new NodeBool(boolean());
+            case NChar: {
+                std::string value = str();
+                return new NodeChar(value, boolean());
+            }
+            case NFloat: {
+                std::string value = str();
+                unsigned char basic = u8();
+                TypeBasic* tp = nullptr;
+
+                if (basic != 0xFF) {
+                    if (basicTypes.find((char)basic) == basicTypes.end()) {isValid = false; return nullptr;}
+                    tp = basicTypes[(char)basic];
+                }
+
+                NodeFloat* n = new NodeFloat(value, tp);
+                n->isMustBeFloat = boolean();
+                return n;
+            }
+            case NNullValue: {
+                Type* tp = type();
+                return new NodeNull(tp, i32());
+            }
+            case NWhile: {
+                Node* cond = node();
+                Node* body = node();
+                NodeWhile* nwhile = new NodeWhile(cond, body, i32());
+                nwhile->mods = mods();
+                return nwhile;
+            }
+            case NFor: {
+                std::vector<Node*> presets = nodes();
+                Node* cond = node();
+                std::vector<Node*> afters = nodes();
+                NodeBlock* block = this->block();
+                NodeFor* nfor = new NodeFor(presets, cond, afters, block, i32());
+                nfor->mods = mods();
+                return nfor;
+            }
+            case NForeach: {
+                Node* elName = node();
+                if (elName != nullptr && !instanceof<NodeIden>(elName)) {isValid = false; return nullptr;}
+
+                Node* varData = node();
+                Node* varLength = node();
+                NodeBlock* block = this->block();
+                int loc = i32();
+                NodeForeach* nforeach = new NodeForeach((NodeIden*)elName, varData, varLength, block, loc, boolean());
+                nforeach->mods = mods();
+                return nforeach;
+            }
+            case NStruct: {
+                std::string name = str();
+                std::vector<Node*> elements = nodes();
+                int loc = i32();
+                std::string extends = str();
+                std::vector<std::string> templateNames = strings();
+                return new NodeStruct(name, elements, loc, extends, templateNames, mods());
+            }
+            case NNamespace: {
+                std::vector<std::string> names = strings();
+                std::vector<Node*> nodes = this->nodes();
+                return new NodeNamespace(names, nodes, i32());
+            }
+            case NImport: {
+                ImportFile file;
+                file.file = str();
+                file.isGlobal = boolean();
+                std::vector<std::string> functions = strings();
+                return new NodeImport(file, functions, i32());
+            }
+            case NImports: {
+                std::vector<NodeImport*> imports(count());
+                for (size_t i=0; i<imports.size() && isValid; i++) {
+                    Node* imp = node();
+                    if (!instanceof<NodeImport>(imp)) {isValid = false; return nullptr;}
+                    imports[i] = (NodeImport*)imp;
+                }
+                return new NodeImports(imports, i32());
+            }
+            case NAliasType: {
+                std::string name = str();
+                Type* value = type();
+                return new NodeAliasType(name, value, i32());
+            }
+            case NArray: {
+                int loc = i32();
+                return new NodeArray(loc, nodes());
+            }
+            case NAsm: {
+                std::string line = str();
+                bool isVolatile = boolean();
+                Type* tp = type();
+                std::string additions = str();
+                std::vector<Node*> values = nodes();
+                return new NodeAsm(line, isVolatile, tp, additions, values, i32());
+            }
+            case NBitcast: {
+                Type* tp = type();
+                Node* value = node();
+                return new NodeBitcast(tp, value, i32());
+            }
+            case NCmpxchg: {
+                Node* ptr = node();
+                Node* value1 = node();
+                Node* value2 = node();
+                return new NodeCmpxchg(ptr, value1, value2, i32());
+            }
+            case NComptime: {
+                NodeComptime* n = new NodeComptime(node());
+                n->isImported = boolean();
+                return n;
+            }
+            case NConstStruct: {
+                std::string name = str();
+                std::vector<Node*> values = nodes();
+                return new NodeConstStruct(name, values, i32());
+            }
+            case NDefer: {
+                int loc = i32();
+                Node* instruction = node();
+                return new NodeDefer(loc, instruction, boolean());
+            }
+            case NItop: {
+                Node* value = node();
+                Type* tp = type();
+                return new NodeItop(value, tp, i32());
+            }
+            case NLambda: {
+                int loc = i32();
+                Type* tf = type();
+                if (!instanceof<TypeFunc>(tf)) {isValid = false; return nullptr;}
+
+                NodeBlock* block = this->block();
+                return new NodeLambda(loc, (TypeFunc*)tf, block, str());
+            }
+            case NLoopControl: {
+                LoopControlKind kind = (LoopControlKind)u8();
+                return new NodeLoopControl(kind, i32());
+            }
+            case NPtoi: {
+                Node* value = node();
+                return new NodePtoi(value, i32());
+            }
+            case NSizeof: {
+                Node* value = node();
+                return new NodeSizeof(value, i32());
+            }
+            case NSlice: {
+                Node* base = node();
+                Node* start = node();
+                Node* end = node();
+                return new NodeSlice(base, start, end, i32());
+            }
+            case NSwitch: {
+                Node* expr = node();
+                Node* _default = node();
+                std::vector<std::pair<std::vector<Node*>, Node*>> statements(count());
+                for (size_t i=0; i<statements.size() && isValid; i++) {
+                    statements[i].first = nodes();
+                    statements[i].second = node();
+                }
+                return new NodeSwitch(expr, _default, statements, i32());
+            }
+            case NNone: return new NodeNone();
+            default: isValid = false; return nullptr;
+        }
+    }
+
+    static std::string getPath(const std::string& file, const std::string& content) {
+        std::string key = std::string(RAVE_VERSION) + '\0' + std::to_string(RAST_FORMAT) + '\0' + std::to_string(pointerSize) + '\0' + exePath;
+        for (const auto& dir : Compiler::settings.importDirectories) key += '\0' + dir;
+        key += '\0' + file + '\0' + content;
+
+        return exePath + "std/.cache/" + hashString(key) + ".rast";
+    }
+
+    bool load(const std::string& file, const std::string& content, std::vector<Node*>& nodes) {
+        if (Compiler::settings.noAstCache) return false;
+
+        std::ifstream stream(getPath(file, content), std::ios::binary);
+        if (!stream.is_open()) return false;
+
+        std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        Reader reader(data);
+
+        // Header: magic, format and the source itself, which rules out hash collisions
+        for (const char* c = RAST_MAGIC; *c; c++) if (reader.u8() != (unsigned char)*c) return false;
+        if (reader.i32() != RAST_FORMAT || reader.str() != file || reader.str() != content || !reader.isValid) return false;
+
+        std::vector<Node*> result = reader.nodes();
+        if (!reader.isValid || reader.pos != data.size()) return false;
+
+        nodes = result;
+        return true;
+    }
+
+    void save(const std::string& file, const std::string& content, std::vector<Node*>& nodes) {
+        if (Compiler::settings.noAstCache) return;
+
+        Writer writer;
+        writer.buffer += RAST_MAGIC;
+        writer.i32(RAST_FORMAT);
+        writer.str(file);
+        writer.str(content);
+        writer.nodes(nodes);
+        if (!writer.isValid) return;
+
+        std::error_code ec;
+        fs::create_directories(exePath + "std/.cache", ec);
+        if (ec) return;
+
+        // Concurrent compilers (-j) may write the same entry, so it is published by an atomic rename
+        std::string path = getPath(file, content);
+        std::string tmpPath = path + "." + std::to_string(getpid()) + ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open()) return;
+            stream.write(writer.buffer.data(), writer.buffer.size());
+            if (!stream.good()) {stream.close(); fs::remove(tmpPath, ec); return;}
+        }
+
+        fs::rename(tmpPath, path, ec);
+        if (ec) fs::remove(tmpPath, ec);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../include/parser/Arena.hpp"
+#include "../include/parser/nodes/Node.hpp"
+#include "../include/parser/Type.hpp"
+#include <cstdlib>
+#include <new>
+
+Arena* Arena::current = nullptr;
+
+// Precedes every object; the objects are walked by their sizes on release()
+struct alignas(16) ObjectHeader {
+    Arena* arena; // nullptr - allocated on the heap
+    uint32_t size;
+    Arena::Object object;
+};
+
+static size_t alignSize(size_t size) {return (size + 15) & ~(size_t)15;}
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize) {}
+
+Arena::~Arena() {
+    release();
+    for (Block& block : blocks) std::free(block.data);
+}
+
+void* Arena::allocate(size_t size, Object object) {
+    if (current != nullptr) return current->allocateHere(size, object);
+
+    ObjectHeader* header = (ObjectHeader*)std::malloc(sizeof(ObjectHeader) + size);
+    if (header == nullptr) throw std::bad_alloc();
+
+    header->arena = nullptr;
+    header->size = (uint32_t)size;
+    header->object = object;
+    return header + 1;
+}
+
+void Arena::deallocate(void* pointer) {
+    if (pointer == nullptr) return;
+
+    ObjectHeader* header = (ObjectHeader*)pointer - 1;
+    if (header->arena == nullptr) std::free(header);
+    else header->object = Dead; // The memory is given back by release()
+}
+
+Arena* Arena::owner(const void* pointer) {return ((const ObjectHeader*)pointer - 1)->arena;}
+
+void* Arena::allocateHere(size_t size, Object object) {
+    size_t needed = sizeof(ObjectHeader) + alignSize(size);
+
+    if (blocks.empty() || blocks.back().used + needed > blocks.back().size) {
+        size_t newSize = needed > blockSize ? needed : blockSize;
+        char* data = (char*)std::malloc(newSize);
+        if (data == nullptr) throw std::bad_alloc();
+        blocks.push_back(Block{data, newSize, 0});
+    }
+
+    Block& block = blocks.back();
+    ObjectHeader* header = (ObjectHeader*)(block.data + block.used);
+    block.used += needed;
+
+    header->arena = this;
+    header->size = (uint32_t)alignSize(size);
+    header->object = object;
+    return header + 1;
+}
+
+void Arena::release() {
+    for (Block& block : blocks) {
+        for (size_t offset = 0; offset < block.used;) {
+            ObjectHeader* header = (ObjectHeader*)(block.data + offset);
+            Object object = header->object;
+            header->object = Dead;
+
+            if (object == NodeObject) ((Node*)(header + 1))->~Node();
+            else if (object == TypeObject) ((Type*)(header + 1))->~Type();
+
+            offset += sizeof(ObjectHeader) + header->size;
+        }
+    }
+
+    // The first block is kept for the next unit
+    for (size_t i=1; i<blocks.size(); i++) std::free(blocks[i].data);
+    if (blocks.size() > 1) blocks.resize(1);
+    if (!blocks.empty()) blocks[0].used = 0;
+}
+
+size_t Arena::used() const {
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.used;
+    return total;
+}
@@ -0,0 +1,414 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../include/parser/Checks.hpp"
+#include "../include/parser/ast.hpp"
+#include "../include/parser/nodes/NodeFunc.hpp"
+#include "../include/debug.hpp"
+#include <llvm-c/DebugInfo.h>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Called by the stubs; defined in std/prelude.rave. Without it (-np) the stubs trap instead.
+static const char* failedHandler = "std::__nullCheckFailed";
+
+struct Check {
+    LLVMValueRef branch; // nullptr - the check was removed
+    LLVMValueRef pointer;
+    LLVMBasicBlockRef passed;
+    LLVMBasicBlockRef failed;
+    LLVMValueRef line;
+    std::vector<LLVMValueRef> entered; // Conditions of the loops the check was hoisted out of, the inner one first
+};
+
+struct CountedLoop {
+    LLVMValueRef entered;
+    LLVMValueRef preheaderBranch;
+    LLVMBasicBlockRef header;
+    LLVMBasicBlockRef body;
+    LLVMBasicBlockRef before; // Last block of the function before the body
+    std::unordered_set<LLVMBasicBlockRef> blocks;
+};
+
+struct FunctionChecks {
+    LLVMValueRef stub = nullptr;
+    std::vector<Check> checks;
+    std::vector<CountedLoop> active;
+    std::vector<CountedLoop> loops; // Inner loops go first
+};
+
+// Functions whose bodies are being generated; nested functions (lambdas, templates) are generated in the middle of others
+static std::unordered_map<LLVMValueRef, FunctionChecks> functions;
+
+bool Checks::enabled() {
+    if (generator->settings.noChecks) return false;
+
+    auto it = AST::funcTable.find(Symbol::lookup(currScope->funcName));
+    return it == AST::funcTable.end() || !it->second->isNoChecks;
+}
+
+// The name of a file is shared by all the stubs of the module; imported functions are generated with the file they come from
+static LLVMValueRef fileName(LLVMBuilderRef builder) {
+    std::string name = "checks.file." + generator->file;
+
+    LLVMValueRef global = LLVMGetNamedGlobal(generator->lModule, name.c_str());
+    if (global == nullptr) global = LLVMBuildGlobalString(builder, generator->file.c_str(), name.c_str());
+
+    return LLVMConstPointerCast(global, LLVMPointerType(LLVMInt8TypeInContext(generator->context), 0));
+}
+
+// void <function>.checkFailed(int line): cold and noreturn, so the checks stay out of the hot code
+static LLVMValueRef makeStub(LLVMValueRef function) {
+    LLVMTypeRef lineType = LLVMInt32TypeInContext(generator->context);
+    LLVMValueRef stub = LLVMAddFunction(generator->lModule, (std::string(LLVMGetValueName(function)) + ".checkFailed").c_str(),
+        LLVMFunctionType(LLVMVoidTypeInContext(generator->context), &lineType, 1, false));
+
+    LLVMSetLinkage(stub, LLVMPrivateLinkage);
+    for (const char* attr : {"cold", "noreturn", "noinline", "nounwind"}) generator->addAttr(attr, LLVMAttributeFunctionIndex, stub, -1);
+
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(generator->context);
+    LLVMPositionBuilderAtEnd(builder, LLVMAppendBasicBlockInContext(generator->context, stub, "entry"));
+
+    auto handlerIt = AST::funcTable.find(Symbol::lookup(failedHandler));
+    if (handlerIt != AST::funcTable.end()) {
+        if (generator->functions.find(handlerIt->first) == generator->functions.end()) handlerIt->second->generate();
+        LLVMValueRef handler = generator->functions[handlerIt->first].value;
+
+        LLVMValueRef args[3] = {fileName(builder), LLVMBuildGlobalStringPtr(builder, currScope->funcName.c_str(), "checks.function"), LLVMGetParam(stub, 0)};
+        LLVMBuildCall2(builder, LLVMGlobalGetValueType(handler), handler, args, 3, "");
+    }
+    else {
+        LLVMValueRef trap = LLVMGetNamedFunction(generator->lModule, "llvm.trap");
+        if (trap == nullptr) trap = LLVMAddFunction(generator->lModule, "llvm.trap", LLVMFunctionType(LLVMVoidTypeInContext(generator->context), nullptr, 0, false));
+        LLVMBuildCall2(builder, LLVMGlobalGetValueType(trap), trap, nullptr, 0, "");
+    }
+
+    LLVMBuildUnreachable(builder);
+
+    LLVMDisposeBuilder(builder);
+    return stub;
+}
+
+void Checks::nullPointer(RaveValue ptr, int loc) {
+    if (LLVMIsAConstant(ptr.value) || LLVMIsAAllocaInst(ptr.value) || LLVMGetTypeKind(LLVMTypeOf(ptr.value)) != LLVMPointerTypeKind) return;
+    if (!Checks::enabled()) return;
+
+    LLVMValueRef function = LLVMGetBasicBlockParent(LLVMGetInsertBlock(generator->builder));
+    FunctionChecks& checks = functions[function];
+    if (checks.stub == nullptr) checks.stub = makeStub(function);
+
+    RaveValue isNull = {LLVMBuildIsNull(generator->builder, ptr.value, "isNull"), basicTypes[BasicType::Bool]};
+    RaveValue condition = LLVM::expect(isNull, false, "unlikely");
+
+    LLVMBasicBlockRef failed = LLVM::makeBlock("checkFailed", function);
+    LLVMBasicBlockRef passed = LLVM::makeBlock("checked", function);
+
+    LLVMValueRef branch = LLVMBuildCondBr(generator->builder, condition.value, failed, passed);
+    debugInfo->setInstrLoc(loc);
+
+    LLVM::Builder::atEnd(failed);
+    LLVMValueRef line = LLVMConstInt(LLVMInt32TypeInContext(generator->context), loc, false);
+    LLVMBuildCall2(generator->builder, LLVMGlobalGetValueType(checks.stub), checks.stub, &line, 1, "");
+    debugInfo->setInstrLoc(loc);
+    LLVMBuildUnreachable(generator->builder);
+
+    LLVM::Builder::atEnd(passed);
+    checks.checks.push_back(Check{branch, ptr.value, passed, failed, line, {}});
+}
+
+void Checks::beginLoop(LLVMValueRef entered, LLVMValueRef preheaderBranch, LLVMBasicBlockRef header, LLVMBasicBlockRef body) {
+    LLVMValueRef function = LLVMGetBasicBlockParent(header);
+    functions[function].active.push_back(CountedLoop{entered, preheaderBranch, header, body, LLVMGetLastBasicBlock(function), {}});
+}
+
+void Checks::endLoop(LLVMBasicBlockRef header) {
+    FunctionChecks& checks = functions[LLVMGetBasicBlockParent(header)];
+    CountedLoop loop = checks.active.back();
+    checks.active.pop_back();
+
+    // The blocks of the body are appended after the ones that existed before it
+    loop.blocks = {loop.header, loop.body};
+    for (LLVMBasicBlockRef block = LLVMGetNextBasicBlock(loop.before); block != nullptr; block = LLVMGetNextBasicBlock(block)) loop.blocks.insert(block);
+
+    checks.loops.push_back(loop);
+}
+
+// A local variable whose address is only used to load and store it: nothing but these stores can change it
+static bool isLocal(LLVMValueRef address) {
+    if (!LLVMIsAAllocaInst(address)) return false;
+
+    for (LLVMUseRef use = LLVMGetFirstUse(address); use != nullptr; use = LLVMGetNextUse(use)) {
+        LLVMValueRef user = LLVMGetUser(use);
+        if (LLVMIsALoadInst(user)) continue;
+        if (LLVMIsAStoreInst(user) && LLVMGetOperand(user, 1) == address && LLVMGetOperand(user, 0) != address) continue;
+        return false;
+    }
+
+    return true;
+}
+
+// Variable the checked pointer was loaded from; nullptr if the pointer is not a load of a local variable
+static LLVMValueRef variableOf(LLVMValueRef pointer) {
+    if (!LLVMIsALoadInst(pointer) || LLVMGetVolatile(pointer)) return nullptr;
+
+    LLVMValueRef address = LLVMGetOperand(pointer, 0);
+    return isLocal(address) ? address : nullptr;
+}
+
+static LLVMBasicBlockRef singlePredecessor(LLVMBasicBlockRef block) {
+    LLVMBasicBlockRef predecessor = nullptr;
+
+    for (LLVMUseRef use = LLVMGetFirstUse(LLVMBasicBlockAsValue(block)); use != nullptr; use = LLVMGetNextUse(use)) {
+        LLVMValueRef user = LLVMGetUser(use);
+        if (!LLVMIsATerminatorInst(user)) return nullptr;
+
+        LLVMBasicBlockRef from = LLVMGetInstructionParent(user);
+        if (predecessor != nullptr && predecessor != from) return nullptr;
+        predecessor = from;
+    }
+
+    return predecessor;
+}
+
+// Looks for an identical check that every path to the check goes through.
+// Only the chain of single predecessors is walked, which is enough for the checks of one expression or of straight-line code.
+static bool isDominated(const Check& check, const std::unordered_map<LLVMValueRef, const Check*>& byBranch) {
+    LLVMValueRef variable = variableOf(check.pointer);
+    bool isLoaded = false; // The checked value was loaded after the earlier check
+
+    LLVMBasicBlockRef block = LLVMGetInstructionParent(check.branch);
+    LLVMValueRef instr = LLVMGetPreviousInstruction(check.branch);
+
+    for (int depth=0; depth<32; depth++) {
+        for (; instr != nullptr; instr = LLVMGetPreviousInstruction(instr)) {
+            if (instr == check.pointer) isLoaded = true;
+            else if (variable != nullptr && LLVMIsAStoreInst(instr) && LLVMGetOperand(instr, 1) == variable) return false;
+        }
+
+        LLVMBasicBlockRef predecessor = singlePredecessor(block);
+        if (predecessor == nullptr) return false;
+
+        auto earlier = byBranch.find(LLVMGetBasicBlockTerminator(predecessor));
+        if (earlier != byBranch.end() && earlier->second->passed == block) {
+            const Check& other = *earlier->second;
+            if (other.pointer == check.pointer) return true;
+
+            if (variable != nullptr && isLoaded && variableOf(other.pointer) == variable) {
+                // The earlier pointer must be loaded right before its check too
+                bool isSame = false;
+                for (LLVMValueRef prev = LLVMGetPreviousInstruction(other.branch); prev != nullptr; prev = LLVMGetPreviousInstruction(prev)) {
+                    if (prev == other.pointer) {isSame = true; break;}
+                    if (LLVMIsAStoreInst(prev) && LLVMGetOperand(prev, 1) == variable) break;
+                }
+                if (isSame) return true;
+            }
+        }
+
+        block = predecessor;
+        instr = LLVMGetLastInstruction(block);
+    }
+
+    return false;
+}
+
+// Erases llvm.expect, the and with the condition of a loop and the compare with null, once they are not used
+static void eraseCondition(LLVMValueRef value) {
+    if (!LLVMIsAInstruction(value) || LLVMGetFirstUse(value) != nullptr) return;
+
+    if (LLVMIsACallInst(value)) {
+        LLVMValueRef operand = LLVMGetOperand(value, 0);
+        LLVMInstructionEraseFromParent(value);
+        eraseCondition(operand);
+    }
+    else if (LLVMGetInstructionOpcode(value) == LLVMAnd) {
+        LLVMValueRef operand = LLVMGetOperand(value, 1);
+        LLVMInstructionEraseFromParent(value);
+        eraseCondition(operand);
+    }
+    else if (LLVMIsAICmpInst(value) && LLVMIsNull(LLVMGetOperand(value, 1))) LLVMInstructionEraseFromParent(value);
+}
+
+static void removeCheck(const Check& check) {
+    LLVMValueRef condition = LLVMGetCondition(check.branch);
+
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(generator->context);
+    LLVMPositionBuilderBefore(builder, check.branch);
+    LLVMValueRef branch = LLVMBuildBr(builder, check.passed);
+    LLVMInstructionSetDebugLoc(branch, LLVMInstructionGetDebugLoc(check.branch));
+    LLVMDisposeBuilder(builder);
+
+    LLVMInstructionEraseFromParent(check.branch);
+    LLVMDeleteBasicBlock(check.failed);
+    eraseCondition(condition);
+}
+
+static void removeDominated(std::vector<Check>& checks) {
+    std::unordered_map<LLVMValueRef, const Check*> byBranch;
+    for (const Check& check : checks) if (check.branch != nullptr) byBranch[check.branch] = &check;
+
+    for (Check& check : checks) {
+        if (check.branch == nullptr || !isDominated(check, byBranch)) continue;
+
+        byBranch.erase(check.branch);
+        removeCheck(check);
+        check.branch = nullptr;
+    }
+}
+
+// Pointer of the check that does not change in the loop: a value computed before it or a local variable that is not stored in it
+static bool isInvariant(const Check& check, const CountedLoop& loop, LLVMValueRef& variable) {
+    variable = nullptr;
+
+    if (LLVMIsAArgument(check.pointer)) return true;
+    if (LLVMIsAInstruction(check.pointer) && loop.blocks.count(LLVMGetInstructionParent(check.pointer)) == 0) return true;
+
+    variable = variableOf(check.pointer);
+    if (variable == nullptr) return false;
+
+    for (LLVMUseRef use = LLVMGetFirstUse(variable); use != nullptr; use = LLVMGetNextUse(use)) {
+        LLVMValueRef user = LLVMGetUser(use);
+        if (LLVMIsAStoreInst(user) && loop.blocks.count(LLVMGetInstructionParent(user)) != 0) return false;
+    }
+
+    return true;
+}
+
+// Instructions that can not stop the program or be seen outside of it before a failed check
+static bool isSilent(LLVMValueRef instr) {
+    switch (LLVMGetInstructionOpcode(instr)) {
+        case LLVMCall: {
+            LLVMValueRef callee = LLVMGetCalledValue(instr);
+            if (!LLVMIsAFunction(callee) || LLVMGetIntrinsicID(callee) == 0) return false;
+
+            // The traps do not return
+            std::string name = LLVMGetValueName(callee);
+            return name != "llvm.trap" && name != "llvm.debugtrap" && name != "llvm.ubsantrap";
+        }
+        case LLVMInvoke: case LLVMFence: case LLVMAtomicCmpXchg: case LLVMAtomicRMW: return false;
+        case LLVMLoad: case LLVMStore: return !LLVMGetVolatile(instr);
+        default: return true;
+    }
+}
+
+// The conditions of the inner loops are tested in the body of this one, so a check hoisted out of them stays there
+static bool isAvailable(const Check& check, const CountedLoop& loop) {
+    for (LLVMValueRef entered : check.entered) {
+        if (LLVMIsAInstruction(entered) && loop.blocks.count(LLVMGetInstructionParent(entered)) != 0) return false;
+    }
+
+    return true;
+}
+
+// Moves the check before the loop: it fails there if the loop (and the loops it was hoisted out of) is entered and the pointer is null
+static void hoist(FunctionChecks& checks, CountedLoop& loop, size_t index, LLVMValueRef variable) {
+    Check check = checks.checks[index];
+    LLVMBasicBlockRef preheader = LLVMGetInstructionParent(loop.preheaderBranch);
+    LLVMValueRef function = LLVMGetBasicBlockParent(preheader);
+    LLVMMetadataRef location = LLVMInstructionGetDebugLoc(check.branch);
+
+    LLVMBasicBlockRef passed = LLVMInsertBasicBlockInContext(generator->context, loop.header, "checked");
+    LLVMBasicBlockRef failed = LLVMAppendBasicBlockInContext(generator->context, function, "checkFailed");
+
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(generator->context);
+    LLVMPositionBuilderBefore(builder, loop.preheaderBranch);
+
+    LLVMValueRef pointer = (variable != nullptr) ? LLVMBuildLoad2(builder, LLVMTypeOf(check.pointer), variable, "hoisted") : check.pointer;
+    LLVMValueRef condition = LLVMBuildIsNull(builder, pointer, "isNull");
+    for (LLVMValueRef entered : check.entered) condition = LLVMBuildAnd(builder, entered, condition, "isEnteredNull");
+
+    LLVMValueRef expect = LLVMGetNamedFunction(generator->lModule, "llvm.expect.i1");
+    LLVMValueRef args[2] = {LLVMBuildAnd(builder, loop.entered, condition, "isEnteredNull"), LLVMConstInt(LLVMInt1TypeInContext(generator->context), 0, false)};
+    LLVMValueRef branch = LLVMBuildCondBr(builder, LLVMBuildCall2(builder, LLVMGlobalGetValueType(expect), expect, args, 2, "unlikely"), failed, passed);
+    LLVMInstructionSetDebugLoc(branch, location);
+    LLVMInstructionEraseFromParent(loop.preheaderBranch);
+
+    LLVMPositionBuilderAtEnd(builder, passed);
+    loop.preheaderBranch = LLVMBuildBr(builder, loop.header);
+
+    LLVMPositionBuilderAtEnd(builder, failed);
+    LLVMInstructionSetDebugLoc(LLVMBuildCall2(builder, LLVMGlobalGetValueType(checks.stub), checks.stub, &check.line, 1, ""), location);
+    LLVMBuildUnreachable(builder);
+    LLVMDisposeBuilder(builder);
+
+    removeCheck(check);
+    checks.checks[index].branch = nullptr;
+    check.entered.push_back(loop.entered);
+    checks.checks.push_back(Check{branch, pointer, passed, failed, check.line, check.entered});
+
+    for (CountedLoop& outer : checks.loops) {
+        if (outer.blocks.count(preheader) != 0) outer.blocks.insert(passed);
+    }
+}
+
+// Walks the body from its start while nothing can happen before the checks, and hoists them in the same order.
+// Then the body of a loop over an invariant pointer has no checks at all.
+static void hoistChecks(FunctionChecks& checks, CountedLoop& loop) {
+    std::unordered_map<LLVMValueRef, size_t> byBranch;
+    for (size_t i=0; i<checks.checks.size(); i++) if (checks.checks[i].branch != nullptr) byBranch[checks.checks[i].branch] = i;
+
+    LLVMBasicBlockRef block = loop.body;
+
+    while (block != nullptr && block != loop.header && loop.blocks.count(block) != 0) {
+        LLVMBasicBlockRef next = nullptr;
+
+        for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+            auto check = byBranch.find(instr);
+            if (check != byBranch.end()) {
+                LLVMValueRef variable;
+                if (!isAvailable(checks.checks[check->second], loop) || !isInvariant(checks.checks[check->second], loop, variable)) return;
+
+                next = checks.checks[check->second].passed;
+                hoist(checks, loop, check->second, variable);
+                break;
+            }
+
+            if (!isSilent(instr)) return;
+
+            if (LLVMIsATerminatorInst(instr)) {
+                if (LLVMIsConditional(instr) || LLVMGetNumSuccessors(instr) != 1) return;
+                next = LLVMGetSuccessor(instr, 0);
+            }
+        }
+
+        block = next;
+    }
+}
+
+// The condition tested before the loop is not needed if nothing was hoisted
+static void eraseUnused(LLVMValueRef value) {
+    if (!LLVMIsAInstruction(value) || LLVMGetFirstUse(value) != nullptr) return;
+    if (!LLVMIsAICmpInst(value) && !LLVMIsABinaryOperator(value) && !LLVMIsACastInst(value) && !LLVMIsAGetElementPtrInst(value) &&
+        !(LLVMIsALoadInst(value) && !LLVMGetVolatile(value))) return;
+
+    std::vector<LLVMValueRef> operands;
+    for (int i=0; i<LLVMGetNumOperands(value); i++) {
+        LLVMValueRef operand = LLVMGetOperand(value, i);
+        if (std::find(operands.begin(), operands.end(), operand) == operands.end()) operands.push_back(operand);
+    }
+
+    LLVMInstructionEraseFromParent(value);
+    for (LLVMValueRef operand : operands) eraseUnused(operand);
+}
+
+void Checks::finish(LLVMValueRef function) {
+    auto it = functions.find(function);
+    if (it == functions.end()) return;
+
+    FunctionChecks& checks = it->second;
+
+    if (checks.stub != nullptr) {
+        removeDominated(checks.checks);
+        for (CountedLoop& loop : checks.loops) hoistChecks(checks, loop);
+        removeDominated(checks.checks);
+
+        if (LLVMGetFirstUse(checks.stub) == nullptr) LLVMDeleteFunction(checks.stub);
+    }
+
+    for (CountedLoop& loop : checks.loops) eraseUnused(loop.entered);
+    functions.erase(it);
+}
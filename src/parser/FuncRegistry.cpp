@@ -8,12 +8,54 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../include/parser/TypeMatching.hpp"
 #include "../include/parser/nodes/NodeFunc.hpp"
 #include "../include/parser/TypeUtils.hpp"
+#include <algorithm>
 
 FuncRegistry& FuncRegistry::instance() {
     static FuncRegistry registry;
     return registry;
 }
 
+// Keys of the argument types; a call with an unknown type matches nothing
+static bool argumentsKey(const std::vector<Type*>& types, std::vector<uint32_t>& key) {
+    key.reserve(types.size());
+    for (Type* type : types) {
+        if (type == nullptr) return false;
+        key.push_back(Types::key(type).id);
+    }
+    return true;
+}
+
+// The keys do not tell a pointer from a byval, so the kinds are memoized with them
+static std::string memoKey(const std::vector<Type*>& types, const std::vector<uint32_t>& key) {
+    std::string result;
+    result.reserve(key.size() * (sizeof(uint32_t) + 1));
+    for (size_t i = 0; i < key.size(); i++) {
+        result.append((const char*)&key[i], sizeof(uint32_t));
+        result.push_back((char)Types::stripConst(types[i])->typeKind);
+    }
+    return result;
+}
+
+// Parameters of templates and of templated structs are replaced in place when they are generated
+static bool hasStableParameters(NodeFunc* func) {
+    if (!func->templateNames.empty() || func->isCtargs || func->name.find('<') != std::string::npos) return false;
+    for (const FuncArgSet& arg : func->args) if (arg.type == nullptr) return false;
+    return true;
+}
+
+void FuncRegistry::addOverload(OverloadSet& set, NodeFunc* func) {
+    Candidate candidate{func, hasStableParameters(func), {}};
+
+    if (candidate.isStable) {
+        for (const FuncArgSet& arg : func->args) candidate.key.push_back(Types::key(arg.type).id);
+    }
+    else set.isStable = false;
+
+    set.all.push_back(func);
+    set.byArity[func->args.size()].push_back(std::move(candidate));
+    set.resolved.clear();
+}
+
 void FuncRegistry::registerFunc(NodeFunc* func) {
     if (func == nullptr) return;
 
@@ -30,11 +72,12 @@ void FuncRegistry::registerFunc(NodeFunc* func) {
     }
 
     // Add to functions by name
-    auto& overloads = functionsByName[baseName];
-    overloads.push_back(func);
+    OverloadSet& overloads = functionsByName[Symbol(baseName)];
+    if (overloads.name.empty()) overloads.name = baseName;
+    addOverload(overloads, func);
 
     // Add to mangled name index for backward compatibility
-    mangledNameIndex[func->name] = func;
+    mangledNameIndex[Symbol(func->name)] = func;
 }
 
 void FuncRegistry::registerMethod(NodeFunc* func, const std::string& structName) {
@@ -43,12 +86,28 @@ void FuncRegistry::registerMethod(NodeFunc* func, const std::string& structName)
     const std::string& methodName = func->origName;
 
     // Add to methods by struct
-    auto& structMethods = methodsByStruct[structName];
-    auto& overloads = structMethods[methodName];
-    overloads.push_back(func);
+    StructMethods& structMethods = methodsByStruct[Symbol(structName)];
+    auto inserted = structMethods.byName.emplace(Symbol(methodName), OverloadSet());
+    OverloadSet& overloads = inserted.first->second;
+
+    if (inserted.second) {
+        overloads.name = methodName;
+
+        // "name[...]" and "name<...>" are also overloads of "name"
+        for (size_t i = 0; i < methodName.size(); i++) {
+            if (methodName[i] != '[' && methodName[i] != '<') continue;
+
+            std::vector<OverloadSet*>& sets = structMethods.byBaseName[Symbol(methodName.substr(0, i))];
+            sets.insert(std::upper_bound(sets.begin(), sets.end(), &overloads,
+                [](const OverloadSet* a, const OverloadSet* b) {return a->name < b->name;}), &overloads);
+        }
+    }
+
+    addOverload(overloads, func);
+    generation += 1;
 
     // Add to mangled name index
-    mangledNameIndex[func->name] = func;
+    mangledNameIndex[Symbol(func->name)] = func;
 }
 
 void FuncRegistry::registerOperator(NodeFunc* func, const std::string& structName, int opType) {
@@ -58,126 +117,133 @@ void FuncRegistry::registerOperator(NodeFunc* func, const std::string& structNam
     auto& structOps = operatorsByStruct[structName];
     auto& overloads = structOps[opType];
     overloads.push_back(func);
+    generation += 1;
 
     // Add to mangled name index
-    mangledNameIndex[func->name] = func;
+    mangledNameIndex[Symbol(func->name)] = func;
 }
 
-NodeFunc* FuncRegistry::findBySignature(const FuncSignature& sig) const {
-    if (sig.isMethod()) {
-        // Search for method
-        auto structIt = methodsByStruct.find(sig.structContext);
-        if (structIt != methodsByStruct.end()) {
-            auto methodIt = structIt->second.find(sig.baseName);
-            if (methodIt != structIt->second.end()) {
-                for (NodeFunc* func : methodIt->second) {
-                    if (func->args.size() == sig.paramTypes.size()) {
-                        bool match = true;
-                        for (size_t i = 0; i < sig.paramTypes.size(); i++) {
-                            if (!Types::typesEqual(func->args[i].type, sig.paramTypes[i])) {
-                                match = false;
-                                break;
-                            }
-                        }
-                        if (match) return func;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        // Search for free function
-        auto funcIt = functionsByName.find(sig.baseName);
-        if (funcIt != functionsByName.end()) {
-            for (NodeFunc* func : funcIt->second) {
-                if (func->args.size() == sig.paramTypes.size()) {
-                    bool match = true;
-                    for (size_t i = 0; i < sig.paramTypes.size(); i++) {
-                        if (func->args[i].type->toString() != sig.paramTypes[i]->toString()) {
-                            match = false;
-                            break;
-                        }
-                    }
-                    if (match) return func;
-                }
-            }
-        }
+const FuncRegistry::OverloadSet* FuncRegistry::findSet(const std::string& name, const std::string& structContext) const {
+    Symbol symbol = Symbol::lookup(name);
+    if (symbol.empty()) return nullptr;
+
+    if (structContext.empty()) {
+        auto funcIt = functionsByName.find(symbol);
+        return funcIt != functionsByName.end() ? &funcIt->second : nullptr;
     }
 
-    return nullptr;
+    auto structIt = methodsByStruct.find(Symbol::lookup(structContext));
+    if (structIt == methodsByStruct.end()) return nullptr;
+
+    auto methodIt = structIt->second.byName.find(symbol);
+    return methodIt != structIt->second.byName.end() ? &methodIt->second : nullptr;
 }
 
-NodeFunc* FuncRegistry::findBestMatch(const FuncSignature& sig) const {
-    NodeFunc* bestMatch = nullptr;
-    int bestScore = -1;
+void FuncRegistry::scoreOverloads(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key,
+                                  NodeFunc*& bestMatch, int& bestScore) {
+    auto arityIt = set.byArity.find(sig.paramTypes.size());
+    if (arityIt == set.byArity.end()) return;
 
-    if (sig.isMethod()) {
-        // Search for method
-        auto structIt = methodsByStruct.find(sig.structContext);
-        if (structIt != methodsByStruct.end()) {
-            // Try exact name match first
-            auto methodIt = structIt->second.find(sig.baseName);
-            if (methodIt != structIt->second.end()) {
-                for (NodeFunc* func : methodIt->second) {
-                    int score = TypeMatching::calculateMatchScore(func->args, sig.paramTypes, func->isExplicit);
-                    if (score > bestScore) {
-                        bestScore = score;
-                        bestMatch = func;
-                    }
-                }
-            }
+    // Score of the exact match, no overload can get more
+    const int exactScore = 10 * (int)key.size();
 
-            // If no match, try looking for overloaded methods
-            if (bestMatch == nullptr) {
-                for (const auto& [methodName, overloads] : structIt->second) {
-                    // Check if method name matches (without type suffix)
-                    if (methodName == sig.baseName ||
-                        methodName.find(sig.baseName + "[") == 0 ||
-                        methodName.find(sig.baseName + "<") == 0) {
-                        for (NodeFunc* func : overloads) {
-                            int score = TypeMatching::calculateMatchScore(func->args, sig.paramTypes, func->isExplicit);
-                            if (score > bestScore) {
-                                bestScore = score;
-                                bestMatch = func;
-                            }
-                        }
-                    }
-                }
-            }
+    for (const Candidate& candidate : arityIt->second) {
+        NodeFunc* func = candidate.func;
+        int score = (candidate.isStable && candidate.key == key) ? exactScore
+            : TypeMatching::calculateMatchScore(func->args, sig.paramTypes, func->isExplicit);
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMatch = func;
+            if (score == exactScore) return;
         }
     }
-    else {
-        // Search for free function
-        auto funcIt = functionsByName.find(sig.baseName);
-        if (funcIt != functionsByName.end()) {
-            for (NodeFunc* func : funcIt->second) {
-                int score = TypeMatching::calculateMatchScore(func->args, sig.paramTypes, func->isExplicit);
-                if (score > bestScore) {
-                    bestScore = score;
-                    bestMatch = func;
-                }
-            }
+}
+
+NodeFunc* FuncRegistry::resolve(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key) const {
+    std::string memo;
+
+    if (set.isStable) {
+        if (set.resolvedGeneration != generation) {
+            set.resolved.clear();
+            set.resolvedGeneration = generation;
         }
+
+        memo = memoKey(sig.paramTypes, key);
+        auto memoIt = set.resolved.find(memo);
+        if (memoIt != set.resolved.end()) return memoIt->second;
     }
 
+    NodeFunc* bestMatch = nullptr;
+    int bestScore = -1;
+    scoreOverloads(set, sig, key, bestMatch, bestScore);
+
+    if (set.isStable) set.resolved.emplace(std::move(memo), bestMatch);
     return bestMatch;
 }
 
-bool FuncRegistry::hasFunction(const FuncSignature& sig) const {
-    if (sig.isMethod()) {
-        auto structIt = methodsByStruct.find(sig.structContext);
-        if (structIt != methodsByStruct.end()) {
-            auto methodIt = structIt->second.find(sig.baseName);
-            if (methodIt != structIt->second.end()) {
-                return !methodIt->second.empty();
+NodeFunc* FuncRegistry::findExactIn(const OverloadSet& set, const FuncSignature& sig, const std::vector<uint32_t>& key) {
+    auto arityIt = set.byArity.find(sig.paramTypes.size());
+    if (arityIt == set.byArity.end()) return nullptr;
+
+    for (const Candidate& candidate : arityIt->second) {
+        if (candidate.isStable) {
+            if (candidate.key == key) return candidate.func;
+            continue;
+        }
+
+        NodeFunc* func = candidate.func;
+        if (func->args.size() != sig.paramTypes.size()) continue;
+
+        bool match = true;
+        for (size_t i = 0; i < sig.paramTypes.size(); i++) {
+            if (!Types::typesEqual(func->args[i].type, sig.paramTypes[i])) {
+                match = false;
+                break;
             }
         }
-        return false;
+        if (match) return func;
     }
-    else {
-        auto funcIt = functionsByName.find(sig.baseName);
-        return funcIt != functionsByName.end() && !funcIt->second.empty();
+
+    return nullptr;
+}
+
+NodeFunc* FuncRegistry::findBySignature(const FuncSignature& sig) const {
+    std::vector<uint32_t> key;
+    if (!argumentsKey(sig.paramTypes, key)) return nullptr;
+
+    const OverloadSet* overloads = findSet(sig.baseName, sig.structContext);
+    return overloads != nullptr ? findExactIn(*overloads, sig, key) : nullptr;
+}
+
+NodeFunc* FuncRegistry::findBestMatch(const FuncSignature& sig) const {
+    std::vector<uint32_t> key;
+    if (!argumentsKey(sig.paramTypes, key)) return nullptr;
+
+    // Try exact name match first
+    const OverloadSet* overloads = findSet(sig.baseName, sig.structContext);
+    if (overloads != nullptr) {
+        NodeFunc* bestMatch = resolve(*overloads, sig, key);
+        if (bestMatch != nullptr || !sig.isMethod()) return bestMatch;
     }
+    else if (!sig.isMethod()) return nullptr;
+
+    // If no match, try the overloaded methods (without type suffix)
+    auto structIt = methodsByStruct.find(Symbol::lookup(sig.structContext));
+    if (structIt == methodsByStruct.end()) return nullptr;
+
+    auto baseIt = structIt->second.byBaseName.find(Symbol::lookup(sig.baseName));
+    if (baseIt == structIt->second.byBaseName.end()) return nullptr;
+
+    NodeFunc* bestMatch = nullptr;
+    int bestScore = -1;
+    for (const OverloadSet* set : baseIt->second) scoreOverloads(*set, sig, key, bestMatch, bestScore);
+    return bestMatch;
+}
+
+bool FuncRegistry::hasFunction(const FuncSignature& sig) const {
+    const OverloadSet* overloads = findSet(sig.baseName, sig.structContext);
+    return overloads != nullptr && !overloads->all.empty();
 }
 
 NodeFunc* FuncRegistry::findOperator(int opType, const std::vector<Type*>& argTypes,
@@ -216,45 +282,33 @@ std::vector<NodeFunc*> FuncRegistry::findAllOverloads(const std::string& name,
                                                        const std::string& structContext) const {
     std::vector<NodeFunc*> result;
 
+    const OverloadSet* overloads = findSet(name, structContext);
+    if (overloads != nullptr) result = overloads->all;
+
     if (!structContext.empty()) {
-        auto structIt = methodsByStruct.find(structContext);
+        auto structIt = methodsByStruct.find(Symbol::lookup(structContext));
         if (structIt != methodsByStruct.end()) {
-            for (const auto& [methodName, overloads] : structIt->second) {
-                if (methodName == name || methodName.find(name + "[") == 0 || methodName.find(name + "<") == 0) {
-                    result.insert(result.end(), overloads.begin(), overloads.end());
-                }
+            auto baseIt = structIt->second.byBaseName.find(Symbol::lookup(name));
+            if (baseIt != structIt->second.byBaseName.end()) {
+                for (const OverloadSet* set : baseIt->second) result.insert(result.end(), set->all.begin(), set->all.end());
             }
         }
     }
-    else {
-        auto funcIt = functionsByName.find(name);
-        if (funcIt != functionsByName.end()) {
-            result = funcIt->second;
-        }
-    }
 
     return result;
 }
 
 bool FuncRegistry::hasBaseName(const std::string& name, const std::string& structContext) const {
-    if (!structContext.empty()) {
-        auto structIt = methodsByStruct.find(structContext);
-        if (structIt != methodsByStruct.end()) {
-            for (const auto& [methodName, overloads] : structIt->second) {
-                if (methodName == name || methodName.find(name + "[") == 0 || methodName.find(name + "<") == 0) {
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-    else {
-        return functionsByName.find(name) != functionsByName.end();
-    }
+    if (findSet(name, structContext) != nullptr) return true;
+    if (structContext.empty()) return false;
+
+    auto structIt = methodsByStruct.find(Symbol::lookup(structContext));
+    return structIt != methodsByStruct.end() &&
+        structIt->second.byBaseName.find(Symbol::lookup(name)) != structIt->second.byBaseName.end();
 }
 
 NodeFunc* FuncRegistry::getByMangledName(const std::string& mangledName) const {
-    auto it = mangledNameIndex.find(mangledName);
+    auto it = mangledNameIndex.find(Symbol::lookup(mangledName));
     return it != mangledNameIndex.end() ? it->second : nullptr;
 }
 
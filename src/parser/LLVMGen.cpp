@@ -12,12 +12,15 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../include/parser/nodes/NodeStruct.hpp"
 #include "../include/parser/nodes/NodeInt.hpp"
 #include "../include/parser/nodes/NodeRet.hpp"
+#include "../include/parser/nodes/NodeVar.hpp"
 #include "../include/compiler.hpp"
 #include "../include/debug.hpp"
 #include <iostream>
 
 LLVMGen::~LLVMGen() {
     if (debugInfo != nullptr) delete debugInfo;
+    LLVMDisposeModule(lModule);
+    LLVMContextDispose(context);
 }
 
 LLVMGen::LLVMGen(std::string file, genSettings settings, nlohmann::json options) {
@@ -36,7 +39,7 @@ LLVMGen::LLVMGen(std::string file, genSettings settings, nlohmann::json options)
     if (Compiler::features.find("+sse2") != std::string::npos &&
         Compiler::features.find("+ssse3") != std::string::npos) {
 
-        functions["llvm.x86.ssse3.phadd.d.128"] = {LLVMAddFunction(lModule, "llvm.x86.ssse3.phadd.d.128",
+        functions[Symbol("llvm.x86.ssse3.phadd.d.128")] = {LLVMAddFunction(lModule, "llvm.x86.ssse3.phadd.d.128",
             LLVMFunctionType(LLVMVectorType(LLVMInt32TypeInContext(context), 4),
                 std::vector<LLVMTypeRef>({LLVMVectorType(LLVMInt32TypeInContext(context), 4),
                     LLVMVectorType(LLVMInt32TypeInContext(context), 4)}).data(), 2, false)),
@@ -44,7 +47,7 @@ LLVMGen::LLVMGen(std::string file, genSettings settings, nlohmann::json options)
                 {new TypeFuncArg(new TypeVector(basicTypes[BasicType::Int], 4), "v1"),
                  new TypeFuncArg(new TypeVector(basicTypes[BasicType::Int], 4), "v2")}, false)};
 
-        functions["llvm.x86.ssse3.phadd.sw.128"] = {LLVMAddFunction(lModule, "llvm.x86.ssse3.phadd.sw.128",
+        functions[Symbol("llvm.x86.ssse3.phadd.sw.128")] = {LLVMAddFunction(lModule, "llvm.x86.ssse3.phadd.sw.128",
             LLVMFunctionType(LLVMVectorType(LLVMInt16TypeInContext(context), 8),
                 std::vector<LLVMTypeRef>({LLVMVectorType(LLVMInt16TypeInContext(context), 8),
                     LLVMVectorType(LLVMInt16TypeInContext(context), 8)}).data(), 2, false)),
@@ -55,7 +58,7 @@ LLVMGen::LLVMGen(std::string file, genSettings settings, nlohmann::json options)
 
     // Add SSE3 internal functions
     if (Compiler::features.find("+sse3") != std::string::npos) {
-        functions["llvm.x86.sse3.hadd.ps"] = {LLVMAddFunction(lModule, "llvm.x86.sse3.hadd.ps",
+        functions[Symbol("llvm.x86.sse3.hadd.ps")] = {LLVMAddFunction(lModule, "llvm.x86.sse3.hadd.ps",
             LLVMFunctionType(LLVMVectorType(LLVMFloatTypeInContext(context), 4),
                 std::vector<LLVMTypeRef>({LLVMVectorType(LLVMFloatTypeInContext(context), 4),
                     LLVMVectorType(LLVMFloatTypeInContext(context), 4)}).data(), 2, false)),
@@ -78,6 +81,35 @@ void LLVMGen::warning(std::string msg, int line) {
         lineStr + "\033[22m: " + msg + "\033[0;0m" << std::endl;
 }
 
+void LLVMGen::remark(std::string msg, std::string file, int line) {
+    std::string lineStr = (line == -1) ? "unknown line" : std::to_string(line);
+    std::cout << "\033[0;36mRemark in \033[1m" + file + "\033[22m file at \033[1m" +
+        lineStr + "\033[22m: " + msg + "\033[0;0m" << std::endl;
+}
+
+std::unordered_map<Symbol, RaveValue>::iterator LLVMGen::findGlobal(Symbol name) {
+    auto it = globals.find(name);
+    if (it != globals.end() || lazyGlobals.empty()) return it;
+
+    auto lazyIt = lazyGlobals.find(name);
+    if (lazyIt == lazyGlobals.end()) return it;
+
+    NodeVar* variable = lazyIt->second;
+    lazyGlobals.erase(lazyIt);
+
+    // Declared as if at the import: outside of the current function and template
+    Scope* oldScope = currScope;
+    auto oldReplace = std::move(toReplace);
+    currScope = nullptr;
+    toReplace.clear();
+
+    variable->generate();
+
+    currScope = oldScope;
+    toReplace = std::move(oldReplace);
+    return globals.find(name);
+}
+
 std::string LLVMGen::mangle(std::string name, bool isFunc, bool isMethod) {
     if (isFunc) {
         if (isMethod) return "_RaveM" + std::to_string(name.size()) + name;
@@ -90,7 +122,7 @@ std::string LLVMGen::mangle(std::string name, bool isFunc, bool isMethod) {
 Type* getTrueStructType(TypeStruct* ts) {
     Type* t = ts->copy();
     while (true) {
-        auto it = generator->toReplace.find(t->toString());
+        auto it = generator->toReplace.find(Types::key(t));
         if (it == generator->toReplace.end()) break;
         t = it->second;
     }
@@ -167,7 +199,7 @@ Type* LLVMGen::resolveTemplateType(TypeStruct* s) {
                    instanceof<TypeArray>(ty) || instanceof<TypePointer>(ty))
                 ty = ty->getElType();
 
-            auto it = toReplace.find(ty->toString());
+            auto it = toReplace.find(Types::key(ty));
             if (it != toReplace.end()) sCopy->types[i] = it->second;
         }
         sCopy->updateByTypes();
@@ -178,29 +210,29 @@ Type* LLVMGen::resolveTemplateType(TypeStruct* s) {
 LLVMTypeRef LLVMGen::genStructType(TypeStruct* s, int loc) {
     DEBUG_LOG(Debug::Category::TypeGen, "Generating struct type: " + s->name);
 
-    auto cacheIt = structures.find(s->name);
+    auto cacheIt = structures.find(Symbol::lookup(s->name));
     if (cacheIt != structures.end()) return cacheIt->second;
 
-    auto replaceIt = toReplace.find(s->name);
+    auto replaceIt = toReplace.find(Symbol::lookup(s->name));
     if (replaceIt != toReplace.end()) return genType(replaceIt->second, loc);
 
     if (s->name.find('<') != std::string::npos) {
         TypeStruct* resolvedStruct = (TypeStruct*)resolveTemplateType(s);
 
-        cacheIt = structures.find(resolvedStruct->name);
+        cacheIt = structures.find(Symbol::lookup(resolvedStruct->name));
         if (cacheIt != structures.end()) return cacheIt->second;
 
         size_t templateStart = resolvedStruct->name.find('<');
         std::string origStruct = resolvedStruct->name.substr(0, templateStart);
 
-        auto structIt = AST::structTable.find(origStruct);
+        auto structIt = AST::structTable.find(Symbol::lookup(origStruct));
         if (structIt != AST::structTable.end()) {
             return structIt->second->genWithTemplate(
                 resolvedStruct->name.substr(templateStart), resolvedStruct->types);
         }
     }
 
-    auto structIt = AST::structTable.find(s->name);
+    auto structIt = AST::structTable.find(Symbol::lookup(s->name));
     if (structIt != AST::structTable.end()) {
         structIt->second->check();
         structIt->second->generate();
@@ -230,8 +262,8 @@ LLVMTypeRef LLVMGen::genType(Type* type, int loc) {
     if (!type) return LLVMPointerType(LLVMInt8TypeInContext(context), 0);
 
     // Check cache first
-    std::string typeStr = type->toString();
-    auto cacheIt = typeCache.find(typeStr);
+    Symbol typeKey = Types::key(type);
+    auto cacheIt = typeCache.find(typeKey);
     if (cacheIt != typeCache.end()) return cacheIt->second;
 
     LLVMTypeRef result = nullptr;
@@ -255,7 +287,7 @@ LLVMTypeRef LLVMGen::genType(Type* type, int loc) {
     else if (instanceof<TypeLLVM>(type)) result = ((TypeLLVM*)type)->tr;
     else { error("undefined type!", loc); return nullptr; }
 
-    if (result) typeCache[typeStr] = result;
+    if (result) typeCache[typeKey] = result;
     return result;
 }
 
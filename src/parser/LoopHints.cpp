@@ -0,0 +1,204 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../include/parser/LoopHints.hpp"
+#include "../include/parser/ast.hpp"
+#include "../include/parser/nodes/NodeInt.hpp"
+#include "../include/parser/nodes/NodeArray.hpp"
+#include "../include/parser/nodes/NodeString.hpp"
+#include "../include/llvm.hpp"
+#include <llvm-c/DebugInfo.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+// Marks the loop with its file and line, so the report can find it (and its copies) in the optimized module; only added with -remarks
+static const char* lineProperty = "rave.loop.line";
+static const char* fileProperty = "rave.loop.file";
+
+// Left by the vectorizer instead of its hints (vectorize and interleave), whatever width and interleave count it chose
+static const char* vectorizedProperty = "llvm.loop.isvectorized";
+
+struct HintedLoop {
+    std::string file;
+    int loc;
+    std::vector<std::pair<std::string, std::string>> hints; // Modifier as written and the property that is dropped once the hint is applied
+};
+
+// Hinted loops of the unit, kept only for -remarks
+static std::vector<HintedLoop> hinted;
+
+// The pre-link half of -flto does not vectorize nor unroll, so there is nothing to report about
+static bool isReported() {return generator->settings.remarks && !generator->settings.lto;}
+
+static LLVMMetadataRef property(const char* name, LLVMValueRef value = nullptr) {
+    LLVMMetadataRef operands[2] = {LLVMMDStringInContext2(generator->context, name, std::strlen(name)), value != nullptr ? LLVMValueAsMetadata(value) : nullptr};
+    return LLVMMDNodeInContext2(generator->context, operands, value != nullptr ? 2 : 1);
+}
+
+void LoopHints::attach(std::vector<DeclarMod>& mods, LLVMBasicBlockRef header, LLVMValueRef preheaderBranch, int loc) {
+    if (mods.empty()) return;
+
+    HintedLoop loop = {generator->file, loc, {}};
+    std::vector<LLVMMetadataRef> properties = {nullptr}; // The first operand of a loop ID is the ID itself
+
+    for (size_t i=0; i<mods.size(); i++) {
+        while (AST::aliasTable.find(Symbol::lookup(mods[i].name)) != AST::aliasTable.end()) {
+            if (instanceof<NodeArray>(AST::aliasTable[Symbol(mods[i].name)])) {
+                NodeArray* array = (NodeArray*)AST::aliasTable[Symbol(mods[i].name)];
+                mods[i].name = ((NodeString*)array->values[0])->value;
+                mods[i].value = array->values[1];
+            }
+            else mods[i].name = ((NodeString*)AST::aliasTable[Symbol(mods[i].name)])->value;
+        }
+
+        // 0 - the modifier has no value
+        int value = 0;
+
+        if (mods[i].value != nullptr) {
+            Node* constant = mods[i].value->comptime();
+            if (!instanceof<NodeInt>(constant) || ((NodeInt*)constant)->value.to_int() < 1) generator->error("value of \033[1m" + mods[i].name + "\033[22m must be a positive integer!", loc);
+            value = ((NodeInt*)constant)->value.to_int();
+        }
+
+        std::string written = value > 0 ? mods[i].name + ": " + std::to_string(value) : mods[i].name;
+
+        // A value of 1 disables the transformation, which is not reported
+        if (mods[i].name == "unroll") {
+            if (value == 1) properties.push_back(property("llvm.loop.unroll.disable"));
+            else if (value > 1) {
+                properties.push_back(property("llvm.loop.unroll.count", LLVM::makeInt(32, value, false)));
+                loop.hints.push_back({written, "llvm.loop.unroll.count"});
+            }
+            else {
+                properties.push_back(property("llvm.loop.unroll.enable"));
+                loop.hints.push_back({written, "llvm.loop.unroll.enable"});
+            }
+        }
+        else if (mods[i].name == "vectorize") {
+            if (value != 0) properties.push_back(property("llvm.loop.vectorize.width", LLVM::makeInt(32, value, false)));
+            if (value != 1) {
+                properties.push_back(property("llvm.loop.vectorize.enable", LLVM::makeInt(1, 1, false)));
+                loop.hints.push_back({written, "llvm.loop.vectorize.enable"});
+            }
+        }
+        else if (mods[i].name == "interleave") {
+            if (value == 0) generator->error("\033[1minterleave\033[22m requires the number of interleaved iterations!", loc);
+            properties.push_back(property("llvm.loop.interleave.count", LLVM::makeInt(32, value, false)));
+            if (value > 1) loop.hints.push_back({written, "llvm.loop.interleave.count"});
+        }
+        else if (mods[i].name == "distribute") {
+            properties.push_back(property("llvm.loop.distribute.enable", LLVM::makeInt(1, 1, false)));
+
+            // Without a followup the distributed loops keep the hint, and the optimizer warns that it was not applied
+            properties.push_back(property("llvm.loop.distribute.followup_all"));
+            loop.hints.push_back({written, "llvm.loop.distribute.enable"});
+        }
+        else generator->error("unknown loop modifier \033[1m" + mods[i].name + "\033[22m!", loc);
+    }
+
+    if (isReported()) {
+        properties.push_back(property(lineProperty, LLVM::makeInt(32, loc, false)));
+
+        LLVMMetadataRef file[2] = {LLVMMDStringInContext2(generator->context, fileProperty, std::strlen(fileProperty)),
+            LLVMMDStringInContext2(generator->context, generator->file.c_str(), generator->file.size())};
+        properties.push_back(LLVMMDNodeInContext2(generator->context, file, 2));
+    }
+
+    // The loop ID refers to itself, which also keeps the IDs of loops with the same hints distinct
+    LLVMMetadataRef temporary = LLVMTemporaryMDNode(generator->context, nullptr, 0);
+    properties[0] = temporary;
+    LLVMMetadataRef loopID = LLVMMDNodeInContext2(generator->context, properties.data(), properties.size());
+    LLVMMetadataReplaceAllUsesWith(temporary, loopID);
+
+    unsigned kind = LLVMGetMDKindIDInContext(generator->context, "llvm.loop", 9);
+    LLVMValueRef loopValue = LLVMMetadataAsValue(generator->context, loopID);
+    bool isAttached = false;
+
+    // The latch and the branches of "continue"
+    for (LLVMUseRef use = LLVMGetFirstUse(LLVMBasicBlockAsValue(header)); use != nullptr; use = LLVMGetNextUse(use)) {
+        LLVMValueRef branch = LLVMGetUser(use);
+        if (branch == preheaderBranch || LLVMIsATerminatorInst(branch) == nullptr) continue;
+
+        LLVMSetMetadata(branch, kind, loopValue);
+        isAttached = true;
+    }
+
+    if (isAttached && !loop.hints.empty() && isReported()) hinted.push_back(loop);
+}
+
+static std::vector<LLVMValueRef> operands(LLVMValueRef node) {
+    std::vector<LLVMValueRef> values(LLVMGetMDNodeNumOperands(node));
+    LLVMGetMDNodeOperands(node, values.data());
+    return values;
+}
+
+void LoopHints::report(LLVMModuleRef module) {
+    if (!isReported() || hinted.empty()) return;
+
+    // Properties of the loops left in the optimized module by their files and lines; a vectorized or distributed loop leaves several loops
+    std::map<std::pair<std::string, int>, std::vector<std::vector<std::string>>> loops;
+    unsigned kind = LLVMGetMDKindIDInContext(generator->context, "llvm.loop", 9);
+
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != nullptr; function = LLVMGetNextFunction(function)) {
+        for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(function); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+            LLVMValueRef loopID = LLVMGetMetadata(LLVMGetBasicBlockTerminator(block), kind);
+            if (loopID == nullptr) continue;
+
+            int line = -1;
+            std::string file = "";
+            std::vector<std::string> names;
+
+            for (LLVMValueRef property : operands(loopID)) {
+                if (LLVMIsAMDNode(property) == nullptr || property == loopID) continue;
+
+                std::vector<LLVMValueRef> values = operands(property);
+                unsigned length = 0;
+                const char* name = values.empty() ? nullptr : LLVMGetMDString(values[0], &length);
+                if (name == nullptr) continue;
+
+                if (std::string(name, length) == lineProperty && values.size() == 2) line = (int)LLVMConstIntGetSExtValue(values[1]);
+                else if (std::string(name, length) == fileProperty && values.size() == 2) {
+                    const char* value = LLVMGetMDString(values[1], &length);
+                    if (value != nullptr) file = std::string(value, length);
+                }
+                else names.push_back(std::string(name, length));
+            }
+
+            if (line != -1) loops[{file, line}].push_back(names);
+        }
+    }
+
+    for (HintedLoop& loop : hinted) {
+        auto it = loops.find({loop.file, loop.loc});
+
+        if (it == loops.end()) {
+            generator->remark("the loop was fully unrolled or removed by the optimizer", loop.file, loop.loc);
+            continue;
+        }
+
+        for (auto& hint : loop.hints) {
+            bool isHonored = true, isVectorized = false;
+
+            for (auto& names : it->second) {
+                if (std::find(names.begin(), names.end(), hint.second) != names.end()) isHonored = false;
+                if (std::find(names.begin(), names.end(), vectorizedProperty) != names.end()) isVectorized = true;
+            }
+
+            // The interleave count chosen by the vectorizer is not kept, so only the interleaving of a vectorized loop is reported
+            bool isInterleave = hint.second == "llvm.loop.interleave.count";
+            if (isInterleave) isHonored = isHonored && isVectorized;
+
+            if (isHonored && isInterleave) generator->remark("loop modifier \033[1m" + hint.first + "\033[22m was passed to the vectorizer (the interleave count it chose is not checked)", loop.file, loop.loc);
+            else if (isHonored) generator->remark("loop modifier \033[1m" + hint.first + "\033[22m was honored", loop.file, loop.loc);
+            else generator->remark("loop modifier \033[1m" + hint.first + "\033[22m was not honored" + (generator->settings.optLevel == 0 ? " (optimizations are disabled)" : ""), loop.file, loop.loc);
+        }
+    }
+
+    hinted.clear();
+}
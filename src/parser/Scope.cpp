@@ -14,18 +14,18 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../include/parser/nodes/NodeFunc.hpp"
 #include "../include/debug.hpp"
 
-Scope::Scope(std::string funcName, std::unordered_map<std::string, int> args, std::unordered_map<std::string, NodeVar*> argVars) {
+Scope::Scope(std::string funcName, std::unordered_map<Symbol, int> args, std::unordered_map<Symbol, NodeVar*> argVars) {
     DEBUG_LOG(Debug::Category::Scope, "Scope: Creating scope for function " + funcName);
 
     this->funcName = funcName;
-    this->args = std::unordered_map<std::string, int>(args);
-    this->argVars = std::unordered_map<std::string, NodeVar*>(argVars);
-    this->aliasTable = std::unordered_map<std::string, Node*>();
-    this->localScope = std::unordered_map<std::string, RaveValue>();
-    this->localVars = std::unordered_map<std::string, NodeVar*>();
+    this->args = std::unordered_map<Symbol, int>(args);
+    this->argVars = std::unordered_map<Symbol, NodeVar*>(argVars);
+    this->aliasTable = std::unordered_map<Symbol, Node*>();
+    this->localScope = std::unordered_map<Symbol, RaveValue>();
+    this->localVars = std::unordered_map<Symbol, NodeVar*>();
 }
 
-void Scope::remove(std::string name) {
+void Scope::remove(Symbol name) {
     DEBUG_LOG(Debug::Category::Scope, "Scope: Removing variable " + name);
 
     if (this->localScope.find(name) != this->localScope.end()) {
@@ -37,11 +37,11 @@ void Scope::remove(std::string name) {
 }
 
 TypeStruct* Scope::getThisStructType(int loc) {
-    if (!this->has("this")) return nullptr;
-    if (AST::funcTable.find(this->funcName) == AST::funcTable.end()) return nullptr;
-    if (!AST::funcTable[this->funcName]->isMethod) return nullptr;
+    if (!this->has(Symbol::lookup("this"))) return nullptr;
+    if (AST::funcTable.find(Symbol::lookup(this->funcName)) == AST::funcTable.end()) return nullptr;
+    if (!AST::funcTable[Symbol(this->funcName)]->isMethod) return nullptr;
 
-    NodeVar* nv = this->getVar("this", loc);
+    NodeVar* nv = this->getVar(Symbol("this"), loc);
     if (nv == nullptr) return nullptr;
 
     Type* t = nv->type;
@@ -52,32 +52,33 @@ TypeStruct* Scope::getThisStructType(int loc) {
     return nullptr;
 }
 
-RaveValue Scope::get(std::string name, int loc) {
+RaveValue Scope::get(Symbol name, int loc) {
     DEBUG_LOG(Debug::Category::Scope, "Scope::get: Looking up " + name + " in function " + funcName);
 
     RaveValue value = {nullptr, nullptr};
 
     // Check various scopes in order of priority
     auto itNode = AST::aliasTable.find(name);
+    auto itReplace = generator->toReplaceValues.find(name);
     if (itNode != AST::aliasTable.end())
         value = itNode->second->generate();
-    else if ((itNode = generator->toReplaceValues.find(name)) != generator->toReplaceValues.end())
-        value = itNode->second->generate();
+    else if (itReplace != generator->toReplaceValues.end())
+        value = itReplace->second->generate();
     else if ((itNode = this->aliasTable.find(name)) != this->aliasTable.end())
         value = itNode->second->generate();
     else {
         auto itVal = localScope.find(name);
         if (itVal != localScope.end())
             value = itVal->second;
-        else if ((itVal = generator->globals.find(name)) != generator->globals.end())
+        else if ((itVal = generator->findGlobal(name)) != generator->globals.end())
             value = itVal->second;
-        else if (generator->functions.find(this->funcName) != generator->functions.end()) {
+        else if (generator->functions.find(Symbol::lookup(this->funcName)) != generator->functions.end()) {
             if (this->args.find(name) == this->args.end()) {
                 if (generator->functions.find(name) != generator->functions.end())
                     generator->error(name, loc);
             }
-            else return {LLVMGetParam(generator->functions[this->funcName].value, this->args[name]),
-                AST::funcTable[this->funcName]->getArgType(name)};
+            else return {LLVMGetParam(generator->functions[Symbol(this->funcName)].value, this->args[name]),
+                AST::funcTable[Symbol(this->funcName)]->getArgType(name)};
         }
     }
 
@@ -102,13 +103,15 @@ RaveValue Scope::get(std::string name, int loc) {
     return value;
 }
 
-RaveValue Scope::getWithoutLoad(std::string name, int loc) {
+RaveValue Scope::getWithoutLoad(Symbol name, int loc) {
     DEBUG_LOG(Debug::Category::Scope, "Scope::getWithoutLoad: Looking up " + name);
 
-    auto itNode = generator->toReplaceValues.find(name);
-    if (itNode != generator->toReplaceValues.end())
-        return itNode->second->generate();
-    if ((itNode = AST::aliasTable.find(name)) != AST::aliasTable.end())
+    auto itReplace = generator->toReplaceValues.find(name);
+    if (itReplace != generator->toReplaceValues.end())
+        return itReplace->second->generate();
+
+    auto itNode = AST::aliasTable.find(name);
+    if (itNode != AST::aliasTable.end())
         return itNode->second->generate();
     if ((itNode = this->aliasTable.find(name)) != this->aliasTable.end())
         return itNode->second->generate();
@@ -116,7 +119,7 @@ RaveValue Scope::getWithoutLoad(std::string name, int loc) {
     auto itVal = this->localScope.find(name);
     if (itVal != this->localScope.end())
         return itVal->second;
-    if ((itVal = generator->globals.find(name)) != generator->globals.end())
+    if ((itVal = generator->findGlobal(name)) != generator->globals.end())
         return itVal->second;
     if (hasAtThis(name)) {
         TypeStruct* ts = getThisStructType(loc);
@@ -127,34 +130,34 @@ RaveValue Scope::getWithoutLoad(std::string name, int loc) {
     }
     if (this->args.find(name) == this->args.end())
         generator->error("undefined identifier \033[1m" + name + "\033[22m at function \033[1m" + this->funcName + "\033[22m!", loc);
-    return {LLVMGetParam(generator->functions[this->funcName].value, this->args[name]),
-        AST::funcTable[this->funcName]->getArgType(name)};
+    return {LLVMGetParam(generator->functions[Symbol(this->funcName)].value, this->args[name]),
+        AST::funcTable[Symbol(this->funcName)]->getArgType(name)};
 }
 
-bool Scope::has(std::string name) {
+bool Scope::has(Symbol name) {
     return AST::aliasTable.find(name) != AST::aliasTable.end() ||
         this->aliasTable.find(name) != this->aliasTable.end() ||
         this->localScope.find(name) != this->localScope.end() ||
-        generator->globals.find(name) != generator->globals.end() ||
+        generator->findGlobal(name) != generator->globals.end() ||
         this->args.find(name) != this->args.end();
 }
 
-bool Scope::hasAtThis(std::string name) {
+bool Scope::hasAtThis(Symbol name) {
     TypeStruct* ts = getThisStructType(-1);
     if (ts == nullptr) return false;
-    return AST::structTable.find(ts->toString()) != AST::structTable.end() &&
-           AST::structMembersTable.find({ts->toString(), name}) != AST::structMembersTable.end();
+    return AST::structTable.find(Symbol::lookup(ts->toString())) != AST::structTable.end() &&
+           AST::structMembersTable.find({Symbol::lookup(ts->toString()), name}) != AST::structMembersTable.end();
 }
 
-bool Scope::locatedAtThis(std::string name) {
+bool Scope::locatedAtThis(Symbol name) {
     if (AST::aliasTable.find(name) != AST::aliasTable.end()) return false;
     if (this->aliasTable.find(name) != this->aliasTable.end()) return false;
     if (this->localScope.find(name) != this->localScope.end()) return false;
-    if (generator->globals.find(name) != generator->globals.end()) return false;
+    if (generator->findGlobal(name) != generator->globals.end()) return false;
     return this->hasAtThis(name);
 }
 
-NodeVar* Scope::getVar(std::string name, int loc) {
+NodeVar* Scope::getVar(Symbol name, int loc) {
     DEBUG_LOG(Debug::Category::Scope, "Scope::getVar: Looking up variable " + name);
 
     auto it = this->localVars.find(name);
@@ -175,16 +178,16 @@ NodeVar* Scope::getVar(std::string name, int loc) {
 
     // Check if it's a member of "this" struct
     TypeStruct* ts = getThisStructType(loc);
-    if (ts != nullptr && AST::structTable.find(ts->toString()) != AST::structTable.end() &&
-        AST::structMembersTable.find({ts->toString(), name}) != AST::structMembersTable.end()) {
-        return AST::structMembersTable[{ts->toString(), name}].var;
+    if (ts != nullptr && AST::structTable.find(Symbol::lookup(ts->toString())) != AST::structTable.end() &&
+        AST::structMembersTable.find({Symbol::lookup(ts->toString()), name}) != AST::structMembersTable.end()) {
+        return AST::structMembersTable[{Symbol(ts->toString()), name}].var;
     }
 
     generator->error("undefined variable \033[1m" + name + "\033[22m!", loc);
     return nullptr;
 }
 
-void Scope::hasChanged(std::string name) {
+void Scope::hasChanged(Symbol name) {
     auto it = this->localVars.find(name);
     if (it != this->localVars.end())
         ((NodeVar*)it->second)->isChanged = true;
@@ -0,0 +1,48 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../include/parser/Symbol.hpp"
+#include <unordered_map>
+#include <vector>
+
+// The keys of an unordered_map never move, so the names can point to them
+static std::unordered_map<std::string, uint32_t>& symbolIds() {
+    static std::unordered_map<std::string, uint32_t> ids = {{"", 0}};
+    return ids;
+}
+
+static std::vector<const std::string*>& symbolNames() {
+    static std::vector<const std::string*> names = {&symbolIds().find("")->first};
+    return names;
+}
+
+Symbol::Symbol(const std::string& name) {
+    if (name.empty()) return;
+
+    auto& ids = symbolIds();
+    auto it = ids.find(name);
+
+    if (it == ids.end()) {
+        auto& names = symbolNames();
+        it = ids.emplace(name, (uint32_t)names.size()).first;
+        names.push_back(&it->first);
+    }
+
+    id = it->second;
+}
+
+Symbol::Symbol(const char* name) : Symbol(std::string(name)) {}
+
+Symbol Symbol::lookup(const std::string& name) {
+    Symbol symbol;
+    auto it = symbolIds().find(name);
+    if (it != symbolIds().end()) symbol.id = it->second;
+    return symbol;
+}
+
+size_t Symbol::count() {return symbolNames().size();}
+
+const std::string& Symbol::str() const {return *symbolNames()[id];}
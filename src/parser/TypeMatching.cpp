@@ -25,8 +25,8 @@ bool areTypesCompatible(Type* param, Type* arg, bool isExplicit) {
         if (isExplicit) return false;
 
         std::string name = t1->toString();
-        if (AST::structTable.find(name) != AST::structTable.end()) {
-            auto& operators = AST::structTable[name]->operators;
+        if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
+            auto& operators = AST::structTable[Symbol(name)]->operators;
             if (operators.find(TokType::Equ) != operators.end()) {
                 Type* ty = operators[TokType::Equ].begin()->second->args[1].type;
                         if ((::isBytePointer(ty) && ::isBytePointer(t1)) || Types::typesEqual(ty, t1)) {
@@ -69,8 +69,8 @@ bool doArgumentsMatch(const std::vector<FuncArgSet>& params,
             // Additional check for struct with implicit conversion
             if (instanceof<TypeStruct>(t2) && !instanceof<TypeStruct>(t1) && !isExplicit) {
                 std::string name = t1->toString();
-                if (AST::structTable.find(name) != AST::structTable.end()) {
-                    auto& operators = AST::structTable[name]->operators;
+                if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
+                    auto& operators = AST::structTable[Symbol(name)]->operators;
                     if (operators.find(TokType::Equ) != operators.end()) {
                         Type* ty = operators[TokType::Equ].begin()->second->args[1].type;
                 if ((::isBytePointer(ty) && ::isBytePointer(t1)) || Types::typesEqual(ty, t1)) {
@@ -138,8 +138,8 @@ int calculateMatchScore(const std::vector<FuncArgSet>& params,
         // Implicit conversion via operator
         if (instanceof<TypeStruct>(tc2) && !instanceof<TypeStruct>(tc1) && !isExplicit) {
             std::string name = tc1->toString();
-            if (AST::structTable.find(name) != AST::structTable.end()) {
-                auto& operators = AST::structTable[name]->operators;
+            if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
+                auto& operators = AST::structTable[Symbol(name)]->operators;
                 if (operators.find(TokType::Equ) != operators.end()) {
                     score += 2;
                     continue;
@@ -54,7 +54,7 @@ std::string typeToString(Type* arg) {
         if (instanceof<TypeStruct>(((TypePointer*)arg)->instance)) {
             TypeStruct* ts = (TypeStruct*)(((TypePointer*)arg)->instance);
             Type* t = ts;
-            while (generator->toReplace.find(t->toString()) != generator->toReplace.end()) t = generator->toReplace[t->toString()];
+            while (generator->toReplace.find(Types::key(t)) != generator->toReplace.end()) t = generator->toReplace[Types::key(t)];
             if (!instanceof<TypeStruct>(t)) return typeToString(new TypePointer(t));
             ts = (TypeStruct*)t;
             if (ts->name.find('<') == std::string::npos) return "s-" + ts->name;
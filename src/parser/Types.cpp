@@ -21,7 +21,7 @@ int pointerSize;
 Type::~Type() {}
 
 // TypeBasic
-TypeBasic::TypeBasic(char ty) {
+TypeBasic::TypeBasic(char ty) : Type(TypeKind::Basic) {
     this->type = ty;
 }
 
@@ -67,7 +67,7 @@ Type* TypeBasic::getElType() {return this;}
 std::map<char, TypeBasic*> basicTypes;
 
 // TypePointer
-TypePointer::TypePointer(Type* instance) {
+TypePointer::TypePointer(Type* instance) : Type(TypeKind::Pointer) {
     this->instance = instance;
 }
 
@@ -90,12 +90,8 @@ Type* TypePointer::getElType() {
     return instance;
 }
 
-TypePointer::~TypePointer() {
-    if (Types::shouldDeleteType(this->instance)) delete this->instance;
-}
-
 // TypeArray
-TypeArray::TypeArray(Node* count, Type* element) {
+TypeArray::TypeArray(Node* count, Type* element) : Type(TypeKind::Array) {
     this->count = count;
     this->element = element;
 }
@@ -119,12 +115,8 @@ std::string TypeArray::toString() {
 
 Type* TypeArray::getElType() {return element;}
 
-TypeArray::~TypeArray() {
-    if (Types::shouldDeleteType(this->element)) delete this->element;
-}
-
 // TypeAlias
-TypeAlias::TypeAlias() {}
+TypeAlias::TypeAlias() : Type(TypeKind::Alias) {}
 Type* TypeAlias::copy() {return new TypeAlias();}
 std::string TypeAlias::toString() {return "alias";}
 Type* TypeAlias::check(Type* parent) {return nullptr;}
@@ -132,7 +124,7 @@ int TypeAlias::getSize() {return 0;}
 Type* TypeAlias::getElType() {return this;}
 
 // TypeVoid
-TypeVoid::TypeVoid() {}
+TypeVoid::TypeVoid() : Type(TypeKind::Void) {}
 Type* TypeVoid::check(Type* parent) {return nullptr;}
 Type* TypeVoid::copy() {return this;}
 int TypeVoid::getSize() {return 0;}
@@ -140,22 +132,19 @@ std::string TypeVoid::toString() {return "void";}
 Type* TypeVoid::getElType() {return this;}
 
 // TypeConst
-TypeConst::TypeConst(Type* instance) {this->instance = instance;}
+TypeConst::TypeConst(Type* instance) : Type(TypeKind::Const) {this->instance = instance;}
 Type* TypeConst::copy() {return new TypeConst(this->instance->copy());}
 Type* TypeConst::check(Type* parent) {this->instance->check(nullptr); return nullptr;}
 int TypeConst::getSize() {return this->instance->getSize();}
 std::string TypeConst::toString() {return this->instance->toString();}
 Type* TypeConst::getElType() {return this->instance;}
-TypeConst::~TypeConst() {
-    if (Types::shouldDeleteType(this->instance)) delete this->instance;
-}
 
 // TypeStruct
-TypeStruct::TypeStruct(std::string name) {
+TypeStruct::TypeStruct(std::string name) : Type(TypeKind::Struct) {
     this->name = name;
 }
 
-TypeStruct::TypeStruct(std::string name, std::vector<Type*> types) {
+TypeStruct::TypeStruct(std::string name, std::vector<Type*> types) : Type(TypeKind::Struct) {
     this->name = name;
     this->types = types;
 }
@@ -178,7 +167,7 @@ int TypeStruct::getSize() {
     Type* t = this;
 
     while (true) {
-        auto it = generator->toReplace.find(t->toString());
+        auto it = generator->toReplace.find(Types::key(t));
         if (it == generator->toReplace.end()) break;
         t = it->second;
     }
@@ -190,14 +179,14 @@ int TypeStruct::getSize() {
 
     if (instanceof<TypeStruct>(t)) {
         TypeStruct* ts = (TypeStruct*)t;
-        if (AST::structTable.find(ts->name) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
+        if (AST::structTable.find(Symbol::lookup(ts->name)) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
 
-        if (!ts->types.empty()) AST::structTable[ts->name]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
+        if (!ts->types.empty()) AST::structTable[Symbol(ts->name)]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
 
         int size = 0;
-        for (size_t i=0; i<AST::structTable[ts->name]->elements.size(); i++) {
-            if (AST::structTable[ts->name]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[ts->name]->elements[i])) {
-                NodeVar* nvar = (NodeVar*)AST::structTable[ts->name]->elements[i];
+        for (size_t i=0; i<AST::structTable[Symbol(ts->name)]->elements.size(); i++) {
+            if (AST::structTable[Symbol(ts->name)]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[Symbol(ts->name)]->elements[i])) {
+                NodeVar* nvar = (NodeVar*)AST::structTable[Symbol(ts->name)]->elements[i];
                 size += nvar->type->getSize();
             }
         }
@@ -221,14 +210,14 @@ bool TypeStruct::isSimple() {
 
     if (instanceof<TypeStruct>(t)) {
         TypeStruct* ts = (TypeStruct*)t;
-        if (AST::structTable.find(ts->name) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
+        if (AST::structTable.find(Symbol::lookup(ts->name)) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
         if (!ts->types.empty()) {
-            AST::structTable[ts->name]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
+            AST::structTable[Symbol(ts->name)]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
         }
 
-        for (size_t i=0; i<AST::structTable[ts->name]->elements.size(); i++) {
-            if (AST::structTable[ts->name]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[ts->name]->elements[i])) {
-                NodeVar* nvar = (NodeVar*)AST::structTable[ts->name]->elements[i];
+        for (size_t i=0; i<AST::structTable[Symbol(ts->name)]->elements.size(); i++) {
+            if (AST::structTable[Symbol(ts->name)]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[Symbol(ts->name)]->elements[i])) {
+                NodeVar* nvar = (NodeVar*)AST::structTable[Symbol(ts->name)]->elements[i];
                 if (!instanceof<TypeBasic>(nvar->type)) return false;
             }
         }
@@ -242,7 +231,7 @@ int TypeStruct::getElCount() {
     Type* t = this;
 
     while (true) {
-        auto it = generator->toReplace.find(t->toString());
+        auto it = generator->toReplace.find(Types::key(t));
         if (it == generator->toReplace.end()) break;
         t = it->second;
     }
@@ -254,15 +243,15 @@ int TypeStruct::getElCount() {
 
     if (instanceof<TypeStruct>(t)) {
         TypeStruct* ts = (TypeStruct*)t;
-        if (AST::structTable.find(ts->name) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
+        if (AST::structTable.find(Symbol::lookup(ts->name)) == AST::structTable.end()) generator->error("undefined structure \033[1m" + ts->name + "\033[22m!", -1);
         if (!ts->types.empty()) {
-            AST::structTable[ts->name]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
+            AST::structTable[Symbol(ts->name)]->genWithTemplate(ts->name.substr(ts->name.find('<')), ts->types);
         }
 
         int size = 0;
 
-        for (size_t i=0; i<AST::structTable[ts->name]->elements.size(); i++) {
-            if (AST::structTable[ts->name]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[ts->name]->elements[i])) size += 1;
+        for (size_t i=0; i<AST::structTable[Symbol(ts->name)]->elements.size(); i++) {
+            if (AST::structTable[Symbol(ts->name)]->elements[i] != nullptr && instanceof<NodeVar>(AST::structTable[Symbol(ts->name)]->elements[i])) size += 1;
         }
 
         return size;
@@ -302,7 +291,7 @@ Type* TypeStruct::getElType() {return this;}
 
 // TypeByval
 
-TypeByval::TypeByval(Type* type) {
+TypeByval::TypeByval(Type* type) : Type(TypeKind::Byval) {
     this->type = type;
 }
 
@@ -317,7 +306,7 @@ Type* TypeByval::check(Type* parent) {return nullptr;}
 std::string TypeByval::toString() {return this->type->toString() + "*";}
 
 // TypeTemplateMember
-TypeTemplateMember::TypeTemplateMember(Type* type, Node* value) {
+TypeTemplateMember::TypeTemplateMember(Type* type, Node* value) : Type(TypeKind::TemplateMember) {
     this->type = type;
     this->value = value;
 }
@@ -335,12 +324,8 @@ std::string TypeTemplateMember::toString() {
 int TypeTemplateMember::getSize() {return this->type->getSize();}
 Type* TypeTemplateMember::getElType() {return this->type->getElType();}
 
-TypeTemplateMember::~TypeTemplateMember() {
-    if (Types::shouldDeleteType(this->type)) delete this->type;
-}
-
 // TypeTemplateMemberDefinition
-TypeTemplateMemberDefinition::TypeTemplateMemberDefinition(Type* type, std::string name) {
+TypeTemplateMemberDefinition::TypeTemplateMemberDefinition(Type* type, std::string name) : Type(TypeKind::TemplateMemberDefinition) {
     this->type = type;
     this->name = name;
 }
@@ -351,12 +336,8 @@ std::string TypeTemplateMemberDefinition::toString() {return this->name;}
 int TypeTemplateMemberDefinition::getSize() {return this->type->getSize();}
 Type* TypeTemplateMemberDefinition::getElType() {return this->type->getElType();}
 
-TypeTemplateMemberDefinition::~TypeTemplateMemberDefinition() {
-    if (Types::shouldDeleteType(this->type)) delete this->type;
-}
-
 // TypeFuncArg
-TypeFuncArg::TypeFuncArg(Type* type, std::string name) {
+TypeFuncArg::TypeFuncArg(Type* type, std::string name) : Type(TypeKind::FuncArg) {
     this->type = type;
     this->name = name;
 }
@@ -367,12 +348,8 @@ std::string TypeFuncArg::toString() {return this->name;}
 int TypeFuncArg::getSize() {return this->type->getSize();}
 Type* TypeFuncArg::getElType() {return this->type->getElType();}
 
-TypeFuncArg::~TypeFuncArg() {
-    if (Types::shouldDeleteType(this->type)) delete this->type;
-}
-
 // TypeFunc
-TypeFunc::TypeFunc(Type* main, std::vector<TypeFuncArg*> args, bool isVarArg) {
+TypeFunc::TypeFunc(Type* main, std::vector<TypeFuncArg*> args, bool isVarArg) : Type(TypeKind::Func) {
     this->main = main;
     this->args = args;
     this->isVarArg = isVarArg;
@@ -403,15 +380,8 @@ std::string TypeFunc::toString() {
 Type* TypeFunc::check(Type* parent) {return nullptr;}
 Type* TypeFunc::getElType() {return this;}
 
-TypeFunc::~TypeFunc() {
-    if (Types::shouldDeleteType(this->main)) delete this->main;
-    for (size_t i = 0; i < this->args.size(); i++) {
-        if (Types::shouldDeleteType(this->args[i])) delete this->args[i];
-    }
-}
-
 // TypeBuiltin
-TypeBuiltin::TypeBuiltin(std::string name, std::vector<Node*> args, NodeBlock* block) {
+TypeBuiltin::TypeBuiltin(std::string name, std::vector<Node*> args, NodeBlock* block) : Type(TypeKind::Builtin) {
     this->name = name;
     this->args = args;
     this->block = block;
@@ -424,7 +394,7 @@ Type* TypeBuiltin::check(Type* parent) {return nullptr;}
 Type* TypeBuiltin::getElType() {return this;}
 
 // TypeCall
-TypeCall::TypeCall(std::string name, std::vector<Node*> args) {
+TypeCall::TypeCall(std::string name, std::vector<Node*> args) : Type(TypeKind::Call) {
     this->name = name;
     this->args = args;
 }
@@ -436,7 +406,7 @@ Type* TypeCall::check(Type* parent) {return nullptr;}
 Type* TypeCall::getElType() {return this;}
 
 // TypeAuto
-TypeAuto::TypeAuto() {}
+TypeAuto::TypeAuto() : Type(TypeKind::Auto) {}
 Type* TypeAuto::copy() {return new TypeAuto();}
 int TypeAuto::getSize() {return 0;}
 Type* TypeAuto::check(Type* parent) {return nullptr;}
@@ -444,7 +414,7 @@ std::string TypeAuto::toString() {return "";}
 Type* TypeAuto::getElType() {return this;}
 
 // TypeLLVM
-TypeLLVM::TypeLLVM(LLVMTypeRef tr) {this->tr = tr;}
+TypeLLVM::TypeLLVM(LLVMTypeRef tr) : Type(TypeKind::LLVM) {this->tr = tr;}
 Type* TypeLLVM::copy() {return new TypeLLVM(this->tr);}
 int TypeLLVM::getSize() {return 0;}
 Type* TypeLLVM::check(Type* parent) {return nullptr;}
@@ -452,7 +422,7 @@ std::string TypeLLVM::toString() {return "";}
 Type* TypeLLVM::getElType() {return this;}
 
 // TypeVector
-TypeVector::TypeVector(Type* mainType, int count) {this->mainType = mainType; this->count = count;}
+TypeVector::TypeVector(Type* mainType, int count) : Type(TypeKind::Vector) {this->mainType = mainType; this->count = count;}
 Type* TypeVector::copy() {return new TypeVector(mainType, count);}
 int TypeVector::getSize() {return mainType->getSize() * count;}
 Type* TypeVector::check(Type* parent) {return nullptr;}
@@ -460,7 +430,7 @@ std::string TypeVector::toString() {return "<" + mainType->toString() + " x " +
 Type* TypeVector::getElType() {return mainType;}
 
 // TypeDivided
-TypeDivided::TypeDivided(Type* mainType, std::vector<Type*> divided) {this->mainType = mainType; this->divided = divided;}
+TypeDivided::TypeDivided(Type* mainType, std::vector<Type*> divided) : Type(TypeKind::Divided) {this->mainType = mainType; this->divided = divided;}
 Type* TypeDivided::copy() {return new TypeDivided(mainType, divided);}
 
 int TypeDivided::getSize() {
@@ -480,38 +450,42 @@ Type* TypeDivided::getElType() {return this;}
 TypeVoid* typeVoid;
 
 Type* getTypeByName(std::string id) {
-    static const std::map<std::string, Type*> types = {
-        {"bool", basicTypes[BasicType::Bool]},
-        {"char", basicTypes[BasicType::Char]},
-        {"uchar", basicTypes[BasicType::Uchar]},
-        {"short", basicTypes[BasicType::Short]},
-        {"ushort", basicTypes[BasicType::Ushort]},
-        {"int", basicTypes[BasicType::Int]},
-        {"uint", basicTypes[BasicType::Uint]},
-        {"long", basicTypes[BasicType::Long]},
-        {"ulong", basicTypes[BasicType::Ulong]},
-        {"cent", basicTypes[BasicType::Cent]},
-        {"ucent", basicTypes[BasicType::Ucent]},
-        {"half", basicTypes[BasicType::Half]},
-        {"bhalf", basicTypes[BasicType::Bhalf]},
-        {"float", basicTypes[BasicType::Float]},
-        {"double", basicTypes[BasicType::Double]},
-        {"real", basicTypes[BasicType::Real]},
-        {"void", typeVoid},
-        {"isize", pointerSize == 8 ? basicTypes[BasicType::Char] : pointerSize == 16 ? basicTypes[BasicType::Short] : pointerSize == 32 ? basicTypes[BasicType::Int] : basicTypes[BasicType::Long]},
-        {"usize", pointerSize == 8 ? basicTypes[BasicType::Uchar] : pointerSize == 16 ? basicTypes[BasicType::Ushort] : pointerSize == 32 ? basicTypes[BasicType::Uint] : basicTypes[BasicType::Ulong]},
-        {"alias", new TypeAlias()},
-        {"int4", new TypeVector(basicTypes[BasicType::Int], 4)},
-        {"int8", new TypeVector(basicTypes[BasicType::Int], 8)},
-        {"float2", new TypeVector(basicTypes[BasicType::Float], 2)},
-        {"float4", new TypeVector(basicTypes[BasicType::Float], 4)},
-        {"float8", new TypeVector(basicTypes[BasicType::Float], 8)},
-        {"double2", new TypeVector(basicTypes[BasicType::Double], 2)},
-        {"double4", new TypeVector(basicTypes[BasicType::Double], 4)},
-        {"short8", new TypeVector(basicTypes[BasicType::Short], 8)},
-        {"mask16", new TypeVector(basicTypes[BasicType::Char], 16)},
-        {"mask32", new TypeVector(basicTypes[BasicType::Char], 32)}
-    };
+    // Shared by every unit, so they are allocated on the heap instead of the unit arena
+    static const std::map<std::string, Type*> types = []() {
+        Arena::Scope heapScope(nullptr);
+        return std::map<std::string, Type*>{
+            {"bool", basicTypes[BasicType::Bool]},
+            {"char", basicTypes[BasicType::Char]},
+            {"uchar", basicTypes[BasicType::Uchar]},
+            {"short", basicTypes[BasicType::Short]},
+            {"ushort", basicTypes[BasicType::Ushort]},
+            {"int", basicTypes[BasicType::Int]},
+            {"uint", basicTypes[BasicType::Uint]},
+            {"long", basicTypes[BasicType::Long]},
+            {"ulong", basicTypes[BasicType::Ulong]},
+            {"cent", basicTypes[BasicType::Cent]},
+            {"ucent", basicTypes[BasicType::Ucent]},
+            {"half", basicTypes[BasicType::Half]},
+            {"bhalf", basicTypes[BasicType::Bhalf]},
+            {"float", basicTypes[BasicType::Float]},
+            {"double", basicTypes[BasicType::Double]},
+            {"real", basicTypes[BasicType::Real]},
+            {"void", typeVoid},
+            {"isize", pointerSize == 8 ? basicTypes[BasicType::Char] : pointerSize == 16 ? basicTypes[BasicType::Short] : pointerSize == 32 ? basicTypes[BasicType::Int] : basicTypes[BasicType::Long]},
+            {"usize", pointerSize == 8 ? basicTypes[BasicType::Uchar] : pointerSize == 16 ? basicTypes[BasicType::Ushort] : pointerSize == 32 ? basicTypes[BasicType::Uint] : basicTypes[BasicType::Ulong]},
+            {"alias", new TypeAlias()},
+            {"int4", new TypeVector(basicTypes[BasicType::Int], 4)},
+            {"int8", new TypeVector(basicTypes[BasicType::Int], 8)},
+            {"float2", new TypeVector(basicTypes[BasicType::Float], 2)},
+            {"float4", new TypeVector(basicTypes[BasicType::Float], 4)},
+            {"float8", new TypeVector(basicTypes[BasicType::Float], 8)},
+            {"double2", new TypeVector(basicTypes[BasicType::Double], 2)},
+            {"double4", new TypeVector(basicTypes[BasicType::Double], 4)},
+            {"short8", new TypeVector(basicTypes[BasicType::Short], 8)},
+            {"mask16", new TypeVector(basicTypes[BasicType::Char], 16)},
+            {"mask32", new TypeVector(basicTypes[BasicType::Char], 32)}
+        };
+    }();
 
     auto it = types.find(id);
     if (it != types.end()) return it->second;
@@ -542,14 +516,14 @@ bool Types::replaceTemplates(Type** _type) {
     if (instanceof<TypeStruct>(type)) {
         TypeStruct* structure = (TypeStruct*)type;
 
-        if (generator->toReplace.find(structure->name) != generator->toReplace.end()) {
+        if (generator->toReplace.find(Symbol::lookup(structure->name)) != generator->toReplace.end()) {
             isChanged = true;
 
-            if (parent == nullptr) _type[0] = generator->toReplace[structure->name]->copy();
+            if (parent == nullptr) _type[0] = generator->toReplace[Symbol(structure->name)]->copy();
             else {
-                if (instanceof<TypePointer>(parent)) ((TypePointer*)parent)->instance = generator->toReplace[structure->name]->copy();
-                else if (instanceof<TypeArray>(parent)) ((TypeArray*)parent)->element = generator->toReplace[structure->name]->copy();
-                else if (instanceof<TypeConst>(parent)) ((TypeConst*)parent)->instance = generator->toReplace[structure->name]->copy();
+                if (instanceof<TypePointer>(parent)) ((TypePointer*)parent)->instance = generator->toReplace[Symbol(structure->name)]->copy();
+                else if (instanceof<TypeArray>(parent)) ((TypeArray*)parent)->element = generator->toReplace[Symbol(structure->name)]->copy();
+                else if (instanceof<TypeConst>(parent)) ((TypeConst*)parent)->instance = generator->toReplace[Symbol(structure->name)]->copy();
             }
         }
 
@@ -611,14 +585,54 @@ Type* Types::stripQualifiers(Type* type) {
     return type;
 }
 
-// Type flyweight caches
-static std::unordered_map<std::string, TypePointer*> pointerPool;
-static std::unordered_map<std::string, TypeVector*> vectorPool;
-static std::unordered_map<std::string, TypeArray*> arrayPool;
-static std::unordered_map<std::string, TypeConst*> constPool;
+// Keys of the basic types, by BasicType
+static Symbol basicKeys[256];
+
+// Keys of the pointers and arrays by (element key, 0 for a pointer or array size + 1)
+static std::unordered_map<uint64_t, Symbol> derivedKeys;
+
+static Symbol derivedKey(Type* type, Symbol element, uint64_t tag) {
+    uint64_t derived = ((uint64_t)element.id << 32) | tag;
+
+    auto it = derivedKeys.find(derived);
+    if (it != derivedKeys.end()) return it->second;
+
+    Symbol key(type->toString());
+    derivedKeys.emplace(derived, key);
+    return key;
+}
+
+Symbol Types::key(Type* type) {
+    switch (type->typeKind) {
+        case TypeKind::Basic: {
+            Symbol& key = basicKeys[(unsigned char)((TypeBasic*)type)->type];
+            if (key.empty()) key = Symbol(type->toString());
+            return key;
+        }
+        case TypeKind::Struct: return Symbol(((TypeStruct*)type)->name);
+        case TypeKind::Const: return Types::key(((TypeConst*)type)->instance);
+        case TypeKind::Pointer: return derivedKey(type, Types::key(((TypePointer*)type)->instance), 0);
+        case TypeKind::Byval: return derivedKey(type, Types::key(((TypeByval*)type)->type), 0);
+        case TypeKind::Array: {
+            TypeArray* array = (TypeArray*)type;
+            if (instanceof<NodeInt>(array->count)) {
+                int size = ((NodeInt*)array->count)->value.to_int();
+                if (size >= 0) return derivedKey(type, Types::key(array->element), (uint64_t)size + 1);
+            }
+            return Symbol(type->toString());
+        }
+        default: return Symbol(type->toString());
+    }
+}
+
+// Type flyweight caches, keyed by the keys of the element types
+static std::unordered_map<Symbol, TypePointer*> pointerPool;
+static std::unordered_map<uint64_t, TypeVector*> vectorPool;
+static std::unordered_map<uint64_t, TypeArray*> arrayPool;
+static std::unordered_map<Symbol, TypeConst*> constPool;
 
 TypePointer* Types::getPointerType(Type* instance) {
-    std::string key = instance->toString() + "*";
+    Symbol key = Types::key(instance);
     auto it = pointerPool.find(key);
     if (it != pointerPool.end()) return it->second;
     TypePointer* p = new TypePointer(instance);
@@ -627,7 +641,7 @@ TypePointer* Types::getPointerType(Type* instance) {
 }
 
 TypeVector* Types::getVectorType(Type* instance, int count) {
-    std::string key = instance->toString() + std::to_string(count);
+    uint64_t key = ((uint64_t)Types::key(instance).id << 32) | (uint32_t)count;
     auto it = vectorPool.find(key);
     if (it != vectorPool.end()) return it->second;
     TypeVector* v = new TypeVector(instance, count);
@@ -636,7 +650,7 @@ TypeVector* Types::getVectorType(Type* instance, int count) {
 }
 
 TypeArray* Types::getArrayType(Node* count, Type* element) {
-    std::string key = element->toString() + "[" + count->getType()->toString() + "]";
+    uint64_t key = ((uint64_t)Types::key(element).id << 32) | Types::key(count->getType()).id;
     auto it = arrayPool.find(key);
     if (it != arrayPool.end()) return it->second;
     TypeArray* a = new TypeArray(count, element);
@@ -645,7 +659,7 @@ TypeArray* Types::getArrayType(Node* count, Type* element) {
 }
 
 TypeConst* Types::getConstType(Type* instance) {
-    std::string key = "const " + instance->toString();
+    Symbol key = Types::key(instance);
     auto it = constPool.find(key);
     if (it != constPool.end()) return it->second;
     TypeConst* c = new TypeConst(instance);
@@ -654,12 +668,8 @@ TypeConst* Types::getConstType(Type* instance) {
 }
 
 void Types::clearTypePools() {
-    for (auto& p : pointerPool) delete p.second;
     pointerPool.clear();
-    for (auto& p : vectorPool) delete p.second;
     vectorPool.clear();
-    for (auto& p : arrayPool) delete p.second;
     arrayPool.clear();
-    for (auto& p : constPool) delete p.second;
     constPool.clear();
 }
@@ -20,16 +20,17 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 // AST namespace globals
 std::unordered_map<std::string, Type*> AST::aliasTypes;
-std::unordered_map<std::string, Node*> AST::aliasTable;
-std::unordered_map<std::string, NodeVar*> AST::varTable;
-std::unordered_map<std::string, NodeFunc*> AST::funcTable;
-std::unordered_map<std::string, std::vector<NodeFunc*>> AST::funcVersionsTable;
-std::unordered_map<std::string, NodeLambda*> AST::lambdaTable;
-std::unordered_map<std::string, NodeStruct*> AST::structTable;
-std::unordered_map<std::pair<std::string, std::string>, NodeFunc*> AST::methodTable;
-std::unordered_map<std::pair<std::string, std::string>, StructMember> AST::structMembersTable;
+std::unordered_map<Symbol, Node*> AST::aliasTable;
+std::unordered_map<Symbol, NodeVar*> AST::varTable;
+std::unordered_map<Symbol, NodeFunc*> AST::funcTable;
+std::unordered_map<Symbol, std::vector<NodeFunc*>> AST::funcVersionsTable;
+std::unordered_map<Symbol, NodeLambda*> AST::lambdaTable;
+std::unordered_map<Symbol, NodeStruct*> AST::structTable;
+std::unordered_map<std::pair<Symbol, Symbol>, NodeFunc*> AST::methodTable;
+std::unordered_map<std::pair<Symbol, Symbol>, StructMember> AST::structMembersTable;
 std::vector<std::string> AST::importedFiles;
 std::unordered_map<std::string, std::vector<Node*>> AST::parsed;
+Arena AST::parsedArena;
 std::string AST::mainFile;
 std::string AST::currentFile;
 std::vector<std::string> AST::addToImport;
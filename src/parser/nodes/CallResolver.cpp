@@ -33,8 +33,8 @@ bool hasIdenticallyArgs(const std::vector<Type*>& one, const std::vector<FuncArg
         if (instanceof<TypeStruct>(t2) && !instanceof<TypeStruct>(t1)) {
             if (fn->isExplicit) return false;
             std::string name = t1->toString();
-            if (AST::structTable.find(name) != AST::structTable.end()) {
-                auto& operators = AST::structTable[name]->operators;
+            if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
+                auto& operators = AST::structTable[Symbol(name)]->operators;
                 if (operators.find(TokType::Equ) != operators.end()) {
                     Type* ty = operators[TokType::Equ].begin()->second->args[1].type;
                     if ((isBytePointer(ty) && isBytePointer(t1)) || Types::typesEqual(ty, t1)) continue;
@@ -67,8 +67,8 @@ inline std::vector<FuncArgSet> tfaToFas(std::vector<TypeFuncArg*> tfa) {
     std::vector<FuncArgSet> fas;
     for (auto* arg : tfa) {
         Type* type = arg->type;
-        while (generator->toReplace.find(type->toString()) != generator->toReplace.end())
-            type = generator->toReplace[type->toString()];
+        while (generator->toReplace.find(Types::key(type)) != generator->toReplace.end())
+            type = generator->toReplace[Types::key(type)];
         fas.push_back(FuncArgSet{.name = arg->name, .type = type});
     }
     return fas;
@@ -98,16 +98,16 @@ NodeFunc* Call::findMethod(std::string structName, std::string methodName, std::
     // Fallback to legacy lookup
     if (methodFunc == nullptr) {
         auto method = std::pair<std::string, std::string>(structName, methodName);
-        auto methodf = AST::methodTable.find(method);
+        auto methodf = AST::methodTable.find(Symbol::lookup(method.first, method.second));
 
         if (methodf == AST::methodTable.end() || !hasIdenticallyArgs(argTypes, methodf->second->args, methodf->second)) {
             method.second += typesToString(argTypes);
-            methodf = AST::methodTable.find(method);
+            methodf = AST::methodTable.find(Symbol::lookup(method.first, method.second));
         }
 
         if (methodf == AST::methodTable.end()) {
             method.second = method.second.substr(0, method.second.find('['));
-            methodf = AST::methodTable.find(method);
+            methodf = AST::methodTable.find(Symbol::lookup(method.first, method.second));
         }
 
         if (methodf == AST::methodTable.end() || methodf->second->args.size() != arguments.size()) {
@@ -117,7 +117,7 @@ NodeFunc* Call::findMethod(std::string structName, std::string methodName, std::
                     if (it.first.second.find(methodName + "[") != 0 && it.first.second.find(methodName + "<") != 0) continue;
                 }
                 method.second = it.first.second;
-                methodf = AST::methodTable.find(method);
+                methodf = AST::methodTable.find(Symbol::lookup(method.first, method.second));
                 break;
             }
         }
@@ -129,7 +129,7 @@ NodeFunc* Call::findMethod(std::string structName, std::string methodName, std::
     }
 
     if (templateTypes.length() > 0) {
-        if (generator->functions.find(methodFunc->name + "<" + templateTypes + ">") == generator->functions.end()) {
+        if (generator->functions.find(Symbol::lookup(methodFunc->name + "<" + templateTypes + ">")) == generator->functions.end()) {
             std::vector<Type*> types = Template::parseTemplateTypes(templateTypes);
             templateTypes = "<";
             for (size_t i = 0; i < types.size(); i++) {
@@ -143,7 +143,7 @@ NodeFunc* Call::findMethod(std::string structName, std::string methodName, std::
             if (newMethod != nullptr) methodFunc = newMethod;
         }
     }
-    else if (generator->functions.find(methodFunc->name) == generator->functions.end()) {
+    else if (generator->functions.find(Symbol::lookup(methodFunc->name)) == generator->functions.end()) {
         methodFunc->generate();
     }
 
@@ -151,22 +151,21 @@ NodeFunc* Call::findMethod(std::string structName, std::string methodName, std::
 }
 
 NodeVar* Call::findVarFunction(std::string structName, std::string varName) {
-    auto var = std::pair<std::string, std::string>(structName, varName);
-    return (AST::structMembersTable.find(var) != AST::structMembersTable.end())
-        ? AST::structMembersTable[var].var : nullptr;
+    auto var = AST::structMembersTable.find(Symbol::lookup(structName, varName));
+    return (var != AST::structMembersTable.end()) ? var->second.var : nullptr;
 }
 
 RaveValue Call::callVarFunction(int loc, const std::string& name, std::vector<Node*>& arguments) {
     DEBUG_LOG(Debug::Category::FuncCall, "Calling variable function: " + name);
 
     std::vector<int> byVals;
-    if (!instanceof<TypeFunc>(currScope->getVar(name, loc)->type))
+    if (!instanceof<TypeFunc>(currScope->getVar(Symbol(name), loc)->type))
         generator->error("undefined function \033[1m" + name + "\033[22m!", loc);
 
-    TypeFunc* fn = (TypeFunc*)currScope->getVar(name, loc)->type;
+    TypeFunc* fn = (TypeFunc*)currScope->getVar(Symbol(name), loc)->type;
     std::vector<FuncArgSet> fas = tfaToFas(fn->args);
     std::vector<RaveValue> params = Call::genParameters(arguments, byVals, fas, CallSettings{false, fn->isVarArg, loc});
-    return LLVM::call(currScope->get(name, loc), params, (instanceof<TypeVoid>(fn->main) ? "" : "callFunc"), byVals);
+    return LLVM::call(currScope->get(Symbol(name), loc), params, (instanceof<TypeVoid>(fn->main) ? "" : "callFunc"), byVals);
 }
 
 RaveValue Call::callMethodOnGet(int loc, NodeGet* getFunc, std::vector<Node*>& arguments) {
@@ -175,7 +174,7 @@ RaveValue Call::callMethodOnGet(int loc, NodeGet* getFunc, std::vector<Node*>& a
     std::vector<int> byVals;
 
     if (instanceof<NodeIden>(getFunc->base)) {
-        std::string& ifName = ((NodeIden*)getFunc->base)->name;
+        Symbol ifName = ((NodeIden*)getFunc->base)->name;
         if (!currScope->has(ifName) && !currScope->hasAtThis(ifName))
             generator->error("undefined variable \033[1m" + ifName + "\033[22m!", loc);
 
@@ -188,7 +187,7 @@ RaveValue Call::callMethodOnGet(int loc, NodeGet* getFunc, std::vector<Node*>& a
             structure = (TypeStruct*)(variable->type->getElType());
         else generator->error("type of the variable \033[1m" + ifName + "\033[22m is not a structure!", loc);
 
-        if (AST::structTable.find(structure->name) != AST::structTable.end()) {
+        if (AST::structTable.find(Symbol::lookup(structure->name)) != AST::structTable.end()) {
             NodeVar* var = Call::findVarFunction(structure->name, getFunc->field);
             if (var != nullptr) {
                 std::vector<FuncArgSet> fas = tfaToFas(((TypeFunc*)var->type)->args);
@@ -202,7 +201,7 @@ RaveValue Call::callMethodOnGet(int loc, NodeGet* getFunc, std::vector<Node*>& a
             std::vector<RaveValue> params = Call::genParameters(arguments, byVals, methodf, loc);
             if (instanceof<TypePointer>(params[0].type->getElType()))
                 params[0] = LLVM::load(params[0], "NodeCall_load", loc);
-            return LLVM::call(generator->functions[methodf->name], params,
+            return LLVM::call(generator->functions[Symbol(methodf->name)], params,
                 (instanceof<TypeVoid>(methodf->type) ? "" : "callFunc"), byVals);
         }
         generator->error("structure \033[1m" + structure->name + "\033[22m does not exist!", loc);
@@ -235,13 +234,13 @@ RaveValue Call::callMethodOnGet(int loc, NodeGet* getFunc, std::vector<Node*>& a
 
     while (instanceof<TypePointer>(structure)) structure = structure->getElType();
 
-    if (AST::structTable.find(structure->toString()) != AST::structTable.end()) {
+    if (AST::structTable.find(Symbol::lookup(structure->toString())) != AST::structTable.end()) {
         arguments.insert(arguments.begin(), getFunc->base);
         auto methodf = Call::findMethod(structure->toString(), getFunc->field, arguments, loc);
         std::vector<RaveValue> params = Call::genParameters(arguments, byVals, methodf, loc);
         if (instanceof<TypePointer>(params[0].type->getElType()))
             params[0] = LLVM::load(params[0], "NodeCall_load", loc);
-        return LLVM::call(generator->functions[methodf->name], params,
+        return LLVM::call(generator->functions[Symbol(methodf->name)], params,
             (instanceof<TypeVoid>(methodf->type) ? "" : "callFunc"), byVals);
     }
 
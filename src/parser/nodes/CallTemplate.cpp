@@ -16,6 +16,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/FuncRegistry.hpp"
 #include "../../include/lexer/lexer.hpp"
 #include "../../include/debug.hpp"
+#include <map>
 
 // Template namespace implementation
 std::string Template::fromTypes(std::vector<Type*>& types) {
@@ -26,27 +27,48 @@ std::string Template::fromTypes(std::vector<Type*>& types) {
     return sTypes;
 }
 
+// Template arguments already parsed in this unit, by their text
+static std::unordered_map<std::string, std::vector<Type*>> parsedTemplateTypes;
+
+// Function templates instantiated in this unit, by the template and the keys of the template and argument types
+static std::map<std::pair<NodeFunc*, std::vector<uint32_t>>, std::string> functionInstances;
+
+void Template::clearCache() {
+    parsedTemplateTypes.clear();
+    functionInstances.clear();
+}
+
 std::vector<Type*> Template::parseTemplateTypes(const std::string& templateStr) {
-    DEBUG_LOG(Debug::Category::Template, "Parsing template types: " + templateStr);
+    auto parsed = parsedTemplateTypes.find(templateStr);
 
-    Lexer tLexer(templateStr, 1);
-    Parser tParser(tLexer.tokens, "(builtin)");
-    std::vector<Type*> types;
+    if (parsed == parsedTemplateTypes.end()) {
+        DEBUG_LOG(Debug::Category::Template, "Parsing template types: " + templateStr);
+
+        Lexer tLexer(templateStr, 1);
+        Parser tParser(tLexer.tokens, "(builtin)");
+        std::vector<Type*> types;
 
-    while (tParser.peek()->type != TokType::Eof) {
-        switch (tParser.peek()->type) {
-            case TokType::Number: case TokType::HexNumber: case TokType::FloatNumber: {
-                Node* value = tParser.parseExpr();
-                types.push_back(new TypeTemplateMember(value->getType(), value));
-                break;
+        while (tParser.peek()->type != TokType::Eof) {
+            switch (tParser.peek()->type) {
+                case TokType::Number: case TokType::HexNumber: case TokType::FloatNumber: {
+                    Node* value = tParser.parseExpr();
+                    types.push_back(new TypeTemplateMember(value->getType(), value));
+                    break;
+                }
+                default:
+                    types.push_back(tParser.parseType(true));
+                    break;
             }
-            default:
-                types.push_back(tParser.parseType(true));
-                break;
+            if (tParser.peek()->type == TokType::Comma) tParser.next();
         }
-        if (tParser.peek()->type == TokType::Comma) tParser.next();
+
+        parsed = parsedTemplateTypes.emplace(templateStr, types).first;
     }
 
+    // The templates are replaced in place, so the callers get copies
+    std::vector<Type*> types;
+    for (Type* type : parsed->second) types.push_back(type->copy());
+
     for (size_t i = 0; i < types.size(); i++)
         Types::replaceTemplates(&types[i]);
     return types;
@@ -54,9 +76,9 @@ std::vector<Type*> Template::parseTemplateTypes(const std::string& templateStr)
 
 // Helper: check and generate function if needed
 inline void checkAndGenerate(std::string name) {
-    if (generator->functions.find(name) == generator->functions.end()) {
-        if (AST::funcTable.find(name) == AST::funcTable.end()) return;
-        AST::funcTable[name]->generate();
+    if (generator->functions.find(Symbol::lookup(name)) == generator->functions.end()) {
+        if (AST::funcTable.find(Symbol::lookup(name)) == AST::funcTable.end()) return;
+        AST::funcTable[Symbol(name)]->generate();
     }
 }
 
@@ -65,8 +87,8 @@ inline std::vector<FuncArgSet> tfaToFas(std::vector<TypeFuncArg*> tfa) {
     std::vector<FuncArgSet> fas;
     for (auto* arg : tfa) {
         Type* type = arg->type;
-        while (generator->toReplace.find(type->toString()) != generator->toReplace.end())
-            type = generator->toReplace[type->toString()];
+        while (generator->toReplace.find(Types::key(type)) != generator->toReplace.end())
+            type = generator->toReplace[Types::key(type)];
         fas.push_back(FuncArgSet{.name = arg->name, .type = type});
     }
     return fas;
@@ -83,47 +105,60 @@ RaveValue Call::callTemplateFunction(int loc, const std::string& name, std::vect
     std::string callTypes = typesToString(pTypes);
 
     // Check if already generated
-    if (AST::funcTable.find(name + callTypes) != AST::funcTable.end()) {
-        std::vector<RaveValue> params = Call::genParameters(arguments, byVals, AST::funcTable[name + callTypes], loc);
-        return LLVM::call(generator->functions[name + callTypes], params,
-            (instanceof<TypeVoid>(AST::funcTable[name + callTypes]->type) ? "" : "callFunc"), byVals);
+    if (AST::funcTable.find(Symbol::lookup(name + callTypes)) != AST::funcTable.end()) {
+        std::vector<RaveValue> params = Call::genParameters(arguments, byVals, AST::funcTable[Symbol(name + callTypes)], loc);
+        return LLVM::call(generator->functions[Symbol(name + callTypes)], params,
+            (instanceof<TypeVoid>(AST::funcTable[Symbol(name + callTypes)]->type) ? "" : "callFunc"), byVals);
     }
 
-    bool presenceInFt = AST::funcTable.find(mainName) != AST::funcTable.end();
+    bool presenceInFt = AST::funcTable.find(Symbol::lookup(mainName)) != AST::funcTable.end();
 
     if (presenceInFt) {
-        if (AST::funcTable.find(mainName + callTypes) != AST::funcTable.end()) {
-            if (generator->functions.find(name + callTypes) != generator->functions.end()) {
-                std::vector<RaveValue> params = Call::genParameters(arguments, byVals, AST::funcTable[name + callTypes], loc);
-                return LLVM::call(generator->functions[name + callTypes], params,
-                    (instanceof<TypeVoid>(AST::funcTable[name + callTypes]->type) ? "" : "callFunc"), byVals);
+        if (AST::funcTable.find(Symbol::lookup(mainName + callTypes)) != AST::funcTable.end()) {
+            if (generator->functions.find(Symbol::lookup(name + callTypes)) != generator->functions.end()) {
+                std::vector<RaveValue> params = Call::genParameters(arguments, byVals, AST::funcTable[Symbol(name + callTypes)], loc);
+                return LLVM::call(generator->functions[Symbol(name + callTypes)], params,
+                    (instanceof<TypeVoid>(AST::funcTable[Symbol(name + callTypes)]->type) ? "" : "callFunc"), byVals);
             }
             mainName += callTypes;
         }
-        else if ((AST::funcTable[mainName]->args.size() != arguments.size()) &&
-                 !AST::funcTable[mainName]->isCdecl64 && !AST::funcTable[mainName]->isWin64 &&
-                 !AST::funcTable[mainName]->isVararg)
+        else if ((AST::funcTable[Symbol(mainName)]->args.size() != arguments.size()) &&
+                 !AST::funcTable[Symbol(mainName)]->isCdecl64 && !AST::funcTable[Symbol(mainName)]->isWin64 &&
+                 !AST::funcTable[Symbol(mainName)]->isVararg)
             generator->error("wrong number of arguments for calling function \033[1m" + name +
-                "\033[22m (\033[1m" + std::to_string(AST::funcTable[mainName]->args.size()) +
+                "\033[22m (\033[1m" + std::to_string(AST::funcTable[Symbol(mainName)]->args.size()) +
                 "\033[22m expected, \033[1m" + std::to_string(arguments.size()) + "\033[22m provided)!", loc);
     }
 
     std::vector<Type*> types = Template::parseTemplateTypes(sTypes);
 
     if (presenceInFt) {
+        NodeFunc* templateFunc = AST::funcTable[Symbol(mainName)];
+
+        // Generated instances are found by the keys of the types, before any name is built
+        std::pair<NodeFunc*, std::vector<uint32_t>> instance = {templateFunc, {}};
+        instance.second.reserve(types.size() + pTypes.size());
+        for (Type* type : types) instance.second.push_back(Types::key(type).id);
+        for (Type* type : pTypes) instance.second.push_back(Types::key(type).id);
+
+        auto cached = functionInstances.find(instance);
+        if (cached != functionInstances.end()) return Call::callNamedFunction(loc, cached->second, arguments);
+
         sTypes = "<";
         for (size_t i = 0; i < types.size(); i++) sTypes += types[i]->toString() + ",";
         sTypes = sTypes.substr(0, sTypes.length() - 1) + ">";
 
-        if (AST::funcTable.find(mainName + sTypes) != AST::funcTable.end())
+        if (AST::funcTable.find(Symbol::lookup(mainName + sTypes)) != AST::funcTable.end())
             return Call::make(loc, new NodeIden(mainName + sTypes, loc), arguments);
 
         std::string sTypes2 = sTypes + typesToString(types);
-        if (AST::funcTable.find(mainName + sTypes2) != AST::funcTable.end())
+        if (AST::funcTable.find(Symbol::lookup(mainName + sTypes2)) != AST::funcTable.end())
             return Call::make(loc, new NodeIden(mainName + sTypes2, loc), arguments);
 
-        AST::funcTable[mainName]->generateWithTemplate(types,
-            mainName + sTypes + (mainName.find('[') == std::string::npos ? callTypes : ""));
+        std::string generatedName = mainName + sTypes + (mainName.find('[') == std::string::npos ? callTypes : "");
+        templateFunc->generateWithTemplate(types, generatedName);
+        functionInstances[instance] = generatedName;
+        return Call::callNamedFunction(loc, generatedName, arguments);
     }
     else {
         sTypes = "<";
@@ -133,12 +168,12 @@ RaveValue Call::callTemplateFunction(int loc, const std::string& name, std::vect
         std::string ifName = mainName + sTypes;
         mainName = ifName.substr(0, ifName.find('<'));
 
-        if (AST::funcTable.find(mainName) == AST::funcTable.end()) {
-            if (AST::structTable.find(mainName) != AST::structTable.end())
-                AST::structTable[mainName]->genWithTemplate(sTypes, types);
-            else if (currScope->has("this")) {
+        if (AST::funcTable.find(Symbol::lookup(mainName)) == AST::funcTable.end()) {
+            if (AST::structTable.find(Symbol::lookup(mainName)) != AST::structTable.end())
+                AST::structTable[Symbol(mainName)]->genWithTemplate(sTypes, types);
+            else if (currScope->has(Symbol::lookup("this"))) {
                 // Check for method on this
-                NodeVar* _this = currScope->getVar("this", loc);
+                NodeVar* _this = currScope->getVar(Symbol("this"), loc);
                 if (instanceof<TypeStruct>(_this->type->getElType())) {
                     TypeStruct* _struct = (TypeStruct*)_this->type->getElType();
                     arguments.insert(arguments.begin(), new NodeIden("this", loc));
@@ -146,16 +181,13 @@ RaveValue Call::callTemplateFunction(int loc, const std::string& name, std::vect
                     std::vector<RaveValue> params = Call::genParameters(arguments, byVals, methodf, loc);
                     if (instanceof<TypePointer>(params[0].type->getElType()))
                         params[0] = LLVM::load(params[0], "NodeCall_load", loc);
-                    return LLVM::call(generator->functions[methodf->name], params,
+                    return LLVM::call(generator->functions[Symbol(methodf->name)], params,
                         (instanceof<TypeVoid>(methodf->type) ? "" : "callFunc"), byVals);
                 }
             }
             else generator->error("undefined structure \033[1m" + ifName + "\033[22m!", loc);
         }
 
-        return Call::make(loc, AST::funcTable[ifName], arguments);
+        return Call::make(loc, AST::funcTable[Symbol(ifName)], arguments);
     }
-
-    std::string generatedName = mainName + sTypes + (mainName.find('[') == std::string::npos ? callTypes : "");
-    return Call::callNamedFunction(loc, generatedName, arguments);
 }
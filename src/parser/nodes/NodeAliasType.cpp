@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utils.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodeAliasType::NodeAliasType(std::string name, Type* value, int loc) {
+NodeAliasType::NodeAliasType(std::string name, Type* value, int loc) : Node(NodeKind::AliasType) {
     this->name = name;
     this->origName = name;
     this->value = value;
@@ -26,12 +26,8 @@ void NodeAliasType::check() {
     if (isChecked) return;
     isChecked = true;
 
-    while (AST::aliasTable.find(name) != AST::aliasTable.end()) name = ((NodeIden*)AST::aliasTable[name])->name;
+    while (AST::aliasTable.find(Symbol::lookup(name)) != AST::aliasTable.end()) name = ((NodeIden*)AST::aliasTable[Symbol(name)])->name;
 
     if (namespacesNames.size() > 0) name = namespacesToString(namespacesNames, name);
     AST::aliasTypes[name] = value;
 }
-
-NodeAliasType::~NodeAliasType() {
-    if (this->value != nullptr && !instanceof<TypeBasic>(this->value) && !instanceof<TypeVoid>(this->value)) delete this->value;
-}
\ No newline at end of file
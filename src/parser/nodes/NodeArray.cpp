@@ -9,7 +9,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/ast.hpp"
 #include "../../include/llvm.hpp"
 
-NodeArray::NodeArray(int loc, std::vector<Node*> values) {
+NodeArray::NodeArray(int loc, std::vector<Node*> values) : Node(NodeKind::Array) {
     this->loc = loc;
     this->values = std::vector<Node*>(values);
 }
@@ -19,10 +19,6 @@ Type* NodeArray::getType() {
     return typeVoid;
 }
 
-NodeArray::~NodeArray() {
-    for (size_t i=0; i<values.size(); i++) if (values[i] != nullptr) delete values[i];
-}
-
 std::vector<RaveValue> NodeArray::getValues() {
     std::vector<RaveValue> buffer;
 
@@ -9,7 +9,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/ast.hpp"
 #include "../../include/llvm.hpp"
 
-NodeAsm::NodeAsm(std::string line, bool isVolatile, Type* type, std::string additions, std::vector<Node*> values, int loc) {
+NodeAsm::NodeAsm(std::string line, bool isVolatile, Type* type, std::string additions, std::vector<Node*> values, int loc) : Node(NodeKind::Asm) {
     this->line = line;
     this->isVolatile = isVolatile;
     this->type = type;
@@ -56,9 +56,3 @@ RaveValue NodeAsm::generate() {
     debugInfo->setInstrLoc(this->loc);
     return result;
 }
-
-NodeAsm::~NodeAsm() {
-    if (this->type != nullptr && !instanceof<TypeBasic>(this->type) && !instanceof<TypeVoid>(this->type)) delete this->type;
-    
-    for (size_t i=0; i<this->values.size(); i++) if (this->values[i] != nullptr) delete this->values[i];
-}
\ No newline at end of file
@@ -17,7 +17,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeType.hpp"
 #include "../../include/llvm.hpp"
 
-NodeBinary::NodeBinary(char op, Node* first, Node* second, int loc, bool isStatic) {
+NodeBinary::NodeBinary(char op, Node* first, Node* second, int loc, bool isStatic) : Node(NodeKind::Binary) {
     this->op = op;
     this->first = first;
     this->second = second;
@@ -46,8 +46,8 @@ Node* NodeBinary::comptime() {
         Types::replaceTemplates(&secondType);
 
         switch (this->op) {
-            case TokType::Equal: return new NodeBool(firstType->toString() == secondType->toString());
-            case TokType::Nequal: return new NodeBool(firstType->toString() != secondType->toString());
+            case TokType::Equal: return new NodeBool(Types::typesEqual(firstType, secondType));
+            case TokType::Nequal: return new NodeBool(!Types::typesEqual(firstType, secondType));
             default: return new NodeBool(false);
         }
     }
@@ -242,7 +242,3 @@ RaveValue NodeBinary::generate() {
     return Binary::operation(op, first, second, loc);
 }
 
-NodeBinary::~NodeBinary() {
-    if (first != nullptr) delete first;
-    if (second != nullptr) delete second;
-}
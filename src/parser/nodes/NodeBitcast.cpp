@@ -9,7 +9,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/llvm.hpp"
 #include <iostream>
 
-NodeBitcast::NodeBitcast(Type* type, Node* value, int loc) {
+NodeBitcast::NodeBitcast(Type* type, Node* value, int loc) : Node(NodeKind::Bitcast) {
     this->type = type;
     this->value = value;
     this->loc = loc;
@@ -22,11 +22,6 @@ void NodeBitcast::check() {
     value->check();
 }
 
-NodeBitcast::~NodeBitcast() {
-    if (this->value != nullptr) delete this->value;
-    if (this->type != nullptr && !instanceof<TypeBasic>(this->type) && !instanceof<TypeVoid>(this->type)) delete this->type;
-}
-
 Type* NodeBitcast::getType() {return this->type->copy();}
 Node* NodeBitcast::copy() {return new NodeBitcast(this->type->copy(), this->value->copy(), this->loc);}
 Node* NodeBitcast::comptime() {return nullptr;}
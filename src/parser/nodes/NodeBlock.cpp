@@ -8,7 +8,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeVar.hpp"
 #include "../../include/parser/Types.hpp"
 
-NodeBlock::NodeBlock(std::vector<Node*> nodes) : nodes(std::vector<Node*>(nodes)) {}
+NodeBlock::NodeBlock(std::vector<Node*> nodes) : Node(NodeKind::Block), nodes(std::vector<Node*>(nodes)) {}
 
 Node* NodeBlock::copy() {
     std::vector<Node*> newNodes;
@@ -25,7 +25,7 @@ void NodeBlock::check() {
 
 void NodeBlock::optimize() {
     for (Node* nd: nodes) {
-        NodeVar* ndvar = dynamic_cast<NodeVar*>(nd);
+        NodeVar* ndvar = dyn_cast<NodeVar>(nd);
         if (!ndvar) nd->optimize();
         else if (!ndvar->isGlobal && !ndvar->isUsed) generator->warning("unused variable \033[1m" + ndvar->name + "\033[22m!", ndvar->loc);
     }
@@ -40,4 +40,3 @@ RaveValue NodeBlock::generate() {
     return {};
 }
 
-NodeBlock::~NodeBlock() { for (Node* nd: nodes) { if (nd) delete nd; } }
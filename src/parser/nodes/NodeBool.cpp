@@ -8,7 +8,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utils.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodeBool::NodeBool(bool value) : value(value) {}
+NodeBool::NodeBool(bool value) : Node(NodeKind::Bool), value(value) {}
 
 void NodeBool::check() { isChecked = true; }
 
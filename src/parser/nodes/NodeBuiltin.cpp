@@ -29,16 +29,10 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/compiler.hpp"
 
 NodeBuiltin::NodeBuiltin(std::string name, std::vector<Node*> args, int loc, NodeBlock* block)
-    : name(name), args(std::vector<Node*>(args)), loc(loc), block(block) {}
+    : Node(NodeKind::Builtin), name(name), args(std::vector<Node*>(args)), loc(loc), block(block) {}
 
 NodeBuiltin::NodeBuiltin(std::string name, std::vector<Node*> args, int loc, NodeBlock* block, Type* type, bool isImport, bool isTopLevel, int CTId)
-    : name(name), args(std::vector<Node*>(args)), loc(loc), block(block), type(type), isImport(isImport), isTopLevel(isTopLevel), CTId(CTId) {}
-
-NodeBuiltin::~NodeBuiltin() {
-    for (size_t i=0; i<args.size(); i++) { if (args[i]) delete args[i]; }
-    if (block) delete block;
-    if (type) delete type;
-}
+    : Node(NodeKind::Builtin), name(name), args(std::vector<Node*>(args)), loc(loc), block(block), type(type), isImport(isImport), isTopLevel(isTopLevel), CTId(CTId) {}
 
 Node* NodeBuiltin::copy() {
     return new NodeBuiltin(
@@ -76,9 +70,9 @@ NodeType* NodeBuiltin::asType(int n, bool isCompTime) {
     if (instanceof<NodeType>(args[n])) return (NodeType*)args[n];
     if (instanceof<NodeIden>(args[n])) {
         std::string name = ((NodeIden*)args[n])->name;
-        if (generator->toReplace.find(name) != generator->toReplace.end()) {
-            Type* ty = generator->toReplace[name];
-            while (generator->toReplace.find(ty->toString()) != generator->toReplace.end()) ty = generator->toReplace[ty->toString()];
+        if (generator->toReplace.find(Symbol::lookup(name)) != generator->toReplace.end()) {
+            Type* ty = generator->toReplace[Symbol(name)];
+            while (generator->toReplace.find(Types::key(ty)) != generator->toReplace.end()) ty = generator->toReplace[Types::key(ty)];
             return new NodeType(ty, loc);
         }
 
@@ -109,8 +103,8 @@ std::string NodeBuiltin::asStringIden(int n) {
     if (instanceof<NodeIden>(args[n])) {
         NodeIden* id = (NodeIden*)args[n];
         std::string nam = id->name;
-        while (AST::aliasTable.find(nam) != AST::aliasTable.end()) {
-            Node* node = AST::aliasTable[nam];
+        while (AST::aliasTable.find(Symbol::lookup(nam)) != AST::aliasTable.end()) {
+            Node* node = AST::aliasTable[Symbol(nam)];
             if (instanceof<NodeIden>(node)) nam = ((NodeIden*)node)->name;
             else if (instanceof<NodeString>(node)) nam = ((NodeString*)node)->value;
             else if (instanceof<NodeInt>(node)) return ((NodeInt*)node)->value.to_string();
@@ -206,12 +200,12 @@ int NodeBuiltin::handleAbstractBool() {
         Type* tp = asClearType(0);
         return (int)(instanceof<TypeBasic>(tp) && ((TypeBasic*)tp)->isUnsigned());
     }
-    if (name == "aliasExists") { requireMinArgs(1); return (int)(AST::aliasTable.find(getAliasName(0)) != AST::aliasTable.end()); }
+    if (name == "aliasExists") { requireMinArgs(1); return (int)(AST::aliasTable.find(Symbol::lookup(getAliasName(0))) != AST::aliasTable.end()); }
     return -1;
 }
 
 int NodeBuiltin::handleAbstractInt() {
-    if (name == "argsLength") return AST::funcTable[currScope->funcName]->args.size();
+    if (name == "argsLength") return AST::funcTable[Symbol(currScope->funcName)]->args.size();
     if (name == "getCurrArgNumber") return generator->currentBuiltinArg;
     if (name == "sizeOf") { requireMinArgs(1); return asClearType(0)->getSize() / 8; }
     return -1;
@@ -245,7 +239,7 @@ RaveValue NodeBuiltin::generate() {
         RaveValue result = {nullptr, nullptr};
 
         if (ty->isFloat()) {
-            if (ty->toString() != two.type->toString()) {
+            if (!Types::typesEqual(ty, two.type)) {
                 if (ty->type == BasicType::Double) {
                     two.value = LLVMBuildFPCast(generator->builder, two.value, generator->genType(ty, loc), "NodeBuiltin_fmodf_ftod");
                     two.type = ty;
@@ -287,7 +281,7 @@ RaveValue NodeBuiltin::generate() {
         return result;
     }
     else if (name == "foreachArgs") {
-        for (int i=generator->currentBuiltinArg; i<AST::funcTable[currScope->funcName]->args.size(); i++) {
+        for (int i=generator->currentBuiltinArg; i<AST::funcTable[Symbol(currScope->funcName)]->args.size(); i++) {
             block->generate();
             generator->currentBuiltinArg += 1;
         }
@@ -295,7 +289,7 @@ RaveValue NodeBuiltin::generate() {
     }
     else if (name == "callWithArgs") {
         std::vector<Node*> nodes;
-        for (int i=generator->currentBuiltinArg; i<AST::funcTable[currScope->funcName]->args.size(); i++)
+        for (int i=generator->currentBuiltinArg; i<AST::funcTable[Symbol(currScope->funcName)]->args.size(); i++)
             nodes.push_back(new NodeIden("_RaveArg" + std::to_string(i), loc));
         for (size_t i=1; i<args.size(); i++) nodes.push_back(args[i]);
         return (new NodeCall(loc, args[0], nodes))->generate();
@@ -303,7 +297,7 @@ RaveValue NodeBuiltin::generate() {
     else if (name == "callWithBeforeArgs") {
         std::vector<Node*> nodes;
         for (size_t i=1; i<args.size(); i++) nodes.push_back(args[i]);
-        for (int i=generator->currentBuiltinArg; i<AST::funcTable[currScope->funcName]->args.size(); i++)
+        for (int i=generator->currentBuiltinArg; i<AST::funcTable[Symbol(currScope->funcName)]->args.size(); i++)
             nodes.push_back(new NodeIden("_RaveArg" + std::to_string(i), loc));
         return (new NodeCall(loc, args[0], nodes))->generate();
     }
@@ -317,7 +311,7 @@ RaveValue NodeBuiltin::generate() {
     }
     else if (name == "getArgType") {
         requireMinArgs(1);
-        type = currScope->getVar("_RaveArg" + asNumber(1).to_string(), loc)->type;
+        type = currScope->getVar(Symbol("_RaveArg" + asNumber(1).to_string()), loc)->type;
         return {};
     }
     else if (name == "skipArg") {
@@ -325,7 +319,7 @@ RaveValue NodeBuiltin::generate() {
         return {};
     }
     else if (name == "getCurrArgType") {
-        type = currScope->getVar("_RaveArg" + std::to_string(generator->currentBuiltinArg), loc)->type;
+        type = currScope->getVar(Symbol("_RaveArg" + std::to_string(generator->currentBuiltinArg)), loc)->type;
         return {};
     }
     else if (name == "compileAndLink") {
@@ -358,7 +352,7 @@ RaveValue NodeBuiltin::generate() {
     }
     else if (name == "addLibrary") {
         requireMinArgs(1);
-        Compiler::linkString += " -l" + asStringIden(0) + " ";
+        Compiler::linkArguments.push_back("-l" + asStringIden(0));
         return {};
     }
     else if (name == "return") {
@@ -367,7 +361,7 @@ RaveValue NodeBuiltin::generate() {
                 if (args.size() == 1) Binary::operation(TokType::Equ, new NodeIden("return", loc), args[0], loc);
                 Defer::emitAll();
                 if (currScope->fnEnd != nullptr) LLVMBuildBr(generator->builder, currScope->fnEnd);
-                else LLVMBuildBr(generator->builder, AST::funcTable[currScope->funcName]->exitBlock);
+                else LLVMBuildBr(generator->builder, AST::funcTable[Symbol(currScope->funcName)]->exitBlock);
                 if (generator->activeLoops.size() > 0) generator->activeLoops[generator->activeLoops.size()-1].hasEnd = true;
                 currScope->funcHasRet = true;
             }
@@ -378,7 +372,7 @@ RaveValue NodeBuiltin::generate() {
         requireMinArgs(1);
 
         Type* ty = asType(0)->type;
-        if (generator->toReplace.find(ty->toString()) != generator->toReplace.end()) ty = generator->toReplace[ty->toString()];
+        if (generator->toReplace.find(Types::key(ty)) != generator->toReplace.end()) ty = generator->toReplace[Types::key(ty)];
 
         if (!instanceof<TypeStruct>(ty)) return {LLVM::makeInt(1, 0, false), basicTypes[BasicType::Bool]};
         TypeStruct* tstruct = (TypeStruct*)ty;
@@ -395,13 +389,13 @@ RaveValue NodeBuiltin::generate() {
             }
         }
 
-        auto it = AST::methodTable.find({tstruct->name, methodName});
+        auto it = AST::methodTable.find(Symbol::lookup(tstruct->name, methodName));
         return { LLVM::makeInt(1, it != AST::methodTable.end() && fnType == nullptr, false), basicTypes[BasicType::Bool] };
     }
     else if (name == "hasDestructor") {
         requireMinArgs(1);
 
-        auto it = AST::structTable.find(asType(0)->type->toString());
+        auto it = AST::structTable.find(Symbol::lookup(asType(0)->type->toString()));
         return {LLVM::makeInt(1, it != AST::structTable.end() && it->second->destructor != nullptr, false), basicTypes[BasicType::Bool]};
     }
     else if (name == "atomicTAS") {
@@ -448,10 +442,10 @@ RaveValue NodeBuiltin::generate() {
         if (args.size() == 3) alignment = asBool(2)->value;
 
         std::string sName = "__rave_vLoad_" + resultVectorType->toString();
-        if (AST::structTable.find(sName) == AST::structTable.end()) {
-            AST::structTable[sName] = new NodeStruct(sName, {new NodeVar("v1", nullptr, false, false, false, {}, loc, resultVectorType, false, false, false)}, loc, "", {}, {});
+        if (AST::structTable.find(Symbol::lookup(sName)) == AST::structTable.end()) {
+            AST::structTable[Symbol(sName)] = new NodeStruct(sName, {new NodeVar("v1", nullptr, false, false, false, {}, loc, resultVectorType, false, false, false)}, loc, "", {}, {});
 
-            if (generator->structures.find(sName) == generator->structures.end()) AST::structTable[sName]->generate();
+            if (generator->structures.find(Symbol::lookup(sName)) == generator->structures.end()) AST::structTable[Symbol(sName)]->generate();
         }
 
         // Uses clang method: creating anonymous structure with vector type and bitcast it
@@ -478,10 +472,10 @@ RaveValue NodeBuiltin::generate() {
         if (args.size() == 3) alignment = asBool(2)->value;
 
         std::string sName = "__rave_vStore_" + vector.type->toString();
-        if (AST::structTable.find(sName) == AST::structTable.end()) {
-            AST::structTable[sName] = new NodeStruct(sName, {new NodeVar("v1", nullptr, false, false, false, {}, loc, vector.type, false, false, false)}, loc, "", {}, {});
+        if (AST::structTable.find(Symbol::lookup(sName)) == AST::structTable.end()) {
+            AST::structTable[Symbol(sName)] = new NodeStruct(sName, {new NodeVar("v1", nullptr, false, false, false, {}, loc, vector.type, false, false, false)}, loc, "", {}, {});
 
-            if (generator->structures.find(sName) == generator->structures.end()) AST::structTable[sName]->generate();
+            if (generator->structures.find(Symbol::lookup(sName)) == generator->structures.end()) AST::structTable[Symbol(sName)]->generate();
         }
 
         // Uses clang method: creating anonymous structure with vector type and bitcast it
@@ -550,10 +544,10 @@ RaveValue NodeBuiltin::generate() {
         if (instanceof<TypePointer>(vector2.type)) vector2 = LLVM::load(vector2, "VHAdd32x4_load2_", loc);
 
         if (!instanceof<TypeVector>(vector1.type) || !instanceof<TypeVector>(vector2.type)) generator->error("the values must have the vector type!", loc);
-        if (vector1.type->getElType()->toString() != vector2.type->getElType()->toString()) generator->error("the values must have the same type!", loc);
+        if (!Types::typesEqual(vector1.type->getElType(), vector2.type->getElType())) generator->error("the values must have the same type!", loc);
 
-        if (!((TypeBasic*)vector1.type->getElType())->isFloat()) return LLVM::call(generator->functions["llvm.x86.ssse3.phadd.d.128"], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd32x4");
-        return LLVM::call(generator->functions["llvm.x86.sse3.hadd.ps"], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd32x4");
+        if (!((TypeBasic*)vector1.type->getElType())->isFloat()) return LLVM::call(generator->functions[Symbol("llvm.x86.ssse3.phadd.d.128")], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd32x4");
+        return LLVM::call(generator->functions[Symbol("llvm.x86.sse3.hadd.ps")], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd32x4");
     }
     else if (name == "vHAdd16x8") {
         if (Compiler::features.find("+ssse3") == std::string::npos) {
@@ -570,9 +564,9 @@ RaveValue NodeBuiltin::generate() {
         if (instanceof<TypePointer>(vector2.type)) vector2 = LLVM::load(vector2, "VHAdd16x8_load2_", loc);
 
         if (!instanceof<TypeVector>(vector1.type) || !instanceof<TypeVector>(vector2.type)) generator->error("the values must have the vector type!", loc);
-        if (vector1.type->getElType()->toString() != vector2.type->getElType()->toString()) generator->error("the values must have the same type!", loc);
+        if (!Types::typesEqual(vector1.type->getElType(), vector2.type->getElType())) generator->error("the values must have the same type!", loc);
 
-        return LLVM::call(generator->functions["llvm.x86.ssse3.phadd.sw.128"], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd16x8");
+        return LLVM::call(generator->functions[Symbol("llvm.x86.ssse3.phadd.sw.128")], std::vector<LLVMValueRef>({vector1.value, vector2.value}).data(), 2, "vHAdd16x8");
     }
     else if (name == "vMoveMask128") {
         if (Compiler::features.find("+sse2") == std::string::npos)  generator->error("your target does not support SSE2!", loc);
@@ -583,15 +577,15 @@ RaveValue NodeBuiltin::generate() {
 
         if (instanceof<TypePointer>(value.type)) value = LLVM::load(value, "NodeBuiltin_vMoveMask_load_", loc);
 
-        if (generator->functions.find("llvm.x86.sse2.pmovmskb.128") == generator->functions.end()) {
-            generator->functions["llvm.x86.sse2.pmovmskb.128"] = {LLVMAddFunction(generator->lModule, "llvm.x86.sse2.pmovmskb.128", LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup("llvm.x86.sse2.pmovmskb.128")) == generator->functions.end()) {
+            generator->functions[Symbol("llvm.x86.sse2.pmovmskb.128")] = {LLVMAddFunction(generator->lModule, "llvm.x86.sse2.pmovmskb.128", LLVMFunctionType(
                 LLVMInt32TypeInContext(generator->context),
                 std::vector<LLVMTypeRef>({LLVMVectorType(LLVMInt8TypeInContext(generator->context), 16)}).data(),
                 1, false
             )), new TypeFunc(basicTypes[BasicType::Int], {new TypeFuncArg(new TypeVector(basicTypes[BasicType::Char], 16), "v")}, false)};
         }
 
-        return LLVM::call(generator->functions["llvm.x86.sse2.pmovmskb.128"], std::vector<LLVMValueRef>({value.value}).data(), 1, "vMoveMask128");
+        return LLVM::call(generator->functions[Symbol("llvm.x86.sse2.pmovmskb.128")], std::vector<LLVMValueRef>({value.value}).data(), 1, "vMoveMask128");
     }
     else if (name == "vMoveMask256") {
         if (Compiler::features.find("+avx2") == std::string::npos)  generator->error("your target does not support AVX2!", loc);
@@ -602,15 +596,15 @@ RaveValue NodeBuiltin::generate() {
 
         if (instanceof<TypePointer>(value.type)) value = LLVM::load(value, "NodeBuiltin_vMoveMask_load_", loc);
 
-        if (generator->functions.find("llvm.x86.avx2.pmovmskb") == generator->functions.end()) {
-            generator->functions["llvm.x86.avx2.pmovmskb"] = {LLVMAddFunction(generator->lModule, "llvm.x86.avx2.pmovmskb", LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup("llvm.x86.avx2.pmovmskb")) == generator->functions.end()) {
+            generator->functions[Symbol("llvm.x86.avx2.pmovmskb")] = {LLVMAddFunction(generator->lModule, "llvm.x86.avx2.pmovmskb", LLVMFunctionType(
                 LLVMInt32TypeInContext(generator->context),
                 std::vector<LLVMTypeRef>({LLVMVectorType(LLVMInt8TypeInContext(generator->context), 32)}).data(),
                 1, false
             )), new TypeFunc(basicTypes[BasicType::Int], {new TypeFuncArg(new TypeVector(basicTypes[BasicType::Char], 32), "v")}, false)};
         }
 
-        return LLVM::call(generator->functions["llvm.x86.avx2.pmovmskb"], std::vector<LLVMValueRef>({value.value}).data(), 1, "vMoveMask256");
+        return LLVM::call(generator->functions[Symbol("llvm.x86.avx2.pmovmskb")], std::vector<LLVMValueRef>({value.value}).data(), 1, "vMoveMask256");
     }
     else if (name == "vSqrt") {
         requireMinArgs(1);
@@ -638,15 +632,15 @@ RaveValue NodeBuiltin::generate() {
 
         std::string vecFuncName = "llvm.sqrt.v" + std::to_string(((TypeVector*)value.type)->count) + (vectorType->type == BasicType::Float ? "f32" : "f64");
 
-        if (generator->functions.find(vecFuncName) == generator->functions.end()) {
-            generator->functions[vecFuncName] = {LLVMAddFunction(generator->lModule, vecFuncName.c_str(), LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup(vecFuncName)) == generator->functions.end()) {
+            generator->functions[Symbol(vecFuncName)] = {LLVMAddFunction(generator->lModule, vecFuncName.c_str(), LLVMFunctionType(
                 generator->genType(value.type, loc),
                 std::vector<LLVMTypeRef>({generator->genType(value.type, loc)}).data(),
                 1, false
             )), new TypeFunc(value.type, {new TypeFuncArg(value.type, "v")}, false)};
         }
 
-        return LLVM::call(generator->functions[vecFuncName], std::vector<LLVMValueRef>({value.value}).data(), 1, "vSqrt");
+        return LLVM::call(generator->functions[Symbol(vecFuncName)], std::vector<LLVMValueRef>({value.value}).data(), 1, "vSqrt");
     }
     else if (name == "vAbs") {
         requireMinArgs(1);
@@ -674,15 +668,15 @@ RaveValue NodeBuiltin::generate() {
 
         std::string vecFuncName = "llvm.abs.v" + std::to_string(((TypeVector*)value.type)->count) + (vectorType->type == BasicType::Short ? "i16" : "i32");
 
-        if (generator->functions.find(vecFuncName) == generator->functions.end()) {
-            generator->functions[vecFuncName] = {LLVMAddFunction(generator->lModule, vecFuncName.c_str(), LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup(vecFuncName)) == generator->functions.end()) {
+            generator->functions[Symbol(vecFuncName)] = {LLVMAddFunction(generator->lModule, vecFuncName.c_str(), LLVMFunctionType(
                 generator->genType(value.type, loc),
                 std::vector<LLVMTypeRef>({generator->genType(value.type, loc)}).data(),
                 1, false
             )), new TypeFunc(value.type, {new TypeFuncArg(value.type, "v"), new TypeFuncArg(basicTypes[BasicType::Bool], "poison")}, false)};
         }
 
-        return LLVM::call(generator->functions[vecFuncName], std::vector<LLVMValueRef>({value.value, LLVM::makeInt(1, 0, false)}).data(), 2, "vSqrt");
+        return LLVM::call(generator->functions[Symbol(vecFuncName)], std::vector<LLVMValueRef>({value.value, LLVM::makeInt(1, 0, false)}).data(), 2, "vSqrt");
     }
     else if (name == "cttz") {
         requireMinArgs(2);
@@ -695,15 +689,15 @@ RaveValue NodeBuiltin::generate() {
         LLVMTypeRef valueType = LLVMTypeOf(value.value);
         std::string funcName = std::string("llvm.cttz.") + LLVMPrintTypeToString(valueType);
 
-        if (generator->functions.find(funcName) == generator->functions.end()) {
-            generator->functions[funcName] = {LLVMAddFunction(generator->lModule, funcName.c_str(), LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup(funcName)) == generator->functions.end()) {
+            generator->functions[Symbol(funcName)] = {LLVMAddFunction(generator->lModule, funcName.c_str(), LLVMFunctionType(
                 valueType,
                 std::vector<LLVMTypeRef>({valueType, LLVMInt1TypeInContext(generator->context)}).data(),
                 2, false
             )), new TypeFunc(value.type, {new TypeFuncArg(value.type, "value"), new TypeFuncArg(new TypeBasic(BasicType::Bool), "isZeroPoison")}, false)};
         }
 
-        return LLVM::call(generator->functions[funcName], std::vector<LLVMValueRef>({value.value, isZeroPoison.value}).data(), 2, "cttz");
+        return LLVM::call(generator->functions[Symbol(funcName)], std::vector<LLVMValueRef>({value.value, isZeroPoison.value}).data(), 2, "cttz");
     }
     else if (name == "ctlz") {
         requireMinArgs(2);
@@ -716,15 +710,15 @@ RaveValue NodeBuiltin::generate() {
         LLVMTypeRef valueType = LLVMTypeOf(value.value);
         std::string funcName = std::string("llvm.ctlz.") + LLVMPrintTypeToString(valueType);
 
-        if (generator->functions.find(funcName) == generator->functions.end()) {
-            generator->functions[funcName] = {LLVMAddFunction(generator->lModule, funcName.c_str(), LLVMFunctionType(
+        if (generator->functions.find(Symbol::lookup(funcName)) == generator->functions.end()) {
+            generator->functions[Symbol(funcName)] = {LLVMAddFunction(generator->lModule, funcName.c_str(), LLVMFunctionType(
                 valueType,
                 std::vector<LLVMTypeRef>({valueType, LLVMInt1TypeInContext(generator->context)}).data(),
                 2, false
             )), new TypeFunc(value.type, {new TypeFuncArg(value.type, "value"), new TypeFuncArg(new TypeBasic(BasicType::Bool), "isZeroPoison")}, false)};
         }
 
-        return LLVM::call(generator->functions[funcName], std::vector<LLVMValueRef>({value.value, isZeroPoison.value}).data(), 2, "ctlz");
+        return LLVM::call(generator->functions[Symbol(funcName)], std::vector<LLVMValueRef>({value.value, isZeroPoison.value}).data(), 2, "ctlz");
     }
     else if (name == "alloca") {
         requireMinArgs(1);
@@ -813,17 +807,17 @@ Node* NodeBuiltin::comptime() {
     else if (int hab = handleAbstractBool(); hab != -1) return new NodeBool((bool)hab);
     else if (int hai = handleAbstractInt(); hai != -1) return new NodeInt(hai);
     else if (name == "getArgType") {
-        type = currScope->getVar("_RaveArg" + asNumber(1).to_string(), loc)->type;
+        type = currScope->getVar(Symbol("_RaveArg" + asNumber(1).to_string()), loc)->type;
         return new NodeType(type, loc);
     }
     else if (name == "getCurrArgType") {
-        type = currScope->getVar("_RaveArg" + std::to_string(generator->currentBuiltinArg), loc)->type;
+        type = currScope->getVar(Symbol("_RaveArg" + std::to_string(generator->currentBuiltinArg)), loc)->type;
         return new NodeType(type, loc);
     }
     else if (name == "contains") return new NodeBool(asStringIden(0).find(asStringIden(1)) != std::string::npos);
     else if (name == "hasMethod") {
         Type* ty = asType(0)->type;
-        if (generator->toReplace.find(ty->toString()) != generator->toReplace.end()) ty = generator->toReplace[ty->toString()];
+        if (generator->toReplace.find(Types::key(ty)) != generator->toReplace.end()) ty = generator->toReplace[Types::key(ty)];
 
         if (!instanceof<TypeStruct>(ty)) return new NodeBool(false);
         TypeStruct* tstruct = (TypeStruct*)ty;
@@ -840,7 +834,7 @@ Node* NodeBuiltin::comptime() {
             }
         }
 
-        auto it = AST::methodTable.find({tstruct->name, methodName});
+        auto it = AST::methodTable.find(Symbol::lookup(tstruct->name, methodName));
         if (it != AST::methodTable.end() && (fnType == nullptr)) return new NodeBool(true);
 
         return new NodeBool(false);
@@ -850,8 +844,8 @@ Node* NodeBuiltin::comptime() {
         if (!instanceof<TypeStruct>(ty)) return new NodeBool(false);
         TypeStruct* tstruct = (TypeStruct*)ty;
 
-        if (AST::structTable.find(tstruct->name) == AST::structTable.end()) return new NodeBool(false);
-        return new NodeBool(AST::structTable[tstruct->name]->destructor == nullptr);
+        if (AST::structTable.find(Symbol::lookup(tstruct->name)) == AST::structTable.end()) return new NodeBool(false);
+        return new NodeBool(AST::structTable[Symbol(tstruct->name)]->destructor == nullptr);
     }
     else if (name == "minOf") {
         requireMinArgs(1);
@@ -21,18 +21,16 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/debug.hpp"
 
 NodeCall::NodeCall(int loc, Node* func, std::vector<Node*> args)
-    : loc(loc), func(func), args(args) {}
-
-NodeCall::~NodeCall() {
-    delete func;
-    for (Node* arg : args) delete arg;
-}
+    : Node(NodeKind::Call), loc(loc), func(func), args(args) {}
 
 // Helper: check and generate function if needed
 inline void checkAndGenerate(std::string name) {
-    if (generator->functions.find(name) == generator->functions.end()) {
-        if (AST::funcTable.find(name) == AST::funcTable.end()) return;
-        AST::funcTable[name]->generate();
+    Symbol symbol = Symbol::lookup(name);
+
+    if (generator->functions.find(symbol) == generator->functions.end()) {
+        auto it = AST::funcTable.find(symbol);
+        if (it == AST::funcTable.end()) return;
+        it->second->generate();
     }
 }
 
@@ -41,8 +39,8 @@ inline std::vector<FuncArgSet> tfaToFas(std::vector<TypeFuncArg*> tfa) {
     std::vector<FuncArgSet> fas;
     for (auto* arg : tfa) {
         Type* type = arg->type;
-        while (generator->toReplace.find(type->toString()) != generator->toReplace.end())
-            type = generator->toReplace[type->toString()];
+        while (generator->toReplace.find(Types::key(type)) != generator->toReplace.end())
+            type = generator->toReplace[Types::key(type)];
         fas.push_back(FuncArgSet{.name = arg->name, .type = type});
     }
     return fas;
@@ -101,15 +99,15 @@ std::vector<RaveValue> Call::genParameters(std::vector<Node*>& arguments, std::v
     for (size_t i = 0; i < params.size(); i++) {
         if (instanceof<TypeStruct>(fas[i].type) && !instanceof<TypeStruct>(params[i].type)) {
             std::string name = fas[i].type->toString();
-            if (AST::structTable.find(name) != AST::structTable.end()) {
-                auto& operators = AST::structTable[name]->operators;
+            if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
+                auto& operators = AST::structTable[Symbol(name)]->operators;
                 if (operators.find(TokType::Equ) != operators.end()) {
                     Type* ty = operators[TokType::Equ].begin()->second->args[1].type;
                     if ((isBytePointer(ty) && isBytePointer(params[i].type)) || Types::typesEqual(ty, params[i].type)) {
                         RaveValue tempVariable = LLVM::alloc(fas[i].type, "getParameters_implicit_op_tempvar");
                         Predefines::handle(fas[i].type, new NodeDone(tempVariable), -1);
                         checkAndGenerate(operators[TokType::Equ].begin()->second->name);
-                        LLVM::call(generator->functions[operators[TokType::Equ].begin()->second->name], {tempVariable, params[i]}, "");
+                        LLVM::call(generator->functions[Symbol(operators[TokType::Equ].begin()->second->name)], {tempVariable, params[i]}, "");
                         params[i] = tempVariable;
                     }
                 }
@@ -171,8 +169,8 @@ std::vector<RaveValue> Call::genParameters(std::vector<Node*>& arguments, std::v
     std::vector<FuncArgSet> fas;
     for (const auto& arg : function->args) {
         Type* type = arg.type;
-        while (generator->toReplace.find(type->toString()) != generator->toReplace.end())
-            type = generator->toReplace[type->toString()];
+        while (generator->toReplace.find(Types::key(type)) != generator->toReplace.end())
+            type = generator->toReplace[Types::key(type)];
         fas.push_back(FuncArgSet{.name = arg.name, .type = type});
     }
     return Call::genParameters(arguments, byVals, fas,
@@ -180,9 +178,13 @@ std::vector<RaveValue> Call::genParameters(std::vector<Node*>& arguments, std::v
 }
 
 Node* Call::resolveAlias(const std::string& name) {
-    if (AST::aliasTable.find(name) != AST::aliasTable.end()) return AST::aliasTable[name];
-    if (currScope != nullptr && currScope->aliasTable.find(name) != currScope->aliasTable.end())
-        return currScope->aliasTable[name];
+    Symbol symbol = Symbol::lookup(name);
+    if (symbol.empty()) return nullptr;
+
+    if (auto it = AST::aliasTable.find(symbol); it != AST::aliasTable.end()) return it->second;
+    if (currScope != nullptr) {
+        if (auto it = currScope->aliasTable.find(symbol); it != currScope->aliasTable.end()) return it->second;
+    }
     return nullptr;
 }
 
@@ -203,8 +205,9 @@ RaveValue Call::callNamedFunction(int loc, const std::string& name, std::vector<
         }
     }
 
-    if (targetFunc == nullptr && AST::funcTable.find(name) != AST::funcTable.end()) {
-        NodeFunc* func = AST::funcTable[name];
+    auto funcIt = AST::funcTable.find(Symbol::lookup(name));
+    if (targetFunc == nullptr && funcIt != AST::funcTable.end()) {
+        NodeFunc* func = funcIt->second;
         if ((func->isVararg || func->isCdecl64 || func->isWin64) && func->args.size() <= arguments.size())
             targetFunc = func;
     }
@@ -247,8 +250,11 @@ RaveValue Call::callNamedFunction(int loc, const std::string& name, std::vector<
         }
     }
 
-    if (targetFunc == nullptr && AST::funcTable.find(name) != AST::funcTable.end())
-        targetFunc = AST::funcTable[name];
+    // The matching above can generate templates, so the table is searched again
+    if (targetFunc == nullptr) {
+        funcIt = AST::funcTable.find(Symbol::lookup(name));
+        if (funcIt != AST::funcTable.end()) targetFunc = funcIt->second;
+    }
 
     if (targetFunc == nullptr)
         generator->error("undefined function \033[1m" + name + "\033[22m!", loc);
@@ -259,10 +265,11 @@ RaveValue Call::callNamedFunction(int loc, const std::string& name, std::vector<
         std::vector<RaveValue> params = Call::genParameters(arguments, byVals, targetFunc, loc);
         std::string sTypes = typesToString(types);
 
-        if (generator->functions.find(targetFunc->name + sTypes) != generator->functions.end())
-            return LLVM::call(generator->functions[targetFunc->name + sTypes], params,
+        auto instanceIt = generator->functions.find(Symbol::lookup(targetFunc->name + sTypes));
+        if (instanceIt != generator->functions.end())
+            return LLVM::call(instanceIt->second, params,
                 (instanceof<TypeVoid>(targetFunc->type) ? "" : "callFunc"), byVals);
-        return LLVM::call(generator->functions[targetFunc->generateWithCtargs(Call::getParamsTypes(params))], params,
+        return LLVM::call(generator->functions[Symbol(targetFunc->generateWithCtargs(Call::getParamsTypes(params)))], params,
             (instanceof<TypeVoid>(targetFunc->type) ? "" : "callFunc"));
     }
 
@@ -278,7 +285,7 @@ RaveValue Call::callNamedFunction(int loc, const std::string& name, std::vector<
         if (specialized != nullptr) {
             checkAndGenerate(specialized->name);
             std::vector<RaveValue> params = Call::genParameters(arguments, byVals, specialized, loc);
-            return LLVM::call(generator->functions[specialized->name], params,
+            return LLVM::call(generator->functions[Symbol(specialized->name)], params,
                 (instanceof<TypeVoid>(specialized->type) ? "" : "callFunc"), byVals);
         }
 
@@ -342,7 +349,7 @@ RaveValue Call::callNamedFunction(int loc, const std::string& name, std::vector<
 
     checkAndGenerate(targetFunc->name);
     std::vector<RaveValue> params = Call::genParameters(arguments, byVals, targetFunc, loc);
-    return LLVM::call(generator->functions[targetFunc->name], params,
+    return LLVM::call(generator->functions[Symbol(targetFunc->name)], params,
         (instanceof<TypeVoid>(targetFunc->type) ? "" : "callFunc"), byVals);
 }
 
@@ -350,7 +357,7 @@ RaveValue Call::make(int loc, Node* function, std::vector<Node*> arguments) {
     DEBUG_LOG(Debug::Category::FuncCall, "Call::make - resolving call");
 
     if (instanceof<NodeIden>(function)) {
-        std::string& name = ((NodeIden*)function)->name;
+        Symbol name = ((NodeIden*)function)->name;
 
         Node* alias = Call::resolveAlias(name);
         if (alias != nullptr) return Call::make(loc, alias, arguments);
@@ -364,19 +371,19 @@ RaveValue Call::make(int loc, Node* function, std::vector<Node*> arguments) {
         if (name.find('<') != std::string::npos)
             return Call::callTemplateFunction(loc, name, arguments);
 
-        if (currScope->has("this")) {
+        if (currScope->has(Symbol::lookup("this"))) {
             // Check for method on this
             std::vector<int> byVals;
-            NodeVar* _this = currScope->getVar("this", loc);
+            NodeVar* _this = currScope->getVar(Symbol("this"), loc);
             if (instanceof<TypeStruct>(_this->type->getElType())) {
                 TypeStruct* _struct = (TypeStruct*)_this->type->getElType();
-                if (AST::structTable.find(_struct->name) != AST::structTable.end()) {
-                    for (auto& it : AST::structTable[_struct->name]->variables) {
+                if (AST::structTable.find(Symbol::lookup(_struct->name)) != AST::structTable.end()) {
+                    for (auto& it : AST::structTable[Symbol(_struct->name)]->variables) {
                         if (it->name == name && instanceof<TypeFunc>(it->type)) {
                             std::vector<FuncArgSet> fas = tfaToFas(((TypeFunc*)it->type)->args);
                             std::vector<RaveValue> params = Call::genParameters(arguments, byVals, fas,
                                 CallSettings{false, ((TypeFunc*)it->type)->isVarArg, loc});
-                            return LLVM::call(currScope->getWithoutLoad(it->name, loc), params,
+                            return LLVM::call(currScope->getWithoutLoad(Symbol(it->name), loc), params,
                                 (instanceof<TypeVoid>(it->type) ? "" : "callFunc"), byVals);
                         }
                     }
@@ -386,7 +393,7 @@ RaveValue Call::make(int loc, Node* function, std::vector<Node*> arguments) {
                 std::vector<RaveValue> params = Call::genParameters(arguments, byVals, methodf, loc);
                 if (instanceof<TypePointer>(params[0].type->getElType()))
                     params[0] = LLVM::load(params[0], "NodeCall_load", loc);
-                return LLVM::call(generator->functions[methodf->name], params,
+                return LLVM::call(generator->functions[Symbol(methodf->name)], params,
                     (instanceof<TypeVoid>(methodf->type) ? "" : "callFunc"), byVals);
             }
         }
@@ -426,8 +433,8 @@ Type* NodeCall::__getType(Node* _fn) {
 
         std::vector<Type*> types = Call::getTypes(args);
 
-        if (AST::funcTable.find((niden->name + typesToString(types))) != AST::funcTable.end())
-            return AST::funcTable[(((NodeIden*)_fn)->name + typesToString(types))]->getType();
+        if (AST::funcTable.find(Symbol::lookup((niden->name + typesToString(types)))) != AST::funcTable.end())
+            return AST::funcTable[Symbol((((NodeIden*)_fn)->name + typesToString(types)))]->getType();
         if (AST::funcTable.find(niden->name) != AST::funcTable.end())
             return AST::funcTable[((NodeIden*)_fn)->name]->type;
 
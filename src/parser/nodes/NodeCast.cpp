@@ -16,7 +16,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/llvm.hpp"
 #include <iostream>
 
-NodeCast::NodeCast(Type* type, Node* value, int loc) {
+NodeCast::NodeCast(Type* type, Node* value, int loc) : Node(NodeKind::Cast) {
     this->type = type;
     this->value = value;
     this->loc = loc;
@@ -29,11 +29,6 @@ void NodeCast::check() {
     value->check();
 }
 
-NodeCast::~NodeCast() {
-    if (this->value != nullptr) delete this->value;
-    if (this->type != nullptr && !instanceof<TypeBasic>(this->type) && !instanceof<TypeVoid>(this->type)) delete this->type;
-}
-
 Type* NodeCast::getType() {return this->type->copy();}
 Node* NodeCast::copy() {return new NodeCast(this->type->copy(), this->value->copy(), this->loc);}
 Node* NodeCast::comptime() {return nullptr;}
@@ -109,7 +104,7 @@ RaveValue NodeCast::generate() {
 
     if (instanceof<TypeStruct>(this->type)) {
         TypeStruct* tstruct = (TypeStruct*)this->type;
-        if (generator->toReplace.find(tstruct->name) != generator->toReplace.end()) return (new NodeCast(generator->toReplace[tstruct->name], this->value, this->loc))->generate();
+        if (generator->toReplace.find(Symbol::lookup(tstruct->name)) != generator->toReplace.end()) return (new NodeCast(generator->toReplace[Symbol(tstruct->name)], this->value, this->loc))->generate();
         RaveValue ptrResult = LLVM::alloc(result.type, "NodeCast_ptrResult");
         LLVMBuildStore(generator->builder, result.value, ptrResult.value);
         return LLVM::load({
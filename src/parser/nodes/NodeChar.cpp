@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utf8.h"
 #include <iostream>
 
-NodeChar::NodeChar(std::string value, bool isWide) {
+NodeChar::NodeChar(std::string value, bool isWide) : Node(NodeKind::Char) {
     this->value = value;
     this->isWide = isWide;
 }
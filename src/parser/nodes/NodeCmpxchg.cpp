@@ -8,13 +8,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utils.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodeCmpxchg::NodeCmpxchg(Node* ptr, Node* value1, Node* value2, int loc) : ptr(ptr), value1(value1), value2(value2), loc(loc) {}
-
-NodeCmpxchg::~NodeCmpxchg() {
-    if (ptr) delete ptr;
-    if (value1) delete value1;
-    if (value2) delete value2;
-}
+NodeCmpxchg::NodeCmpxchg(Node* ptr, Node* value1, Node* value2, int loc) : Node(NodeKind::Cmpxchg), ptr(ptr), value1(value1), value2(value2), loc(loc) {}
 
 Node* NodeCmpxchg::copy() { return new NodeCmpxchg(ptr->copy(), value1->copy(), value2->copy(), loc); }
 
@@ -14,7 +14,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utils.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodeComptime::NodeComptime(Node* node) : node(node) {}
+NodeComptime::NodeComptime(Node* node) : Node(NodeKind::Comptime), node(node) {}
 
 Node* NodeComptime::copy() { return new NodeComptime(node->copy()); }
 
@@ -51,4 +51,3 @@ Node* NodeComptime::comptime() {
 
 RaveValue NodeComptime::generate() { comptime(); return {}; }
 
-NodeComptime::~NodeComptime() { if (node) delete node; }
@@ -18,11 +18,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 // TODO: Recheck
 
 NodeConstStruct::NodeConstStruct(std::string name, std::vector<Node*> values, int loc) 
-    : structName(name), values(values), loc(loc) {}
-
-NodeConstStruct::~NodeConstStruct() {
-    for (Node* value : values) if (value) delete value;
-}
+    : Node(NodeKind::ConstStruct), structName(name), values(values), loc(loc) {}
 
 Type* NodeConstStruct::getType() {return new TypeStruct(structName);}
 Node* NodeConstStruct::comptime() {return this;}
@@ -30,7 +26,7 @@ Node* NodeConstStruct::copy() {return new NodeConstStruct(this->structName, this
 void NodeConstStruct::check() {isChecked = true;}
 
 RaveValue NodeConstStruct::generate() {
-    if (structName.find('<') != std::string::npos && AST::structTable.find(structName) == AST::structTable.end()) {
+    if (structName.find('<') != std::string::npos && AST::structTable.find(Symbol::lookup(structName)) == AST::structTable.end()) {
         const size_t lt = structName.find('<');
         std::string sTypes = structName.substr(lt + 1, structName.find('>') - lt - 1);
         Lexer tLexer(sTypes, 1);
@@ -47,10 +43,10 @@ RaveValue NodeConstStruct::generate() {
             if (tParser.peek()->type == TokType::Comma) tParser.next();
         }
 
-        AST::structTable[structName.substr(0, lt)]->genWithTemplate("<" + sTypes + ">", types);
+        AST::structTable[Symbol(structName.substr(0, lt))]->genWithTemplate("<" + sTypes + ">", types);
     }
 
-    if (AST::structTable.find(structName) == AST::structTable.end())
+    if (AST::structTable.find(Symbol::lookup(structName)) == AST::structTable.end())
         generator->error("structure \033[1m" + structName + "\033[22m does not exist!", loc);
 
     LLVMTypeRef constStructType = generator->genType(new TypeStruct(structName), loc);
@@ -65,11 +61,11 @@ RaveValue NodeConstStruct::generate() {
     }
 
     auto validateAndCast = [&](size_t i) {
-        Type* varType = AST::structTable[structName]->variables[i]->getType();
-        if (varType->toString() != llvmValues[i].type->toString()) {
+        Type* varType = AST::structTable[Symbol(structName)]->variables[i]->getType();
+        if (!Types::typesEqual(varType, llvmValues[i].type)) {
             if (instanceof<TypeBasic>(varType) && instanceof<TypeBasic>(llvmValues[i].type))
                 LLVM::cast(llvmValues[i], varType, loc);
-            else generator->error("incompatible types in constant structure: value of type \033[1m" + llvmValues[i].type->toString() + "\033[22m trying to be assigned to variable named \033[1m" + AST::structTable[structName]->variables[i]->name + "\033[22m of type \033[1m" + varType->toString() + "\033[22m!", loc);
+            else generator->error("incompatible types in constant structure: value of type \033[1m" + llvmValues[i].type->toString() + "\033[22m trying to be assigned to variable named \033[1m" + AST::structTable[Symbol(structName)]->variables[i]->name + "\033[22m of type \033[1m" + varType->toString() + "\033[22m!", loc);
         }
     };
 
@@ -86,7 +82,7 @@ RaveValue NodeConstStruct::generate() {
 
     for (size_t i=0; i<llvmValues.size(); i++) {
         validateAndCast(i);
-        Binary::operation(TokType::Equ, new NodeGet(new NodeDone(temp), AST::structTable[structName]->variables[i]->name, true, loc), new NodeDone(llvmValues[i]), loc);
+        Binary::operation(TokType::Equ, new NodeGet(new NodeDone(temp), AST::structTable[Symbol(structName)]->variables[i]->name, true, loc), new NodeDone(llvmValues[i]), loc);
     }
 
     return LLVM::load(temp, "constStruct_tempLoad", loc);
@@ -67,7 +67,7 @@ void Defer::make(Node* value, bool isFunctionScope) {
     }
 }
 
-NodeDefer::NodeDefer(int loc, Node* instruction, bool isFunctionScope) {
+NodeDefer::NodeDefer(int loc, Node* instruction, bool isFunctionScope) : Node(NodeKind::Defer) {
     this->instruction = instruction;
     this->loc = loc;
     this->isFunctionScope = isFunctionScope;
@@ -81,6 +81,4 @@ Node* NodeDefer::comptime() { return this; }
 
 Node* NodeDefer::copy() { return new NodeDefer(loc, instruction->copy(), isFunctionScope); }
 
-NodeDefer::~NodeDefer() { if (instruction) delete instruction; }
-
 RaveValue NodeDefer::generate() { Defer::make(instruction, isFunctionScope); return {}; }
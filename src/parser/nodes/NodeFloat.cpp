@@ -11,12 +11,12 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <iostream>
 
 NodeFloat::NodeFloat(double value, TypeBasic* type, bool isDouble) 
-    : value(std::to_string(value)), type(type) {
+    : Node(NodeKind::Float), value(std::to_string(value)), type(type) {
     if (isDouble && !type) this->type = basicTypes[BasicType::Double];
 }
 
 NodeFloat::NodeFloat(std::string value, TypeBasic* type) 
-    : value(value), type(type) {}
+    : Node(NodeKind::Float), value(value), type(type) {}
 
 Type* NodeFloat::getType() {
     if (type) return type;
@@ -14,10 +14,11 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeBlock.hpp"
 #include "../../include/parser/nodes/NodeForeach.hpp"
 #include "../../include/parser/nodes/NodeIf.hpp"
+#include "../../include/parser/nodes/NodeInt.hpp"
 #include "../../include/parser/ast.hpp"
 #include <iostream>
 
-NodeFor::NodeFor(std::vector<Node*> presets, Node* cond, std::vector<Node*> afters, NodeBlock* block, int loc) {
+NodeFor::NodeFor(std::vector<Node*> presets, Node* cond, std::vector<Node*> afters, NodeBlock* block, int loc) : Node(NodeKind::For) {
     this->presets = std::vector<Node*>(presets);
     this->cond = cond;
     this->afters = std::vector<Node*>(afters);
@@ -25,19 +26,14 @@ NodeFor::NodeFor(std::vector<Node*> presets, Node* cond, std::vector<Node*> afte
     this->loc = loc;
 }
 
-NodeFor::~NodeFor() {
-    for (size_t i=0; i<presets.size(); i++) if (presets[i] != nullptr) delete presets[i];
-    if (cond != nullptr) delete cond;
-    if (block != nullptr) delete block;
-    for (size_t i=0; i<afters.size(); i++) if (afters[i] != nullptr) delete afters[i];
-}
-
 Node* NodeFor::copy() {
     std::vector<Node*> presets;
     std::vector<Node*> afters;
     for (size_t i=0; i<this->presets.size(); i++) presets.push_back(this->presets[i]->copy());
     for (size_t i=0; i<this->afters.size(); i++) afters.push_back(this->afters[i]->copy());
-    return new NodeFor(presets, (NodeBinary*)(this->cond->copy()), this->afters, (NodeBlock*)(this->block->copy()), this->loc);
+    NodeFor* nfor = new NodeFor(presets, (NodeBinary*)(this->cond->copy()), this->afters, (NodeBlock*)(this->block->copy()), this->loc);
+    nfor->mods = this->mods;
+    return nfor;
 }
 
 Node* NodeFor::comptime() { return this; }
@@ -46,6 +42,19 @@ void NodeFor::check() { isChecked = true; }
 
 Type* NodeFor::getType() { return typeVoid; }
 
+// for (...; i < bound; i++) with a bound without side effects: i stays below the bound in the body
+bool NodeFor::isCounted() {
+    if (afters.size() != 1 || !instanceof<NodeBinary>(cond) || !instanceof<NodeBinary>(afters[0])) return false;
+
+    NodeBinary* step = (NodeBinary*)afters[0];
+    if (step->op != TokType::PluEqu || !instanceof<NodeIden>(step->first) || !instanceof<NodeInt>(step->second) || ((NodeInt*)step->second)->value != 1) return false;
+
+    NodeBinary* test = (NodeBinary*)cond;
+    if ((test->op != TokType::Less && test->op != TokType::LessEqual) || !instanceof<NodeIden>(test->first)) return false;
+
+    return ((NodeIden*)test->first)->name == ((NodeIden*)step->first)->name && NodeWhile::isPure(cond);
+}
+
 RaveValue NodeFor::generate() {
     for (size_t i=0; i<this->presets.size(); i++) {
         this->presets[i]->check();
@@ -55,13 +64,15 @@ RaveValue NodeFor::generate() {
     for (size_t i=0; i<this->afters.size(); i++) this->block->nodes.push_back(this->afters[i]);
 
     NodeWhile* nwhile = new NodeWhile(this->cond, this->block, this->loc);
+    nwhile->isCounted = isCounted();
+    nwhile->mods = mods;
     nwhile->check();
     RaveValue result = nwhile->generate();
 
     for (size_t i=0; i<this->presets.size(); i++) {
         if (instanceof<NodeVar>(this->presets[i])) {
             NodeVar* nvar = (NodeVar*)this->presets[i];
-            currScope->remove(nvar->name);
+            currScope->remove(Symbol(nvar->name));
         }
     }
 
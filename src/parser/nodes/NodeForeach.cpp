@@ -19,25 +19,23 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeIndex.hpp"
 #include "../../include/parser/nodes/NodeInt.hpp"
 #include "../../include/parser/nodes/NodeIf.hpp"
+#include "../../include/parser/nodes/NodeCast.hpp"
+#include "../../include/parser/nodes/NodeDone.hpp"
 #include <iostream>
 
-NodeForeach::NodeForeach(NodeIden* elName, Node* varData, Node* varLength, NodeBlock* block, int loc) {
+NodeForeach::NodeForeach(NodeIden* elName, Node* varData, Node* varLength, NodeBlock* block, int loc, bool isReference) : Node(NodeKind::Foreach) {
     this->elName = elName;
+    this->isReference = isReference;
     this->varData = varData;
     this->varLength = varLength;
     this->block = block;
     this->loc = loc;
 }
 
-NodeForeach::~NodeForeach() {
-    if (elName != nullptr) delete elName;
-    if (varData != nullptr) delete varData;
-    if (varLength != nullptr) delete varLength;
-    if (block != nullptr) delete block;
-}
-
 Node* NodeForeach::copy() {
-    return new NodeForeach((NodeIden*)elName->copy(), varData->copy(), (varLength != nullptr ? varLength->copy() : nullptr), (NodeBlock*)block->copy(), loc);
+    NodeForeach* nforeach = new NodeForeach((NodeIden*)elName->copy(), varData->copy(), (varLength != nullptr ? varLength->copy() : nullptr), (NodeBlock*)block->copy(), loc, isReference);
+    nforeach->mods = mods;
+    return nforeach;
 }
 
 Node* NodeForeach::comptime() { return nullptr; }
@@ -52,8 +50,8 @@ RaveValue NodeForeach::generate() {
             NodeIden* niVarData = (NodeIden*)varData;
             if (instanceof<TypeStruct>(niVarData->getType())) {
                 TypeStruct* ts = (TypeStruct*)niVarData->getType();
-                if (AST::structTable.find(ts->name) != AST::structTable.end()) {
-                    NodeStruct* ns = (NodeStruct*)AST::structTable[ts->name];
+                if (AST::structTable.find(Symbol::lookup(ts->name)) != AST::structTable.end()) {
+                    NodeStruct* ns = (NodeStruct*)AST::structTable[Symbol(ts->name)];
                     if (ns->dataVar == "" || ns->lengthVar == "") {
                         generator->error("structure \033[1m" + ts->name + "\033[22m does not contain the parameters data or length!", loc);
                         return {};
@@ -65,28 +63,56 @@ RaveValue NodeForeach::generate() {
         }
     }
 
-    NodeVar* nv = new NodeVar("__RAVE_FOREACH_N" + std::to_string(loc), new NodeInt(0), false, false, false, {}, loc, basicTypes[BasicType::Int], false, false, false);
-    nv->check();
-    nv->generate();
+    // The data pointer and the length are evaluated once, so the loop is a canonical counted loop over an usize index
+    std::string counter = "__RAVE_FOREACH_N" + std::to_string(loc);
+    std::string data = "__RAVE_FOREACH_DATA" + std::to_string(loc);
+    std::string length = "__RAVE_FOREACH_LENGTH" + std::to_string(loc);
+    Type* usize = getTypeByName("usize");
+
+    std::vector<NodeVar*> vars = {new NodeVar(counter, new NodeInt(0), false, false, false, {}, loc, usize, false, false, false)};
+
+    // Arrays are indexed in place instead of being copied
+    bool isDataPointer = instanceof<TypePointer>(varData->getType());
+    if (isDataPointer) vars.push_back(new NodeVar(data, varData, false, false, false, {}, loc, new TypeAuto(), false, false, false));
+
+    for (NodeVar* var : vars) {
+        var->check();
+        var->generate();
+        var->isUsed = true;
+    }
+
+    // A negative signed length is an empty loop instead of a huge usize one
+    Node* lengthValue = varLength;
+    Type* lengthType = Types::stripConst(varLength->getType());
+    if (instanceof<TypeBasic>(lengthType) && !((TypeBasic*)lengthType)->isUnsigned() && !isFloatType(lengthType)) {
+        RaveValue value = varLength->generate();
+        LLVMValueRef isNegative = LLVMBuildICmp(generator->builder, LLVMIntSLT, value.value, LLVMConstNull(LLVMTypeOf(value.value)), "isNegative");
+        value.value = LLVMBuildSelect(generator->builder, isNegative, LLVMConstNull(LLVMTypeOf(value.value)), value.value, "clamped");
+        lengthValue = new NodeDone(value);
+    }
+
+    vars.push_back(new NodeVar(length, new NodeCast(usize, lengthValue, loc), false, false, false, {}, loc, usize, false, false, false));
+    vars.back()->check();
+    vars.back()->generate();
+    vars.back()->isUsed = true;
+
+    Node* element = new NodeIndex(isDataPointer ? new NodeIden(data, loc) : varData, {new NodeIden(counter, loc)}, loc);
+    if (isReference) element = new NodeUnary(loc, TokType::Amp, element);
 
     NodeBlock* oldBlock = (NodeBlock*)block->copy();
-    block->nodes = {
-        new NodeVar(
-            elName->name, new NodeIndex(varData,
-                {new NodeIden("__RAVE_FOREACH_N" + std::to_string(loc), loc)
-            }, loc),
-        false, false, false, {}, loc, new TypeAuto(), false, false, false)
-    };
+    block->nodes = {new NodeVar(elName->name, element, false, false, false, {}, loc, new TypeAuto(), false, false, false)};
 
     for (size_t i=0; i<oldBlock->nodes.size(); i++) block->nodes.push_back(oldBlock->nodes[i]);
 
-    block->nodes.push_back(new NodeBinary(TokType::PluEqu, new NodeIden("__RAVE_FOREACH_N" + std::to_string(loc), loc), new NodeInt(1), loc));
+    block->nodes.push_back(new NodeBinary(TokType::PluEqu, new NodeIden(counter, loc), new NodeInt(1), loc));
 
-    NodeWhile* nwhile = new NodeWhile(new NodeBinary(TokType::Less, new NodeIden("__RAVE_FOREACH_N" + std::to_string(loc), loc), varLength, loc), block, loc);
+    NodeWhile* nwhile = new NodeWhile(new NodeBinary(TokType::Less, new NodeIden(counter, loc), new NodeIden(length, loc), loc), block, loc);
+    nwhile->isCounted = true;
+    nwhile->mods = mods;
     nwhile->check();
-    RaveValue result = nwhile->generate();
+    nwhile->generate();
 
-    currScope->remove("__RAVE_FOREACH_N" + std::to_string(loc));
+    for (NodeVar* var : vars) currScope->remove(Symbol(var->name));
 
     return {};
 }
@@ -16,7 +16,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/debug.hpp"
 
 NodeFunc::NodeFunc(const std::string& name, std::vector<FuncArgSet> args, NodeBlock* block,
-                   bool isExtern, std::vector<DeclarMod> mods, int loc, Type* type, std::vector<std::string> templateNames) {
+                   bool isExtern, std::vector<DeclarMod> mods, int loc, Type* type, std::vector<std::string> templateNames) : Node(NodeKind::Func) {
     this->name = name;
     this->origName = name;
     this->args = std::vector<FuncArgSet>(args);
@@ -39,14 +39,6 @@ NodeFunc::NodeFunc(const std::string& name, std::vector<FuncArgSet> args, NodeBl
     }
 }
 
-NodeFunc::~NodeFunc() {
-    if (block != nullptr) delete block;
-    if (type != nullptr && !instanceof<TypeVoid>(type) && !instanceof<TypeBasic>(type)) { delete type; type = nullptr; }
-    for (size_t i = 0; i < args.size(); i++)
-        if (args[i].type != nullptr && !instanceof<TypeVoid>(args[i].type) && !instanceof<TypeBasic>(args[i].type))
-            delete args[i].type;
-}
-
 void NodeFunc::check() {
     if (isChecked) return;
     isChecked = true;
@@ -77,14 +69,14 @@ void NodeFunc::check() {
     if (!namespacesNames.empty() && !isNoNamespaces) name = namespacesToString(namespacesNames, name);
 
     // Check for existing function
-    if (auto it = AST::funcTable.find(name); it != AST::funcTable.end()) {
+    if (auto it = AST::funcTable.find(Symbol::lookup(name)); it != AST::funcTable.end()) {
         if (it->second->isForwardDeclaration) {
             isInfluencedByFD = true;
-            AST::funcTable[name] = this;
+            AST::funcTable[Symbol(name)] = this;
 
-            for (size_t i = 0; i < AST::funcVersionsTable[name].size(); i++) {
-                if (AST::funcVersionsTable[name][i]->isForwardDeclaration) {
-                    AST::funcVersionsTable[name].erase(AST::funcVersionsTable[name].begin() + i);
+            for (size_t i = 0; i < AST::funcVersionsTable[Symbol(name)].size(); i++) {
+                if (AST::funcVersionsTable[Symbol(name)][i]->isForwardDeclaration) {
+                    AST::funcVersionsTable[Symbol(name)].erase(AST::funcVersionsTable[Symbol(name)].begin() + i);
                     break;
                 }
             }
@@ -93,7 +85,7 @@ void NodeFunc::check() {
             if (!structContext.empty()) FuncRegistry::instance().registerMethod(this, structContext);
             else FuncRegistry::instance().registerFunc(this);
 
-            for (auto node : block->nodes) node->check();
+            if (!isBlockShared) for (auto node : block->nodes) node->check();
             return;
         }
 
@@ -106,20 +98,20 @@ void NodeFunc::check() {
             if (!it->second->isForwardDeclaration)
                 AST::checkError("a function with name \033[1m" + name + "\033[22m already exists on \033[1m" +
                     std::to_string(it->second->loc) + "\033[22m line!", loc);
-            AST::funcVersionsTable[name].push_back(this);
+            AST::funcVersionsTable[Symbol(name)].push_back(this);
         }
         else {
-            AST::funcVersionsTable[name].push_back(this);
+            AST::funcVersionsTable[Symbol(name)].push_back(this);
             name += argTypes;
         }
     }
-    else AST::funcVersionsTable[name].push_back(this);
+    else AST::funcVersionsTable[Symbol(name)].push_back(this);
 
     // Store the mangled name for LLVM
     mangledName = name;
 
     // Register function in legacy table
-    AST::funcTable[name] = this;
+    AST::funcTable[Symbol(name)] = this;
 
     // Register with FuncRegistry
     if (!structContext.empty()) FuncRegistry::instance().registerMethod(this, structContext);
@@ -129,11 +121,22 @@ void NodeFunc::check() {
     if (block == nullptr) {
         if (!isExtern) isForwardDeclaration = true;
     }
-    else {
+    else if (!isBlockShared) {
         for (auto node : block->nodes) node->check();
     }
 }
 
+// Copies the shared body before it is changed; the check() skipped for it is done here
+NodeBlock* NodeFunc::ownBlock() {
+    if (isBlockShared) {
+        isBlockShared = false;
+        block = (NodeBlock*)block->copy();
+        if (isChecked) for (auto node : block->nodes) node->check();
+    }
+
+    return block;
+}
+
 Node* NodeFunc::comptime() { return this; }
 Type* NodeFunc::getType() { return type; }
 
@@ -141,8 +144,15 @@ Node* NodeFunc::copy() {
     std::vector<FuncArgSet> args = this->args;
     for (size_t i = 0; i < args.size(); i++) args[i].type = args[i].type->copy();
 
-    NodeFunc* fn = new NodeFunc(name, args, (block == nullptr ? nullptr : (NodeBlock*)block->copy()),
+    // Parsed modules are never changed, so the copies of their functions share the body until they check or generate it
+    bool shareBlock = block != nullptr && Arena::owner(this) == &AST::parsedArena;
+
+    NodeFunc* fn = new NodeFunc(name, args, (block == nullptr || shareBlock ? nullptr : (NodeBlock*)block->copy()),
         isExtern, mods, loc, type->copy(), templateNames);
+    if (shareBlock) {
+        fn->block = block;
+        fn->isBlockShared = true;
+    }
     fn->isExplicit = isExplicit;
     return fn;
 }
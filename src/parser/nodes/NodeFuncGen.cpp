@@ -19,8 +19,10 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeStruct.hpp"
 #include "../../include/parser/ast.hpp"
 #include "../../include/parser/FuncRegistry.hpp"
+#include "../../include/parser/Checks.hpp"
 #include "../../include/compiler.hpp"
 #include "../../include/debug.hpp"
+#include "../../include/timeTrace.hpp"
 #include <llvm-c/Analysis.h>
 #include <llvm-c/DebugInfo.h>
 #include <llvm-c/Comdat.h>
@@ -42,13 +44,13 @@ void NodeFunc::processModifiers(int& callConv, NodeArray*& conditions) {
     DEBUG_LOG(Debug::Category::CodeGen, "Processing modifiers for function: " + name);
 
     for (size_t i = 0; i < mods.size(); i++) {
-        while (AST::aliasTable.find(mods[i].name) != AST::aliasTable.end()) {
-            if (instanceof<NodeArray>(AST::aliasTable[mods[i].name])) {
-                NodeArray* array = (NodeArray*)AST::aliasTable[mods[i].name];
+        while (AST::aliasTable.find(Symbol::lookup(mods[i].name)) != AST::aliasTable.end()) {
+            if (instanceof<NodeArray>(AST::aliasTable[Symbol(mods[i].name)])) {
+                NodeArray* array = (NodeArray*)AST::aliasTable[Symbol(mods[i].name)];
                 mods[i].name = ((NodeString*)array->values[0])->value;
                 mods[i].value = array->values[1];
             }
-            else mods[i].name = ((NodeString*)AST::aliasTable[mods[i].name])->value;
+            else mods[i].name = ((NodeString*)AST::aliasTable[Symbol(mods[i].name)])->value;
         }
 
         if (mods[i].name == "C") linkName = name;
@@ -79,17 +81,17 @@ void NodeFunc::processModifiers(int& callConv, NodeArray*& conditions) {
 void NodeFunc::createLLVMFunction(TypeFunc* tfunc, int callConv) {
     DEBUG_LOG(Debug::Category::CodeGen, "Creating LLVM function: " + name);
 
-    generator->functions[name] = {LLVMAddFunction(
+    generator->functions[Symbol(name)] = {LLVMAddFunction(
         generator->lModule, linkName.c_str(),
         LLVMFunctionType(generator->genType(tfunc->main, loc), genTypes.data(), genTypes.size(), isVararg)
     ), tfunc};
 
     if (isPrivate && !isExtern) {
-        LLVMSetLinkage(generator->functions[name].value, LLVMInternalLinkage);
+        LLVMSetLinkage(generator->functions[Symbol(name)].value, LLVMInternalLinkage);
         if (generator->settings.optLevel > 2 && !generator->settings.noPrivateInlining) isInline = true;
     }
 
-    LLVMSetFunctionCallConv(generator->functions[name].value, callConv);
+    LLVMSetFunctionCallConv(generator->functions[Symbol(name)].value, callConv);
 
     size_t inTCount = 0;
     for (size_t i = 0; i < args.size(); i++) {
@@ -97,25 +99,25 @@ void NodeFunc::createLLVMFunction(TypeFunc* tfunc, int callConv) {
             for (size_t j = 0; j < args[i].internalTypes.size(); j++) {
                 inTCount += 1;
                 if (!(args[i].internalTypes.empty()) && instanceof<TypeByval>(args[i].internalTypes[0])) {
-                    generator->addTypeAttr("byval", inTCount, generator->functions[name].value, loc, generator->genType(args[i].type, loc));
-                    generator->addAttr("align", inTCount, generator->functions[name].value, loc, 8);
+                    generator->addTypeAttr("byval", inTCount, generator->functions[Symbol(name)].value, loc, generator->genType(args[i].type, loc));
+                    generator->addAttr("align", inTCount, generator->functions[Symbol(name)].value, loc, 8);
                 }
             }
         }
         else inTCount += 1;
     }
 
-    if (isInline) generator->addAttr("alwaysinline", LLVMAttributeFunctionIndex, generator->functions[name].value, loc);
+    if (isInline) generator->addAttr("alwaysinline", LLVMAttributeFunctionIndex, generator->functions[Symbol(name)].value, loc);
     else if (isNoOpt) {
-        generator->addAttr("noinline", LLVMAttributeFunctionIndex, generator->functions[name].value, loc);
-        generator->addAttr("optnone", LLVMAttributeFunctionIndex, generator->functions[name].value, loc);
+        generator->addAttr("noinline", LLVMAttributeFunctionIndex, generator->functions[Symbol(name)].value, loc);
+        generator->addAttr("optnone", LLVMAttributeFunctionIndex, generator->functions[Symbol(name)].value, loc);
     }
 
     if (isTemplatePart || isTemplate || isCtargsPart || isComdat) {
         LLVMComdatRef comdat = LLVMGetOrInsertComdat(generator->lModule, linkName.c_str());
         LLVMSetComdatSelectionKind(comdat, LLVMAnyComdatSelectionKind);
-        LLVMSetComdat(generator->functions[name].value, comdat);
-        LLVMSetLinkage(generator->functions[name].value, LLVMLinkOnceODRLinkage);
+        LLVMSetComdat(generator->functions[Symbol(name)].value, comdat);
+        LLVMSetLinkage(generator->functions[Symbol(name)].value, LLVMLinkOnceODRLinkage);
         isExtern = false;
     }
 }
@@ -134,7 +136,7 @@ void NodeFunc::createDebugInfo() {
         name.c_str(), name.length(), linkName.c_str(), linkName.length(), debugInfo->diFile,
         loc, funcType, isPrivate, !isExtern, loc, LLVMDIFlagZero, generator->settings.optLevel > 0);
 
-    LLVMSetSubprogram(generator->functions[name].value, diFuncScope);
+    LLVMSetSubprogram(generator->functions[Symbol(name)].value, diFuncScope);
 }
 
 void NodeFunc::generateParameterDebugInfo(LLVMBasicBlockRef entry) {
@@ -151,7 +153,7 @@ void NodeFunc::generateParameterDebugInfo(LLVMBasicBlockRef entry) {
     LLVMPositionBuilderAtEnd(generator->builder, entry);
     generator->currBB = entry;
 
-    LLVMValueRef param = LLVMGetParam(generator->functions[name].value, 0);
+    LLVMValueRef param = LLVMGetParam(generator->functions[Symbol(name)].value, 0);
     for (size_t i = 0; i < args.size(); i++) {
         LLVMMetadataRef paramType = debugInfo->genType(args[i].type, loc);
         LLVMMetadataRef paramVar = LLVMDIBuilderCreateParameterVariable(
@@ -169,7 +171,7 @@ void NodeFunc::generateParameterDebugInfo(LLVMBasicBlockRef entry) {
             debugInfo->diBuilder, addr, paramVar, emptyExpr, debugLoc, entry);
 
         if (i + 1 < args.size())
-            param = LLVMGetParam(generator->functions[name].value, i + 1);
+            param = LLVMGetParam(generator->functions[Symbol(name)].value, i + 1);
     }
 
     LLVMDisposeBuilder(generator->builder);
@@ -194,7 +196,7 @@ LLVMTypeRef* NodeFunc::getParameters(int callConv) {
                     int tSize = arg.type->getSize();
 
                     if (((TypeStruct*)arg.type)->isSimple()) {
-                        TypeBasic* tArgType = (TypeBasic*)AST::structTable[arg.type->toString()]->variables[0]->type;
+                        TypeBasic* tArgType = (TypeBasic*)AST::structTable[Symbol(arg.type->toString())]->variables[0]->type;
                         int tElCount = ((TypeStruct*)arg.type)->getElCount();
 
                         switch (tElCount) {
@@ -224,7 +226,8 @@ LLVMTypeRef* NodeFunc::getParameters(int callConv) {
                 }
             }
             else if (block != nullptr) {
-                block->nodes.insert(block->nodes.begin(),
+                NodeBlock* body = ownBlock();
+                body->nodes.insert(body->nodes.begin(),
                     new NodeVar(oldName, new NodeIden(arg.name, loc), false, false, false, {}, loc, arg.type, false, false, false));
             }
         }
@@ -254,6 +257,8 @@ RaveValue NodeFunc::generate() {
         return {};
     }
 
+    TIME_TRACE_SCOPE("Function", name);
+
     Types::replaceComptime(type);
     for (size_t i = 0; i < args.size(); i++) Types::replaceComptime(args[i].type);
 
@@ -271,11 +276,11 @@ RaveValue NodeFunc::generate() {
     if (!isTemplate && isCtargs) return {};
     if (isForwardDeclaration) return {};
 
-    std::unordered_map<std::string, Type*> oldReplace = std::unordered_map<std::string, Type*>(generator->toReplace);
+    std::unordered_map<Symbol, Type*> oldReplace = std::unordered_map<Symbol, Type*>(generator->toReplace);
     if (isTemplate) {
         generator->toReplace.clear();
         for (size_t i = 0; i < templateNames.size(); i++)
-            generator->toReplace[templateNames[i]] = templateTypes[i];
+            generator->toReplace[Symbol(templateNames[i])] = templateTypes[i];
     }
 
     if (conditions != nullptr) {
@@ -318,7 +323,7 @@ RaveValue NodeFunc::generate() {
 
     LLVMValueRef fn = LLVMGetNamedFunction(generator->lModule, linkName.c_str());
     if (fn != nullptr) {
-        generator->functions[name] = {fn, tfunc};
+        generator->functions[Symbol(name)] = {fn, tfunc};
         return {};
     }
 
@@ -326,6 +331,8 @@ RaveValue NodeFunc::generate() {
     createDebugInfo();
 
     if (!isExtern) {
+        ownBlock();
+
         int oldCurrentBuiltinArg = generator->currentBuiltinArg;
         if (isCtargsPart || isCtargs) generator->currentBuiltinArg = 0;
 
@@ -345,11 +352,11 @@ RaveValue NodeFunc::generate() {
 
         if (!Compiler::settings.noFastMath) LLVM::setFastMath(generator->builder, true, false, true, true);
 
-        std::unordered_map<std::string, int> indexes;
-        std::unordered_map<std::string, NodeVar*> vars;
+        std::unordered_map<Symbol, int> indexes;
+        std::unordered_map<Symbol, NodeVar*> vars;
         for (size_t i = 0; i < args.size(); i++) {
-            indexes.insert({args[i].name, i});
-            vars.insert({args[i].name, new NodeVar(args[i].name, nullptr, false, true, false, {}, loc, args[i].type, false, false, false)});
+            indexes.insert({Symbol(args[i].name), i});
+            vars.insert({Symbol(args[i].name), new NodeVar(args[i].name, nullptr, false, true, false, {}, loc, args[i].type, false, false, false)});
         }
 
         Scope* oldScope = currScope;
@@ -374,12 +381,12 @@ RaveValue NodeFunc::generate() {
 
         if (!currScope->funcHasRet) LLVMBuildBr(generator->builder, exitBlock);
 
-        LLVMMoveBasicBlockAfter(exitBlock, LLVMGetLastBasicBlock(generator->functions[name].value));
+        LLVMMoveBasicBlockAfter(exitBlock, LLVMGetLastBasicBlock(generator->functions[Symbol(name)].value));
 
         // Ensure all basic blocks have terminators
-        uint32_t bbLength = LLVMCountBasicBlocks(generator->functions[currScope->funcName].value);
+        uint32_t bbLength = LLVMCountBasicBlocks(generator->functions[Symbol(currScope->funcName)].value);
         LLVMBasicBlockRef* basicBlocks = (LLVMBasicBlockRef*)malloc(sizeof(LLVMBasicBlockRef) * bbLength);
-        LLVMGetBasicBlocks(generator->functions[currScope->funcName].value, basicBlocks);
+        LLVMGetBasicBlocks(generator->functions[Symbol(currScope->funcName)].value, basicBlocks);
         for (size_t i = 0; i < bbLength; i++) {
             if (basicBlocks[i] != nullptr && std::string(LLVMGetBasicBlockName(basicBlocks[i])) != "exit" &&
                 LLVMGetBasicBlockTerminator(basicBlocks[i]) == nullptr) {
@@ -393,28 +400,30 @@ RaveValue NodeFunc::generate() {
 
         Defer::emit(currScope);
 
-        if (!instanceof<TypeVoid>(type)) LLVMBuildRet(generator->builder, currScope->get("return", loc).value);
+        if (!instanceof<TypeVoid>(type)) LLVMBuildRet(generator->builder, currScope->get(Symbol("return"), loc).value);
         else LLVMBuildRetVoid(generator->builder);
 
+        Checks::finish(generator->functions[Symbol(name)].value);
+
         currScope = oldScope;
         generator->builder = oldBuilder;
         generator->currBB = oldCurrBB;
         generator->currentBuiltinArg = oldCurrentBuiltinArg;
     }
 
-    if (isTemplate) generator->toReplace = std::unordered_map<std::string, Type*>(oldReplace);
+    if (isTemplate) generator->toReplace = std::unordered_map<Symbol, Type*>(oldReplace);
 
     if (!isExtern && generator->settings.outDebugInfo) debugInfo->popScope();
 
     if (generator->settings.outDebugInfo) LLVMDIBuilderFinalizeSubprogram(debugInfo->diBuilder, diFuncScope);
 
-    if (LLVMVerifyFunction(generator->functions[name].value, LLVMPrintMessageAction)) {
-        std::string content = LLVMPrintValueToString(generator->functions[name].value);
+    if (LLVMVerifyFunction(generator->functions[Symbol(name)].value, LLVMPrintMessageAction)) {
+        std::string content = LLVMPrintValueToString(generator->functions[Symbol(name)].value);
         if (content.length() > 12000) content = content.substr(0, 12000) + "...";
         generator->error("LLVM errors into the function \033[1m" + name + "\033[22m! Content:\n" + content, loc);
     }
 
-    return generator->functions[name];
+    return generator->functions[Symbol(name)];
 }
 
 std::string NodeFunc::generateWithCtargs(std::vector<Type*> args) {
@@ -453,6 +462,7 @@ std::string NodeFunc::generateWithCtargs(std::vector<Type*> args) {
 
 RaveValue NodeFunc::generateWithTemplate(std::vector<Type*>& types, const std::string& all) {
     DEBUG_LOG(Debug::Category::Template, "Generating function with template: " + all);
+    TIME_TRACE_SCOPE("Instantiate function", all);
 
     auto activeLoops = std::unordered_map<int32_t, Loop>(generator->activeLoops);
     auto builder = generator->builder;
@@ -479,7 +489,7 @@ RaveValue NodeFunc::generateWithTemplate(std::vector<Type*>& types, const std::s
 
     if (isMethod) {
         Type* structType = instanceof<TypePointer>(args[0].type) ? args[0].type->getElType() : args[0].type;
-        AST::methodTable[std::pair<std::string, std::string>(structType->toString(), all)] = _f;
+        AST::methodTable[std::pair<Symbol, Symbol>(structType->toString(), all)] = _f;
     }
 
     generator->activeLoops = activeLoops;
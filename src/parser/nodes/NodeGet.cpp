@@ -24,17 +24,13 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  * @param isMustBePtr: Flag indicating if result must be a pointer
  * @param loc: Source line number
  */
-NodeGet::NodeGet(Node* base, std::string field, bool isMustBePtr, int loc) {
+NodeGet::NodeGet(Node* base, std::string field, bool isMustBePtr, int loc) : Node(NodeKind::Get) {
     this->base = base;
     this->field = field;
     this->isMustBePtr = isMustBePtr;
     this->loc = loc;
 }
 
-NodeGet::~NodeGet() {
-    if (base != nullptr) delete base;
-}
-
 Type* NodeGet::getType() {
     Type* baseType = this->base->getType();
     TypeStruct* ts = nullptr;
@@ -56,14 +52,14 @@ Type* NodeGet::getType() {
     Types::replaceTemplates((Type**)&ts);
 
     const std::string& structName = ts->name;
-    auto memberKey = std::make_pair(structName, field);
+    auto memberKey = Symbol::lookup(structName, field);
 
     if (auto methodIt = AST::methodTable.find(memberKey); methodIt != AST::methodTable.end()) return methodIt->second->getType();
 
     if (auto structIt = AST::structMembersTable.find(memberKey); structIt != AST::structMembersTable.end()) return structIt->second.var->getType();
 
     if (field.find('<') != std::string::npos) {
-        memberKey = std::make_pair(structName, field.substr(0, field.find('<')));
+        memberKey = Symbol::lookup(structName, field.substr(0, field.find('<')));
         if (auto methodIt = AST::methodTable.find(memberKey); methodIt != AST::methodTable.end()) return methodIt->second->getType();
     }
 
@@ -86,8 +82,7 @@ RaveValue NodeGet::checkStructure(RaveValue ptr) {
     while (instanceof<TypePointer>(ptr.type->getElType())) ptr = LLVM::load(ptr, "NodeGet_checkStructure_load", loc);
 
     // Apply type replacements if needed
-    const std::string typeStr = ptr.type->getElType()->toString();
-    if (auto it = generator->toReplace.find(typeStr); it != generator->toReplace.end())
+    if (auto it = generator->toReplace.find(Types::key(ptr.type->getElType())); it != generator->toReplace.end())
         static_cast<TypePointer*>(ptr.type)->instance = it->second;
     
     return ptr;
@@ -98,19 +93,19 @@ RaveValue NodeGet::checkStructure(RaveValue ptr) {
  * Optimized with combined lookup and const detection
  */
 RaveValue NodeGet::checkIn(std::string structure) {
-    if (auto structIt = AST::structTable.find(structure); structIt == AST::structTable.end()) {
+    if (auto structIt = AST::structTable.find(Symbol::lookup(structure)); structIt == AST::structTable.end()) {
         generator->error("structure \033[1m" + structure + "\033[22m does not exist!", loc);
         return {};
     }
 
-    const auto memberKey = std::make_pair(structure, field);
+    const auto memberKey = Symbol::lookup(structure, field);
 
     if (auto numberIt = AST::structMembersTable.find(memberKey); numberIt != AST::structMembersTable.end()) {
         elementIsConst = instanceof<TypeConst>(numberIt->second.var->type);
         return {nullptr, nullptr};
     } 
     
-    if (auto methodIt = AST::methodTable.find(memberKey); methodIt != AST::methodTable.end()) return generator->functions[methodIt->second->name];
+    if (auto methodIt = AST::methodTable.find(memberKey); methodIt != AST::methodTable.end()) return generator->functions[Symbol(methodIt->second->name)];
 
     generator->error("structure \033[1m" + structure + "\033[22m does not contain element \033[1m" + field + "\033[22m!", loc);
     return {};
@@ -159,7 +154,7 @@ RaveValue NodeGet::generate() {
     if (RaveValue f = checkIn(structName); f.value) return f;
 
     // Generate struct member access
-    const int fieldNumber = AST::structMembersTable[std::make_pair(structName, field)].number;
+    const int fieldNumber = AST::structMembersTable[std::pair<Symbol, Symbol>(structName, field)].number;
     RaveValue memberPtr = LLVM::structGep(ptr, fieldNumber, "NodeGet_generate_ptr");
 
     if (isMustBePtr) {
@@ -11,27 +11,27 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeGet.hpp"
 
 NodeIden::NodeIden(std::string name, int loc, bool isMustBePtr) 
-    : name(name), loc(loc), isMustBePtr(isMustBePtr) {}
+    : Node(NodeKind::Iden), name(name), loc(loc), isMustBePtr(isMustBePtr) {}
 
-NodeIden::NodeIden(std::string name, int loc) : name(name), loc(loc), isMustBePtr(false) {}
+NodeIden::NodeIden(std::string name, int loc) : Node(NodeKind::Iden), name(name), loc(loc), isMustBePtr(false) {}
 
 Node* NodeIden::copy() { return new NodeIden(name, loc, isMustBePtr); }
 
 void NodeIden::check() { isChecked = true; }
 
 Type* getIdenType(std::string idenName, int loc) {
-    if (auto it = AST::aliasTable.find(idenName); it != AST::aliasTable.end()) return it->second->getType();
-    if (auto it = AST::funcTable.find(idenName); it != AST::funcTable.end()) return it->second->getType();
+    if (auto it = AST::aliasTable.find(Symbol::lookup(idenName)); it != AST::aliasTable.end()) return it->second->getType();
+    if (auto it = AST::funcTable.find(Symbol::lookup(idenName)); it != AST::funcTable.end()) return it->second->getType();
 
-    if (!currScope->has(idenName) && !currScope->hasAtThis(idenName)) {
-        if (auto it = generator->toReplace.find(idenName); it != generator->toReplace.end()) 
+    if (!currScope->has(Symbol::lookup(idenName)) && !currScope->hasAtThis(Symbol::lookup(idenName))) {
+        if (auto it = generator->toReplace.find(Symbol::lookup(idenName)); it != generator->toReplace.end()) 
             return getIdenType(it->second->toString(), loc);
 
         generator->error("unknown identifier \033[1m" + idenName + "\033[22m!", loc);
         return nullptr;
     }
 
-    return currScope->getVar(idenName, loc)->getType();
+    return currScope->getVar(Symbol(idenName), loc)->getType();
 }
 
 Type* NodeIden::getType() { return getIdenType(name, loc); }
@@ -52,7 +52,7 @@ Node* NodeIden::comptime() {
 RaveValue NodeIden::generate() {
     if (auto it = AST::aliasTable.find(name); it != AST::aliasTable.end()) return it->second->generate();
 
-    if (auto it = generator->globals.find(name); it != generator->globals.end()) {
+    if (auto it = generator->findGlobal(name); it != generator->globals.end()) {
         AST::varTable[name]->isUsed = true;
         return isMustBePtr ? it->second : LLVM::load(it->second, "NodeIden_load", loc);
     }
@@ -16,7 +16,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeStruct.hpp"
 #include "../../include/utils.hpp"
 
-NodeIf::NodeIf(Node* cond, Node* body, Node* _else, int loc, bool isStatic) : cond(cond), body(body), _else(_else), loc(loc), isStatic(isStatic), isLikely(false), isUnlikely(false) {}
+NodeIf::NodeIf(Node* cond, Node* body, Node* _else, int loc, bool isStatic) : Node(NodeKind::If), cond(cond), body(body), _else(_else), loc(loc), isStatic(isStatic), isLikely(false), isUnlikely(false) {}
 
 Type* NodeIf::getType() { return typeVoid; }
 
@@ -43,17 +43,7 @@ RaveValue NodeIf::generate() {
 
     RaveValue condValue = cond->generate();
 
-    if (isLikely || isUnlikely) {
-        if (generator->functions.find("llvm.expect.i1") == generator->functions.end()) {
-            generator->functions["llvm.expect.i1"] = {LLVMAddFunction(generator->lModule, "llvm.expect.i1", LLVMFunctionType(
-            LLVMInt1TypeInContext(generator->context),
-            std::vector<LLVMTypeRef>({LLVMInt1TypeInContext(generator->context), LLVMInt1TypeInContext(generator->context)}).data(),
-            2, false
-            )), new TypeFunc(basicTypes[BasicType::Bool], {new TypeFuncArg(basicTypes[BasicType::Bool], "v1"), new TypeFuncArg(basicTypes[BasicType::Bool], "v2")}, false)};
-        }
-
-        LLVM::call(generator->functions["llvm.expect.i1"], {condValue, {LLVM::makeInt(1, isLikely ? 1 : 0, false), basicTypes[BasicType::Bool]}}, isLikely ? "likely" : "unlikely");
-    }
+    if (isLikely || isUnlikely) LLVM::expect(condValue, isLikely, isLikely ? "likely" : "unlikely");
 
     LLVMBuildCondBr(generator->builder, condValue.value, thenBlock, elseBlock);
     debugInfo->setInstrLoc(loc);
@@ -96,7 +86,7 @@ RaveValue NodeIf::generate() {
        LLVMGetPreviousInstruction(lastInstr) &&
        LLVMGetInstructionOpcode(LLVMGetPreviousInstruction(lastInstr)) == LLVMBr) LLVMInstructionEraseFromParent(lastInstr);
 
-    if (hasEnd1 && hasEnd2 && generator->activeLoops.size() == 0) LLVMBuildRet(generator->builder, LLVMConstNull(generator->genType(AST::funcTable[currScope->funcName]->type, this->loc)));
+    if (hasEnd1 && hasEnd2 && generator->activeLoops.size() == 0) LLVMBuildRet(generator->builder, LLVMConstNull(generator->genType(AST::funcTable[Symbol(currScope->funcName)]->type, this->loc)));
     
     return {};
 }
@@ -154,8 +144,3 @@ Node* NodeIf::copy() {
     return _if;
 }
 
-NodeIf::~NodeIf() {
-    if (cond) delete cond;
-    if (body) delete body;
-    if (_else) delete _else;
-}
@@ -16,10 +16,12 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/ast.hpp"
 #include "../../include/lexer/lexer.hpp"
 #include "../../include/parser/parser.hpp"
+#include "../../include/parser/ASTCache.hpp"
 #include <algorithm>
 #include <fstream>
 #include <chrono>
 #include "../../include/compiler.hpp"
+#include "../../include/timeTrace.hpp"
 
 #ifdef _WIN32
    #include <io.h> 
@@ -43,7 +45,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #  endif
 #endif
 
-NodeImport::NodeImport(ImportFile file, std::vector<std::string> functions, int loc) {
+NodeImport::NodeImport(ImportFile file, std::vector<std::string> functions, int loc) : Node(NodeKind::Import) {
     this->file = file;
     this->functions = functions;
     this->loc = loc;
@@ -78,6 +80,8 @@ RaveValue NodeImport::generate() {
         return {};
     }
 
+    TIME_TRACE_SCOPE("Import", file.file);
+
     if (AST::parsed.find(file.file) == AST::parsed.end()) {
         if (!fs::exists(file.file)) {
             generator->error("file \033[1m" + file.file + "\033[22m does not exist!", this->loc);
@@ -87,23 +91,38 @@ RaveValue NodeImport::generate() {
         std::ifstream fContent(file.file);
         std::string content((std::istreambuf_iterator<char>(fContent)), std::istreambuf_iterator<char>());
 
-        content = "alias __RAVE_IMPORTED_FROM = \"" + generator->file + "\"; " + content;
-
         auto start = std::chrono::steady_clock::now();
-        Lexer lexer(content, 1);
-        auto end = std::chrono::steady_clock::now();
-        Compiler::lexTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-
-        start = end;
-        Parser parser = Parser(lexer.tokens, file.file);
-        parser.importDirectories = Compiler::settings.importDirectories;
-        parser.parseAll();
-        end = std::chrono::steady_clock::now();
-        Compiler::parseTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-
-        AST::parsed[file.file] = parser.nodes;
+        std::vector<Node*> nodes;
+        Arena::Scope arenaScope(&AST::parsedArena);
+
+        TimeTrace::begin("Load AST cache", file.file);
+        bool isCached = ASTCache::load(file.file, content, nodes);
+        TimeTrace::end();
+
+        if (isCached) {
+            auto end = std::chrono::steady_clock::now();
+            Compiler::parseTime += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        else {
+            Lexer lexer("alias __RAVE_IMPORTED_FROM = \"" + generator->file + "\"; " + content, 1);
+            auto end = std::chrono::steady_clock::now();
+            Compiler::lexTime += std::chrono::duration<double, std::milli>(end - start).count();
+
+            start = end;
+            Parser parser = Parser(lexer.tokens, file.file);
+            parser.importDirectories = Compiler::settings.importDirectories;
+            parser.parseAll();
+            end = std::chrono::steady_clock::now();
+            Compiler::parseTime += std::chrono::duration<double, std::milli>(end - start).count();
+
+            nodes = parser.nodes;
+            ASTCache::save(file.file, content, nodes);
+        }
+
+        AST::parsed[file.file] = nodes;
     }
 
+    // Functions keep sharing their bodies with the parsed nodes until they need them, see NodeFunc::ownBlock()
     std::vector<Node*> buffer;
     for (const auto& node : AST::parsed[file.file]) buffer.push_back(node->copy());
 
@@ -128,7 +147,6 @@ RaveValue NodeImport::generate() {
 
     std::string oldFile = generator->file;
     generator->file = file.file;
-    auto start = std::chrono::steady_clock::now();
 
     for (auto* node : buffer) {
         if (instanceof<NodeFunc>(node)) {
@@ -141,6 +159,12 @@ RaveValue NodeImport::generate() {
             auto* nodeVar = static_cast<NodeVar*>(node);
             if (nodeVar->isPrivate) continue;
             nodeVar->isExtern = true;
+
+            // Aliases are needed right away, everything else is declared on its first use
+            if (!instanceof<TypeAlias>(nodeVar->type)) {
+                generator->lazyGlobals[Symbol(nodeVar->name)] = nodeVar;
+                continue;
+            }
         }
         else if (instanceof<NodeStruct>(node)) {
             auto* nodeStruct = static_cast<NodeStruct*>(node);
@@ -159,14 +183,12 @@ RaveValue NodeImport::generate() {
         node->generate();
     }
 
-    auto end = std::chrono::steady_clock::now();
-    Compiler::genTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     generator->file = oldFile;
     AST::importedFiles.push_back(file.file);
     return {};
 }
 
-NodeImports::NodeImports(std::vector<NodeImport*> imports, int loc) {
+NodeImports::NodeImports(std::vector<NodeImport*> imports, int loc) : Node(NodeKind::Imports) {
     this->imports = std::vector<NodeImport*>(imports);
     this->loc = loc;
 }
@@ -14,29 +14,22 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeStruct.hpp"
 #include "../../include/parser/nodes/NodeInt.hpp"
 #include "../../include/parser/nodes/NodeFunc.hpp"
-#include "../../include/parser/nodes/NodeBinary.hpp"
 #include "../../include/parser/nodes/NodeDone.hpp"
-#include "../../include/parser/nodes/NodeNull.hpp"
 #include "../../include/parser/nodes/NodeBuiltin.hpp"
-#include "../../include/parser/nodes/NodeString.hpp"
 #include "../../include/parser/ast.hpp"
+#include "../../include/parser/Checks.hpp"
 #include <vector>
 #include <string>
 #include "../../include/utils.hpp"
 #include "../../include/parser/Types.hpp"
 #include "../../include/llvm.hpp"
 
-NodeIndex::NodeIndex(Node* element, std::vector<Node*> indexes, int loc) {
+NodeIndex::NodeIndex(Node* element, std::vector<Node*> indexes, int loc) : Node(NodeKind::Index) {
     this->element = element;
     this->indexes = indexes;
     this->loc = loc;
 }
 
-NodeIndex::~NodeIndex() {
-    if (element != nullptr) delete element;
-    for (size_t i=0; i<indexes.size(); i++) if (indexes[i] != nullptr) delete indexes[i];
-}
-
 Type* NodeIndex::getType() {
     // Get base type and strip const qualifiers
     Type* type = element->getType();
@@ -46,7 +39,7 @@ Type* NodeIndex::getType() {
 
     if (instanceof<TypeStruct>(type) || (instanceof<TypePointer>(type) && instanceof<TypeStruct>(type->getElType()))) {
         TypeStruct* tstruct = static_cast<TypeStruct*>(type->getElType());
-        auto& operators = AST::structTable[tstruct->name]->operators;
+        auto& operators = AST::structTable[Symbol(tstruct->name)]->operators;
         auto it = operators.find(TokType::Rbra);
         if (it != operators.end() && !it->second.empty()) return it->second.begin()->second->type;
     }
@@ -97,20 +90,6 @@ bool NodeIndex::isElementConst(Type* type) {
     return false;
 }
 
-void checkForNull(RaveValue ptr, int loc) {
-    if (!generator->settings.noChecks && generator->settings.optLevel <= 2 && !LLVMIsAConstant(ptr.value) &&
-        (AST::funcTable.find(currScope->funcName) == AST::funcTable.end() || !AST::funcTable[currScope->funcName]->isNoChecks)
-    ) {
-        auto assertFunc = AST::funcTable.find("std::assert[_b_pc]");
-        if (assertFunc != AST::funcTable.end()) {
-            Call::make(loc, new NodeIden(assertFunc->second->name, loc), {
-                new NodeBinary(TokType::Nequal, new NodeDone(ptr), new NodeNull(nullptr, loc), loc),
-                new NodeString("Assert in '" + generator->file + "' file in function '" + currScope->funcName + "' at " + std::to_string(loc) + " line: trying to get a value from a null pointer!\n", false)
-            });
-        }
-    }
-}
-
 RaveValue checkForOverload(bool isMustBePtr, Type* _type, Node* node, Node* index, int loc) {
     while (instanceof<TypeConst>(_type)) _type = static_cast<TypeConst*>(_type)->instance;
 
@@ -124,8 +103,8 @@ RaveValue checkForOverload(bool isMustBePtr, Type* _type, Node* node, Node* inde
         if (instanceof<TypeStruct>(tstruct)) {
             std::string structName = ((TypeStruct*)tstruct)->name;
 
-            if (AST::structTable.find(structName) != AST::structTable.end()) {
-                auto& operators = AST::structTable[structName]->operators;
+            if (AST::structTable.find(Symbol::lookup(structName)) != AST::structTable.end()) {
+                auto& operators = AST::structTable[Symbol(structName)]->operators;
 
                 if (isMustBePtr && operators.find('&') != operators.end())
                     return Call::make(loc, new NodeIden(operators['&'].begin()->second->name, loc), {node, index});
@@ -174,7 +153,7 @@ RaveValue NodeIndex::generate() {
         if (instanceof<TypeArray>(ptr.type) && instanceof<TypeArray>(currScope->getWithoutLoad(id->name, this->loc).type)) LLVM::makeAsPointer(ptr);
         else if (!instanceof<TypePointer>(ptr.type)) ptr = currScope->getWithoutLoad(id->name, this->loc);
 
-        checkForNull(ptr, loc);
+        Checks::nullPointer(ptr, loc);
 
         RaveValue index = generator->byIndex(ptr, this->generateIndexes());
 
@@ -248,7 +227,7 @@ RaveValue NodeIndex::generate() {
             return result;
         }
 
-        checkForNull(vr, loc);
+        Checks::nullPointer(vr, loc);
 
         RaveValue index = generator->byIndex(vr, this->generateIndexes());
         if (isMustBePtr) {
@@ -292,7 +271,7 @@ RaveValue NodeIndex::generate() {
             return result;
         }
 
-        checkForNull(val, loc);
+        Checks::nullPointer(val, loc);
 
         RaveValue index = generator->byIndex(val, this->generateIndexes());
         if (isMustBePtr) {
@@ -334,8 +313,8 @@ RaveValue NodeIndex::generate() {
         if ((nunary->type == TokType::Amp) && (instanceof<TypeStruct>(nunaryType) || (instanceof<TypePointer>(nunaryType) && instanceof<TypeStruct>(((TypePointer*)nunaryType)->instance)))) {
             TypeStruct* tstruct = instanceof<TypeStruct>(nunaryType) ? (TypeStruct*)nunaryType : (TypeStruct*)(((TypePointer*)nunaryType)->instance);
             
-            if (AST::structTable.find(tstruct->name) != AST::structTable.end()) {
-                auto& operators = AST::structTable[tstruct->name]->operators;
+            if (AST::structTable.find(Symbol::lookup(tstruct->name)) != AST::structTable.end()) {
+                auto& operators = AST::structTable[Symbol(tstruct->name)]->operators;
                 if (operators.find('&') != operators.end()) {
                     std::unordered_map<std::string, NodeFunc*> functions = operators['&'];
                     Node* value = nunary;
@@ -347,7 +326,7 @@ RaveValue NodeIndex::generate() {
 
         RaveValue val = nunary->generate();
 
-        checkForNull(val, loc);
+        Checks::nullPointer(val, loc);
 
         RaveValue index = generator->byIndex(val, this->generateIndexes());
         debugInfo->setInstrLoc(this->loc);
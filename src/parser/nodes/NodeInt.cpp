@@ -11,11 +11,11 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <iostream>
 
 NodeInt::NodeInt(BigInt value, unsigned char sys) 
-    : value(value), sys(sys), type(BasicType::Int), isVarVal(nullptr), 
+    : Node(NodeKind::Int), value(value), sys(sys), type(BasicType::Int), isVarVal(nullptr), 
       isUnsigned(false), isMustBeLong(false), isMustBeChar(false), isMustBeShort(false) {}
 
 NodeInt::NodeInt(BigInt value, char type, Type* isVarVal, unsigned char sys, bool isUnsigned, bool isMustBeLong)
-    : value(value), type(type), sys(sys), isVarVal(isVarVal), 
+    : Node(NodeKind::Int), value(value), type(type), sys(sys), isVarVal(isVarVal), 
       isUnsigned(isUnsigned), isMustBeLong(isMustBeLong), isMustBeChar(false), isMustBeShort(false) {}
 
 Node* NodeInt::comptime() { return this; }
@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeItop.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodeItop::NodeItop(Node* value, Type* type, int loc) : value(value), type(type), loc(loc) {}
+NodeItop::NodeItop(Node* value, Type* type, int loc) : Node(NodeKind::Itop), value(value), type(type), loc(loc) {}
 
 Type* NodeItop::getType() { return type->copy(); }
 
@@ -31,7 +31,3 @@ RaveValue NodeItop::generate() {
     return result;
 }
 
-NodeItop::~NodeItop() {
-    if (type && !instanceof<TypeBasic>(type) && !instanceof<TypeVoid>(type)) delete type;
-    if (value) delete value;
-}
@@ -8,18 +8,13 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeLambda.hpp"
 #include "../../include/parser/nodes/NodeFunc.hpp"
 
-NodeLambda::NodeLambda(int loc, TypeFunc* tf, NodeBlock* block, std::string name) {
+NodeLambda::NodeLambda(int loc, TypeFunc* tf, NodeBlock* block, std::string name) : Node(NodeKind::Lambda) {
     this->loc = loc;
     this->tf = tf;
     this->block = block;
     this->name = name;
 }
 
-NodeLambda::~NodeLambda() {
-    if (tf != nullptr) delete tf;
-    if (block != nullptr) delete block;
-}
-
 Type* NodeLambda::getType() {return (Type*)this->tf;}
 Node* NodeLambda::copy() {return new NodeLambda(loc, (TypeFunc*)this->tf->copy(), (NodeBlock*)this->block->copy(), this->name);}
 Node* NodeLambda::comptime() {return this;}
@@ -47,7 +42,7 @@ RaveValue NodeLambda::generate() {
     for (const auto& arg : _args) fas.emplace_back(FuncArgSet{.name = arg->name, .type = arg->type});
 
     const auto lambdaId = generator->lambdas++;
-    AST::lambdaTable["lambda" + std::to_string(lambdaId)] = this;
+    AST::lambdaTable[Symbol("lambda" + std::to_string(lambdaId))] = this;
 
     auto nf = new NodeFunc("__RAVE_LAMBDA" + std::to_string(lambdaId), fas, block, false, {}, this->loc, this->type, {});
     nf->isComdat = true;
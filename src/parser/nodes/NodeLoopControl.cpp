@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/debug.hpp"
 #include <string>
 
-NodeLoopControl::NodeLoopControl(LoopControlKind kind, int loc) : kind(kind), loc(loc) {}
+NodeLoopControl::NodeLoopControl(LoopControlKind kind, int loc) : Node(NodeKind::LoopControl), kind(kind), loc(loc) {}
 
 void NodeLoopControl::check() {
     isChecked = true;
@@ -123,27 +123,23 @@ void addNamespaceNames(Node* node, std::vector<std::string>& names, bool isImpor
     }
 }
 
-NodeNamespace::NodeNamespace(std::string name, std::vector<Node*> nodes, int loc) {
+NodeNamespace::NodeNamespace(std::string name, std::vector<Node*> nodes, int loc) : Node(NodeKind::Namespace) {
     this->loc = loc;
     this->nodes = std::vector<Node*>(nodes);
     this->names = std::vector<std::string>();
     this->names.push_back(name);
 }
 
-NodeNamespace::NodeNamespace(std::vector<std::string> names, std::vector<Node*> nodes, int loc) {
+NodeNamespace::NodeNamespace(std::vector<std::string> names, std::vector<Node*> nodes, int loc) : Node(NodeKind::Namespace) {
     this->loc = loc;
     this->nodes = std::vector<Node*>(nodes);
     this->names = std::vector<std::string>();
     for (size_t i=0; i<names.size(); i++) this->names.push_back(names[i]);
 }
 
-NodeNamespace::~NodeNamespace() {
-    for (size_t i=0; i<nodes.size(); i++) if (nodes[i] != nullptr) delete nodes[i];
-}
-
 Node* NodeNamespace::copy() {
     std::vector<Node*> cNodes;
-    for (size_t i=0; i<nodes.size(); i++) cNodes.push_back(nodes[i]);
+    for (size_t i=0; i<nodes.size(); i++) cNodes.push_back(nodes[i]->copy());
     return new NodeNamespace(std::vector<std::string>(names), cNodes, loc);
 }
 
@@ -276,7 +272,8 @@ RaveValue NodeNamespace::generate() {
             }
 
             nvar->isExtern = (nvar->isExtern || isImported);
-            nvar->generate();
+            if (isImported && !instanceof<TypeAlias>(nvar->type)) generator->lazyGlobals[Symbol(nvar->name)] = nvar;
+            else nvar->generate();
         }
         else if (instanceof<NodeStruct>(nodes[i])) {
             NodeStruct* nstruct = (NodeStruct*)nodes[i];
@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeCast.hpp"
 #include <iostream>
 
-NodeNull::NodeNull(Type* type, int loc) : type(type), loc(loc) {}
+NodeNull::NodeNull(Type* type, int loc) : Node(NodeKind::Null), type(type), loc(loc) {}
 
 Type* NodeNull::getType() { return (!type ? new TypePointer(basicTypes[BasicType::Char]) : type); }
 
@@ -25,6 +25,3 @@ Node* NodeNull::comptime() { return this; }
 
 Node* NodeNull::copy() { return new NodeNull(type, loc); }
 
-NodeNull::~NodeNull() {
-    if (type && !instanceof<TypeBasic>(type) && !instanceof<TypeVoid>(type)) delete type;
-}
@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodePtoi.hpp"
 #include "../../include/parser/ast.hpp"
 
-NodePtoi::NodePtoi(Node* value, int loc) : value(value), loc(loc) {}
+NodePtoi::NodePtoi(Node* value, int loc) : Node(NodeKind::Ptoi), value(value), loc(loc) {}
 
 Type* NodePtoi::getType() { return basicTypes[pointerSize == 64 ? BasicType::Long : pointerSize == 32 ? BasicType::Int : BasicType::Short]; }
 
@@ -40,4 +40,3 @@ RaveValue NodePtoi::generate() {
     return result;
 }
 
-NodePtoi::~NodePtoi() { if (value) delete value; }
@@ -12,7 +12,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeIden.hpp"
 #include "../../include/parser/nodes/NodeVar.hpp"
 
-NodeRet::NodeRet(Node* value, int loc) : value(!value ? nullptr : value->copy()), loc(loc) {}
+NodeRet::NodeRet(Node* value, int loc) : Node(NodeKind::Ret), value(!value ? nullptr : value->copy()), loc(loc) {}
 
 Node* NodeRet::copy() { return new NodeRet(value->copy(), loc); }
 
@@ -20,8 +20,6 @@ Type* NodeRet::getType() { return value->getType(); }
 
 Node* NodeRet::comptime() { return this; }
 
-NodeRet::~NodeRet() { if (value) delete value; }
-
 void NodeRet::check() { isChecked = true; }
 
 Loop NodeRet::getParentBlock(int n) {
@@ -37,17 +35,17 @@ void NodeRet::setParentBlock(Loop value, int n) {
 }
 
 RaveValue NodeRet::generate() {
-    if (currScope == nullptr || !currScope->has("return")) { value->generate(); return {}; }
+    if (currScope == nullptr || !currScope->has(Symbol::lookup("return"))) { value->generate(); return {}; }
 
-    if (!value) value = new NodeNull(currScope->getVar("return", loc)->getType(), loc);
+    if (!value) value = new NodeNull(currScope->getVar(Symbol("return"), loc)->getType(), loc);
 
     RaveValue generated = value->generate();
 
     if (instanceof<TypeVoid>(generated.type)) generator->error("cannot return a \033[1mvoid\033[22m value in a non-void function!", loc);
 
-    RaveValue ptr = currScope->getWithoutLoad("return", loc);
+    RaveValue ptr = currScope->getWithoutLoad(Symbol("return"), loc);
 
-    if (generated.type->toString() == ptr.type->toString()) generated = LLVM::load(generated, "NodeRet_load", loc);
+    if (Types::typesEqual(generated.type, ptr.type)) generated = LLVM::load(generated, "NodeRet_load", loc);
 
     LLVMBuildStore(generator->builder, generated.value, ptr.value);
     debugInfo->setInstrLoc(loc);
@@ -9,7 +9,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeString.hpp"
 #include "../../include/parser/nodes/NodeType.hpp"
 
-NodeSizeof::NodeSizeof(Node* value, int loc) : value(value), loc(loc) {}
+NodeSizeof::NodeSizeof(Node* value, int loc) : Node(NodeKind::Sizeof), value(value), loc(loc) {}
 
 Type* NodeSizeof::getType() { return basicTypes[BasicType::Int]; }
 
@@ -46,6 +46,3 @@ RaveValue NodeSizeof::generate() {
     return { LLVMSizeOf(LLVMTypeOf(value->generate().value)), basicTypes[BasicType::Long] };
 }
 
-NodeSizeof::~NodeSizeof() {
-    if (value) delete value;
-}
@@ -20,7 +20,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/ast.hpp"
 #include "../../include/llvm.hpp"
 
-NodeSlice::NodeSlice(Node* base, Node* start, Node* end, int loc) {
+NodeSlice::NodeSlice(Node* base, Node* start, Node* end, int loc) : Node(NodeKind::Slice) {
     this->base = base;
     this->start = start;
     this->end = end;
@@ -39,12 +39,6 @@ Node* NodeSlice::comptime() {return this;}
 Node* NodeSlice::copy() {return new NodeSlice(this->base, this->start, this->end, this->loc);}
 void NodeSlice::check() {isChecked = true;}
 
-NodeSlice::~NodeSlice() {
-    if (this->base != nullptr) delete this->base;
-    if (this->start != nullptr) delete this->start;
-    if (this->end != nullptr) delete this->end;
-}
-
 RaveValue NodeSlice::generate() {
     if (instanceof<NodeIden>(base)) ((NodeIden*)base)->isMustBePtr = false;
     else if (instanceof<NodeGet>(base)) ((NodeGet*)base)->isMustBePtr = false;
@@ -61,11 +55,11 @@ RaveValue NodeSlice::generate() {
         if (instanceof<TypeStruct>(base->getType())) {
             std::string _struct = base->getType()->toString();
     
-            if (AST::structTable.find(_struct) != AST::structTable.end()) {
-                NodeStruct* _structPtr = AST::structTable[_struct];
+            if (AST::structTable.find(Symbol::lookup(_struct)) != AST::structTable.end()) {
+                NodeStruct* _structPtr = AST::structTable[Symbol(_struct)];
                 if (_structPtr->operators.find(TokType::Rbra) != _structPtr->operators.end()) {
                     equNode = new NodeCall(
-                        this->loc, new NodeIden(AST::structTable[_struct]->operators[TokType::Rbra][_structPtr->operators[TokType::Rbra].begin()->first]->name, this->loc),
+                        this->loc, new NodeIden(AST::structTable[Symbol(_struct)]->operators[TokType::Rbra][_structPtr->operators[TokType::Rbra].begin()->first]->name, this->loc),
                         std::vector<Node*>({base, new NodeInt(0)})
                     );
 
@@ -119,11 +113,11 @@ RaveValue NodeSlice::generate() {
     if (instanceof<TypeStruct>(lBase.type)) {
         std::string _struct = lBase.type->toString();
 
-        if (AST::structTable.find(_struct) != AST::structTable.end()) {
-            NodeStruct* _structPtr = AST::structTable[_struct];
+        if (AST::structTable.find(Symbol::lookup(_struct)) != AST::structTable.end()) {
+            NodeStruct* _structPtr = AST::structTable[Symbol(_struct)];
             if (_structPtr->operators.find(TokType::Rbra) != _structPtr->operators.end()) {
                 NodeCall* call = new NodeCall(
-                    this->loc, new NodeIden(AST::structTable[_struct]->operators[TokType::Rbra][_structPtr->operators[TokType::Rbra].begin()->first]->name, this->loc),
+                    this->loc, new NodeIden(AST::structTable[Symbol(_struct)]->operators[TokType::Rbra][_structPtr->operators[TokType::Rbra].begin()->first]->name, this->loc),
                     std::vector<Node*>({base, new NodeInt(0)})
                 );
 
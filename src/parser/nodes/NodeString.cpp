@@ -10,7 +10,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/utf8.h"
 #include "../../include/llvm.hpp"
 
-NodeString::NodeString(std::string value, bool isWide) : value(value), isWide(isWide) {}
+NodeString::NodeString(std::string value, bool isWide) : Node(NodeKind::String), value(value), isWide(isWide) {}
 
 Node* NodeString::copy() { return new NodeString(value, isWide); }
 
@@ -40,5 +40,5 @@ RaveValue NodeString::generate() {
     LLVMValueRef indices[2] = { LLVM::makeInt(32, 0, false), LLVM::makeInt(32, 0, false) };
     Type* tp = new TypePointer(basicTypes[isWide ? BasicType::Int : BasicType::Char]);
 
-    return { LLVM::cInboundsGep({globalStr, tp}, indices, 2).value, tp };
+    return {LLVMConstInBoundsGEP2(LLVMGlobalGetValueType(globalStr), globalStr, indices, 2), tp};
 }
@@ -17,7 +17,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/debug.hpp"
 
 NodeStruct::NodeStruct(std::string name, std::vector<Node*> elements, int loc, std::string extends,
-                       std::vector<std::string> templateNames, std::vector<DeclarMod> mods) {
+                       std::vector<std::string> templateNames, std::vector<DeclarMod> mods) : Node(NodeKind::Struct) {
     this->name = name;
     this->origname = name;
     this->oldElements = elements;
@@ -36,12 +36,6 @@ NodeStruct::NodeStruct(std::string name, std::vector<Node*> elements, int loc, s
     }
 }
 
-NodeStruct::~NodeStruct() {
-    for (size_t i = 0; i < elements.size(); i++) if (elements[i] != nullptr) delete elements[i];
-    for (size_t i = 0; i < oldElements.size(); i++) if (oldElements[i] != nullptr) delete oldElements[i];
-    if (destructor != nullptr) delete destructor;
-}
-
 Node* NodeStruct::comptime() { return this; }
 
 Node* NodeStruct::copy() {
@@ -68,8 +62,8 @@ Type* checkForTemplated(Type* type) {
     }
 
     if (instanceof<TypeStruct>(loaded)) {
-        if (generator->toReplace.find(loaded->toString()) != generator->toReplace.end())
-            loaded = generator->toReplace[loaded->toString()];
+        if (generator->toReplace.find(Types::key(loaded)) != generator->toReplace.end())
+            loaded = generator->toReplace[Types::key(loaded)];
 
         if (instanceof<TypeStruct>(loaded)) {
             TypeStruct* ts = (TypeStruct*)loaded;
@@ -101,7 +95,7 @@ std::vector<LLVMTypeRef> NodeStruct::getParameters(bool isLinkOnce) {
             NodeVar* var = (NodeVar*)this->elements[i];
             var->isExtern = (var->isExtern || this->isImported);
             var->isComdat = this->isComdat;
-            AST::structMembersTable[std::pair<std::string, std::string>(this->name, var->name)] =
+            AST::structMembersTable[std::pair<Symbol, Symbol>(this->name, var->name)] =
                 StructMember{.number = i, .var = var};
 
             Types::replaceTemplates(&var->type);
@@ -110,7 +104,7 @@ std::vector<LLVMTypeRef> NodeStruct::getParameters(bool isLinkOnce) {
                 this->predefines[var->name] = StructPredefined{.element = i, .value = var->value, .isStruct = false, .name = var->name};
             else if (instanceof<TypeStruct>(var->type)) {
                 TypeStruct* ts = (TypeStruct*)var->type;
-                if (AST::structTable.find(ts->name) != AST::structTable.end() && AST::structTable[ts->name]->hasPredefines()) {
+                if (AST::structTable.find(Symbol::lookup(ts->name)) != AST::structTable.end() && AST::structTable[Symbol(ts->name)]->hasPredefines()) {
                     this->predefines[var->name] = StructPredefined{.element = i, .value = nullptr, .isStruct = true, .name = var->name};
                 }
             }
@@ -220,16 +214,16 @@ std::vector<LLVMTypeRef> NodeStruct::getParameters(bool isLinkOnce) {
                 Types::replaceTemplates(&func->type);
                 for (size_t j = 0; j < func->args.size(); j++) Types::replaceTemplates(&func->args[j].type);
 
-                if (AST::methodTable.find(std::pair<std::string, std::string>(this->name, func->origName)) != AST::methodTable.end()) {
-                    std::string sTypes = typesToString(AST::methodTable[std::pair<std::string, std::string>(this->name, func->origName)]->args);
+                if (AST::methodTable.find(Symbol::lookup(this->name, func->origName)) != AST::methodTable.end()) {
+                    std::string sTypes = typesToString(AST::methodTable[std::pair<Symbol, Symbol>(this->name, func->origName)]->args);
                     std::string types = typesToString(func->args);
                     if (sTypes != types) {
                         func->origName += types;
-                        AST::methodTable[std::pair<std::string, std::string>(this->name, func->origName)] = func;
+                        AST::methodTable[std::pair<Symbol, Symbol>(this->name, func->origName)] = func;
                     }
                     else generator->error("method \033[1m" + func->origName + "\033[22m has already been declared!", this->loc);
                 }
-                else AST::methodTable[std::pair<std::string, std::string>(this->name, func->origName)] = func;
+                else AST::methodTable[std::pair<Symbol, Symbol>(this->name, func->origName)] = func;
                 func->check();
                 this->methods.push_back(func);
             }
@@ -253,14 +247,14 @@ void NodeStruct::check() {
 
     if (!namespacesNames.empty()) name = namespacesToString(namespacesNames, name);
 
-    if (AST::structTable.find(name) != AST::structTable.end()) {
+    if (AST::structTable.find(Symbol::lookup(name)) != AST::structTable.end()) {
         noCompile = true;
         return;
     }
 
     // Handle extends
     if (!extends.empty()) {
-        auto extendedIt = AST::structTable.find(extends);
+        auto extendedIt = AST::structTable.find(Symbol::lookup(extends));
         if (extendedIt == AST::structTable.end()) {
             generator->error("extended struct \033[1m" + extends + "\033[22m not found!", loc);
             return;
@@ -281,7 +275,7 @@ void NodeStruct::check() {
         }
     }
 
-    AST::structTable[name] = this;
+    AST::structTable[Symbol(name)] = this;
 }
 
 bool NodeStruct::hasPredefines() {
@@ -289,7 +283,7 @@ bool NodeStruct::hasPredefines() {
         if (instanceof<NodeVar>(this->elements[i])) {
             if (instanceof<TypeStruct>(((NodeVar*)this->elements[i])->type)) {
                 return ((TypeStruct*)((NodeVar*)this->elements[i])->type)->name != this->name &&
-                    AST::structTable[((TypeStruct*)((NodeVar*)this->elements[i])->type)->name]->hasPredefines();
+                    AST::structTable[Symbol(((TypeStruct*)((NodeVar*)this->elements[i])->type)->name)]->hasPredefines();
             }
             else return ((NodeVar*)this->elements[i])->value != nullptr;
         }
@@ -16,6 +16,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeBool.hpp"
 #include "../../include/parser/ast.hpp"
 #include "../../include/debug.hpp"
+#include "../../include/timeTrace.hpp"
 
 RaveValue NodeStruct::generate() {
     DEBUG_LOG(Debug::Category::CodeGen, "Generating struct: " + name);
@@ -26,12 +27,12 @@ RaveValue NodeStruct::generate() {
 
     // Process modifiers
     for (size_t i = 0; i < this->mods.size(); i++) {
-        while (AST::aliasTable.find(this->mods[i].name) != AST::aliasTable.end()) {
-            if (instanceof<NodeArray>(AST::aliasTable[this->mods[i].name])) {
-                this->mods[i].name = ((NodeString*)(((NodeArray*)AST::aliasTable[this->mods[i].name])->values[0]))->value;
-                this->mods[i].value = ((NodeString*)(((NodeArray*)AST::aliasTable[this->mods[i].name])->values[1]));
+        while (AST::aliasTable.find(Symbol::lookup(this->mods[i].name)) != AST::aliasTable.end()) {
+            if (instanceof<NodeArray>(AST::aliasTable[Symbol(this->mods[i].name)])) {
+                this->mods[i].name = ((NodeString*)(((NodeArray*)AST::aliasTable[Symbol(this->mods[i].name)])->values[0]))->value;
+                this->mods[i].value = ((NodeString*)(((NodeArray*)AST::aliasTable[Symbol(this->mods[i].name)])->values[1]));
             }
-            else this->mods[i].name = ((NodeString*)((NodeArray*)AST::aliasTable[this->mods[i].name]))->value;
+            else this->mods[i].name = ((NodeString*)((NodeArray*)AST::aliasTable[Symbol(this->mods[i].name)]))->value;
         }
         if (this->mods[i].name == "packed") this->isPacked = true;
         else if (this->mods[i].name == "data") this->dataVar = ((NodeString*)this->mods[i].value->comptime())->value;
@@ -49,10 +50,10 @@ RaveValue NodeStruct::generate() {
     }
 
     // Create struct type
-    generator->structures[this->name] = LLVMStructCreateNamed(generator->context, this->name.c_str());
+    generator->structures[Symbol(this->name)] = LLVMStructCreateNamed(generator->context, this->name.c_str());
 
     std::vector<LLVMTypeRef> params = this->getParameters(this->isTemplated);
-    LLVMStructSetBody(generator->structures[this->name], params.data(), params.size(), this->isPacked);
+    LLVMStructSetBody(generator->structures[Symbol(this->name)], params.data(), params.size(), this->isPacked);
 
     // Generate constructors
     if (!this->constructors.empty()) {
@@ -109,16 +110,39 @@ RaveValue NodeStruct::generate() {
 }
 
 LLVMTypeRef NodeStruct::genWithTemplate(std::string sTypes, std::vector<Type*> types) {
-    DEBUG_LOG(Debug::Category::Template, "Generating struct with template: " + name + sTypes);
-
     if (templateNames.size() == 0) return nullptr;
 
+    // Template names of the enclosing instantiation (like "T") are resolved first, so the key does not depend on them
+    bool isResolved = false;
+    for (size_t i=0; i<types.size(); i++) {
+        Type* resolved = types[i]->copy();
+        if (Types::replaceTemplates(&resolved)) {
+            types[i] = resolved;
+            isResolved = true;
+        }
+    }
+
+    if (isResolved) {
+        sTypes = "<";
+        for (Type* type : types) sTypes += type->toString() + ",";
+        sTypes.back() = '>';
+    }
+
+    std::vector<uint32_t> instance;
+    for (Type* type : types) instance.push_back(Types::key(type).id);
+
+    auto cached = instances.find(instance);
+    if (cached != instances.end()) return cached->second;
+
+    DEBUG_LOG(Debug::Category::Template, "Generating struct with template: " + name + sTypes);
+    TIME_TRACE_SCOPE("Instantiate struct", name + sTypes);
+
     // Save current state
     std::unordered_map<int32_t, Loop> activeLoops = std::unordered_map<int32_t, Loop>(generator->activeLoops);
     LLVMBuilderRef builder = generator->builder;
     LLVMBasicBlockRef currBB = generator->currBB;
     Scope* _scope = currScope;
-    std::unordered_map<std::string, Type*> toReplace = std::unordered_map<std::string, Type*>(generator->toReplace);
+    std::unordered_map<Symbol, Type*> toReplace = std::unordered_map<Symbol, Type*>(generator->toReplace);
     std::unordered_map<std::string, Node*> toReplaceValues = std::unordered_map<std::string, Node*>(generator->toReplaceValues);
 
     std::string _fn = "<";
@@ -131,7 +155,7 @@ LLVMTypeRef NodeStruct::genWithTemplate(std::string sTypes, std::vector<Type*> t
     // Setup template type replacements
     for (size_t i = 0; i < types.size(); i++) {
         if (instanceof<TypeStruct>(types[i])) {
-            if (AST::structTable.find(((TypeStruct*)types[i])->name) == AST::structTable.end() &&
+            if (AST::structTable.find(Symbol::lookup(((TypeStruct*)types[i])->name)) == AST::structTable.end() &&
                 !((TypeStruct*)types[i])->types.empty())
                 generator->genType(types[i], this->loc);
         }
@@ -139,16 +163,16 @@ LLVMTypeRef NodeStruct::genWithTemplate(std::string sTypes, std::vector<Type*> t
         if (instanceof<TypeTemplateMember>(types[i])) {
             // Value instead type
             generator->toReplaceValues[templateNames[i]] = ((TypeTemplateMember*)types[i])->value;
-            generator->toReplace[templateNames[i] + "@"] = types[i];
+            generator->toReplace[Symbol(templateNames[i] + "@")] = types[i];
             _fn += templateNames[i] + ",";
         }
         else {
-            generator->toReplace[templateNames[i]] = types[i];
+            generator->toReplace[Symbol(templateNames[i])] = types[i];
             _fn += templateNames[i] + ",";
         }
     }
 
-    generator->toReplace[name + _fn.substr(0, _fn.size() - 1) + ">"] = new TypeStruct(name + sTypes);
+    generator->toReplace[Symbol(name + _fn.substr(0, _fn.size() - 1) + ">")] = new TypeStruct(name + sTypes);
 
     // Create and generate the templated struct
     NodeStruct* _struct = new NodeStruct(name + sTypes, this->copyElements(), this->loc, "", {}, this->mods);
@@ -163,8 +187,10 @@ LLVMTypeRef NodeStruct::genWithTemplate(std::string sTypes, std::vector<Type*> t
     generator->builder = builder;
     generator->currBB = currBB;
     currScope = _scope;
-    generator->toReplace = std::unordered_map<std::string, Type*>(toReplace);
+    generator->toReplace = std::unordered_map<Symbol, Type*>(toReplace);
     generator->toReplaceValues = std::unordered_map<std::string, Node*>(toReplaceValues);
 
-    return generator->structures[_struct->name];
+    LLVMTypeRef generated = generator->structures[Symbol(_struct->name)];
+    if (generated != nullptr) instances[instance] = generated;
+    return generated;
 }
\ No newline at end of file
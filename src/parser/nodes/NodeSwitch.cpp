@@ -10,33 +10,133 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeBinary.hpp"
 #include "../../include/parser/nodes/NodeFunc.hpp"
 #include "../../include/parser/nodes/NodeIf.hpp"
+#include "../../include/parser/nodes/NodeInt.hpp"
+#include "../../include/parser/nodes/NodeChar.hpp"
+#include "../../include/parser/nodes/NodeIden.hpp"
+#include "../../include/parser/nodes/NodeUnary.hpp"
+#include "../../include/parser/nodes/NodeDone.hpp"
+#include "../../include/parser/nodes/NodeDefer.hpp"
 #include "../../include/utils.hpp"
+#include <unordered_set>
 
-NodeSwitch::NodeSwitch(Node* expr, Node* _default, std::vector<std::pair<std::vector<Node*>, Node*>> statements, int loc) {
+NodeSwitch::NodeSwitch(Node* expr, Node* _default, std::vector<std::pair<std::vector<Node*>, Node*>> statements, int loc) : Node(NodeKind::Switch) {
     this->expr = expr;
     this->statements = statements;
     this->loc = loc;
     this->_default = _default;
 }
 
-NodeSwitch::~NodeSwitch() {
-    if (expr != nullptr) delete expr;
-    if (_default != nullptr) delete _default;
-    
+Type* NodeSwitch::getType() {return typeVoid;}
+
+void NodeSwitch::check() {isChecked = true;}
+
+// Literals and aliases: known at compile time and can be generated before the switch
+static bool isConstantCase(Node* node) {
+    if (instanceof<NodeInt>(node) || instanceof<NodeChar>(node)) return true;
+    if (instanceof<NodeUnary>(node)) return ((NodeUnary*)node)->type == TokType::Minus && isConstantCase(((NodeUnary*)node)->base);
+    if (instanceof<NodeIden>(node)) {
+        Symbol name = ((NodeIden*)node)->name;
+        return generator->toReplaceValues.find(name) != generator->toReplaceValues.end() || AST::aliasTable.find(name) != AST::aliasTable.end();
+    }
+    return false;
+}
+
+static bool isIntegerSwitch(Type* type) {
+    type = Types::stripConst(type);
+    return instanceof<TypeBasic>(type) && !isFloatType(type) && ((TypeBasic*)type)->type != BasicType::Bool;
+}
+
+void NodeSwitch::generateBranch(LLVMBasicBlockRef block, Node* body, LLVMBasicBlockRef end) {
+    int selfNum = generator->activeLoops.size();
+    generator->activeLoops[selfNum] = Loop{.isActive = true, .start = block, .then = block, ._else = nullptr, .end = end, .hasEnd = false, .isIf = true, .loopRets = std::vector<LoopReturn>(), .owner = this};
+
+    LLVM::Builder::atEnd(block);
+
+    Scope* origScope = currScope;
+    currScope = copyScope(origScope);
+
+    if (body) {
+        body->check();
+        body->generate();
+    }
+
+    Defer::emit(generator->activeLoops[selfNum]);
+    if (!generator->activeLoops[selfNum].hasEnd) { LLVMBuildBr(generator->builder, end); debugInfo->setInstrLoc(loc); }
+
+    delete currScope;
+    currScope = origScope;
+    generator->activeLoops.erase(selfNum);
+}
+
+// Emits one LLVM switch on the value; false if some case is not an integer constant
+bool NodeSwitch::generateTable(RaveValue value) {
+    LLVMTypeRef valueType = LLVMTypeOf(value.value);
+    if (LLVMGetTypeKind(valueType) != LLVMIntegerTypeKind || LLVMGetIntTypeWidth(valueType) > 64) return false;
+
+    unsigned width = LLVMGetIntTypeWidth(valueType);
+    bool isSigned = !((TypeBasic*)Types::stripConst(value.type))->isUnsigned();
+    unsigned long long mask = (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+
+    std::vector<std::vector<LLVMValueRef>> labels(statements.size());
+    std::unordered_set<unsigned long long> used;
+    unsigned count = 0;
+
     for (size_t i=0; i<statements.size(); i++) {
-        for (int j=0; j<statements[i].first.size(); j++) {
-            if (statements[i].first[j] != nullptr) delete statements[i].first[j];
+        for (Node* node : statements[i].first) {
+            RaveValue label = node->generate();
+            if (label.value == nullptr || !LLVMIsAConstantInt(label.value) || LLVMGetIntTypeWidth(LLVMTypeOf(label.value)) > 64) return false;
+
+            Type* labelType = Types::stripConst(node->getType());
+            bool isLabelSigned = !(instanceof<TypeBasic>(labelType) && ((TypeBasic*)labelType)->isUnsigned());
+            unsigned labelWidth = LLVMGetIntTypeWidth(LLVMTypeOf(label.value));
+            long long number;
+
+            // Like in the comparison, the narrower operand is extended; a wider case may be out of the value range
+            if (labelWidth > width) {
+                if (isSigned) {
+                    number = LLVMConstIntGetSExtValue(label.value);
+                    if (number < -(1LL << (width - 1)) || number >= (1LL << (width - 1))) continue;
+                }
+                else {
+                    number = (long long)LLVMConstIntGetZExtValue(label.value);
+                    if ((unsigned long long)number > mask) continue;
+                }
+            }
+            else number = isLabelSigned ? LLVMConstIntGetSExtValue(label.value) : (long long)LLVMConstIntGetZExtValue(label.value);
+
+            // The first case with the value wins, as in the if-chain
+            if (!used.insert((unsigned long long)number & mask).second) continue;
+
+            labels[i].push_back(LLVMConstInt(valueType, (unsigned long long)number & mask, false));
+            count += 1;
         }
+    }
+
+    std::vector<LLVMBasicBlockRef> blocks(statements.size(), nullptr);
+    for (size_t i=0; i<statements.size(); i++) {
+        if (!labels[i].empty()) blocks[i] = LLVM::makeBlock("case", currScope->funcName);
+    }
+
+    LLVMBasicBlockRef defaultBlock = (_default != nullptr) ? LLVM::makeBlock("default", currScope->funcName) : nullptr;
+    LLVMBasicBlockRef endBlock = LLVM::makeBlock("end", currScope->funcName);
 
-        statements[i].first.clear();
+    LLVMValueRef _switch = LLVMBuildSwitch(generator->builder, value.value, (defaultBlock != nullptr) ? defaultBlock : endBlock, count);
+    debugInfo->setInstrLoc(loc);
 
-        if (statements[i].second != nullptr) delete statements[i].second;
+    for (size_t i=0; i<statements.size(); i++) {
+        for (LLVMValueRef label : labels[i]) LLVMAddCase(_switch, label, blocks[i]);
     }
-}
 
-Type* NodeSwitch::getType() {return typeVoid;}
+    // Cases without reachable values are not generated
+    for (size_t i=0; i<statements.size(); i++) {
+        if (blocks[i] != nullptr) generateBranch(blocks[i], statements[i].second, endBlock);
+    }
 
-void NodeSwitch::check() {isChecked = true;}
+    if (defaultBlock != nullptr) generateBranch(defaultBlock, _default, endBlock);
+
+    LLVM::Builder::atEnd(endBlock);
+    return true;
+}
 
 RaveValue NodeSwitch::generate() {
     if (statements.empty()) {
@@ -44,13 +144,33 @@ RaveValue NodeSwitch::generate() {
         return {};
     }
 
+    Node* value = expr;
+    Type* exprType = Types::stripConst(expr->getType());
+
+    // Basic and pointer values are generated once and every case compares the computed value
+    if (instanceof<TypeBasic>(exprType) || instanceof<TypePointer>(exprType)) {
+        RaveValue generated = expr->generate();
+
+        // Integer values are switched by one LLVM instruction, so the backend can make a jump table or bit tests
+        if (isIntegerSwitch(exprType)) {
+            bool isConstant = true;
+            for (const auto& statement : statements) {
+                for (Node* node : statement.first) isConstant = isConstant && isConstantCase(node);
+            }
+
+            if (isConstant && generateTable(generated)) return {};
+        }
+
+        value = new NodeDone(generated);
+    }
+
     std::vector<NodeIf*> ifVector;
     ifVector.reserve(statements.size());
 
     for (const auto& statement : statements) {
-        NodeBinary* _equal = new NodeBinary(TokType::Equal, expr, statement.first[0], loc);
+        NodeBinary* _equal = new NodeBinary(TokType::Equal, value, statement.first[0], loc);
 
-        for (int i=1; i<statement.first.size(); i++) _equal = new NodeBinary(TokType::Or, _equal, new NodeBinary(TokType::Equal, expr, statement.first[i], loc), loc);
+        for (int i=1; i<statement.first.size(); i++) _equal = new NodeBinary(TokType::Or, _equal, new NodeBinary(TokType::Equal, value, statement.first[i], loc), loc);
 
         ifVector.push_back(new NodeIf(_equal, statement.second, nullptr, loc, false));
     }
@@ -6,7 +6,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "../../include/parser/nodes/NodeType.hpp"
 
-NodeType::NodeType(Type* type, int loc) : type(type), loc(loc) {}
+NodeType::NodeType(Type* type, int loc) : Node(NodeKind::Type), type(type), loc(loc) {}
 
 Type* NodeType::getType() { return type; }
 
@@ -18,4 +18,3 @@ Node* NodeType::comptime() { return this; }
 
 Node* NodeType::copy() { return new NodeType(type->copy(), loc); }
 
-NodeType::~NodeType() { if (type && !instanceof<TypeBasic>(type) && !instanceof<TypeVoid>(type)) delete type; }
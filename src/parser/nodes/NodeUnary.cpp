@@ -127,28 +127,24 @@ RaveValue Unary::make(int loc, char type, Node* base) {
         if (!instanceof<TypeStruct>(value.type->getElType())) generator->error("the attempt to call the destructor is not in the structure!", loc);
 
         std::string structure = ((TypeStruct*)value.type->getElType())->toString();
-        if (AST::structTable[structure]->destructor == nullptr) return {nullptr, nullptr};
+        if (AST::structTable[Symbol(structure)]->destructor == nullptr) return {nullptr, nullptr};
 
         if (instanceof<NodeIden>(base) && currScope->has(((NodeIden*)base)->name))
             currScope->getVar(((NodeIden*)base)->name, loc)->isAllocated = false;
 
-        return Call::make(loc, new NodeIden(AST::structTable[structure]->destructor->name, loc), {base});
+        return Call::make(loc, new NodeIden(AST::structTable[Symbol(structure)]->destructor->name, loc), {base});
     }
 
     generator->error("NodeUnary undefined operator!", loc);
     return {};
 }
 
-NodeUnary::NodeUnary(int loc, char type, Node* base) {
+NodeUnary::NodeUnary(int loc, char type, Node* base) : Node(NodeKind::Unary) {
     this->loc = loc;
     this->type = type;
     this->base = base;
 }
 
-NodeUnary::~NodeUnary() {
-    if (this->base != nullptr) delete this->base;
-}
-
 Type* NodeUnary::getType() {
     switch (this->type) {
         case TokType::Amp:
@@ -27,7 +27,7 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #define LLVMDIBuilderInsertDeclareAtEnd LLVMDIBuilderInsertDeclareRecordAtEnd
 #endif
 
-NodeVar::NodeVar(std::string name, Node* value, bool isExtern, bool isConst, bool isGlobal, std::vector<DeclarMod> mods, int loc, Type* type, bool isVolatile, bool isChanged, bool noZeroInit) {
+NodeVar::NodeVar(std::string name, Node* value, bool isExtern, bool isConst, bool isGlobal, std::vector<DeclarMod> mods, int loc, Type* type, bool isVolatile, bool isChanged, bool noZeroInit) : Node(NodeKind::Var) {
     this->name = name;
     this->origName = name;
     this->linkName = this->name;
@@ -52,11 +52,6 @@ NodeVar::NodeVar(std::string name, Node* value, bool isExtern, bool isConst, boo
     }
 }
 
-NodeVar::~NodeVar() {
-    if (value != nullptr) delete value;
-    if (type != nullptr && !instanceof<TypeBasic>(type) && !instanceof<TypeVoid>(type)) delete type;
-}
-
 Type* NodeVar::getType() { return this->type->copy(); }
 
 Node* NodeVar::comptime() { return this; }
@@ -73,7 +68,7 @@ void NodeVar::check() {
     isChecked = true;
 
     if (namespacesNames.size() > 0) name = namespacesToString(namespacesNames, name);
-    if (isGlobal) AST::varTable[this->name] = this;
+    if (isGlobal) AST::varTable[Symbol(this->name)] = this;
 
     Types::replaceTemplates(&type);
 
@@ -84,10 +79,10 @@ void NodeVar::check() {
 }
 
 void Predefines::handle(Type* type, Node* node, int loc) {
-    if (AST::structTable[((TypeStruct*)type)->name]->predefines.size() > 0) {
+    if (AST::structTable[Symbol(((TypeStruct*)type)->name)]->predefines.size() > 0) {
         NodeGet* getter = new NodeGet(node, "", true, loc);
 
-        for (auto& predefine : AST::structTable[((TypeStruct*)type)->name]->predefines) {
+        for (auto& predefine : AST::structTable[Symbol(((TypeStruct*)type)->name)]->predefines) {
             getter->field = predefine.first;
 
             if (predefine.second.isStruct) Predefines::handle(getter->getType(), getter, loc);
@@ -108,12 +103,12 @@ void NodeVar::prepareType() {
 
 void NodeVar::processGlobalModifiers(int& alignment, bool& noMangling) {
     for (size_t i=0; i<mods.size(); i++) {
-        while (AST::aliasTable.find(mods[i].name) != AST::aliasTable.end()) {
-            if (instanceof<NodeArray>(AST::aliasTable[mods[i].name])) {
-                mods[i].name = ((NodeString*)((NodeArray*)AST::aliasTable[mods[i].name])->values[0])->value;
-                mods[i].value = ((NodeArray*)AST::aliasTable[mods[i].name])->values[1];
+        while (AST::aliasTable.find(Symbol::lookup(mods[i].name)) != AST::aliasTable.end()) {
+            if (instanceof<NodeArray>(AST::aliasTable[Symbol(mods[i].name)])) {
+                mods[i].name = ((NodeString*)((NodeArray*)AST::aliasTable[Symbol(mods[i].name)])->values[0])->value;
+                mods[i].value = ((NodeArray*)AST::aliasTable[Symbol(mods[i].name)])->values[1];
             }
-            else mods[i].name = ((NodeString*)AST::aliasTable[mods[i].name])->value;
+            else mods[i].name = ((NodeString*)AST::aliasTable[Symbol(mods[i].name)])->value;
         }
         if (mods[i].name == "C") noMangling = true;
         else if (mods[i].name == "volatile") isVolatile = true;
@@ -148,12 +143,12 @@ void NodeVar::applyAlignment(LLVMValueRef llvmValue, int alignment) {
 void NodeVar::generateDebugInfo(LLVMValueRef llvmValue) {
     if (!generator->settings.outDebugInfo) return;
 
-    auto debugLoc = LLVMDIBuilderCreateDebugLocation(generator->context, loc, 0, AST::funcTable[currScope->funcName]->diFuncScope, nullptr);
+    auto debugLoc = LLVMDIBuilderCreateDebugLocation(generator->context, loc, 0, AST::funcTable[Symbol(currScope->funcName)]->diFuncScope, nullptr);
     auto varType = debugInfo->genType(type, loc);
     LLVMMetadataRef emptyExpr = LLVMDIBuilderCreateExpression(debugInfo->diBuilder, nullptr, 0);
 
     auto varInfo = LLVMDIBuilderCreateAutoVariable(
-        debugInfo->diBuilder, AST::funcTable[currScope->funcName]->diFuncScope, name.c_str(), name.length(),
+        debugInfo->diBuilder, AST::funcTable[Symbol(currScope->funcName)]->diFuncScope, name.c_str(), name.length(),
         debugInfo->diFile, loc, varType, true,
         LLVMDIFlagZero, 0
     );
@@ -167,14 +162,14 @@ void NodeVar::generateDebugInfo(LLVMValueRef llvmValue) {
 void NodeVar::createLLVMGlobal(int alignment, bool noMangling) {
     LLVMTypeRef globalType = generator->genType(type, loc);
 
-    if (generator->globals.find(name) != generator->globals.end() && 
-        LLVMGetLinkage(generator->globals[name].value) == LLVMExternalLinkage) {
+    if (generator->globals.find(Symbol::lookup(name)) != generator->globals.end() && 
+        LLVMGetLinkage(generator->globals[Symbol(name)].value) == LLVMExternalLinkage) {
         return;
     }
 
     linkName = ((linkName == name && !noMangling) ? generator->mangle(name, false, false) : linkName);
 
-    generator->globals[name] = { LLVMAddGlobal(
+    generator->globals[Symbol(name)] = { LLVMAddGlobal(
         generator->lModule,
         globalType,
         linkName.c_str()
@@ -187,33 +182,33 @@ void NodeVar::handleGlobalInitialization(int alignment) {
             RaveValue{LLVMConstNull(generator->genType(type, loc)), type} : 
             (instanceof<NodeUnary>(value) ? ((NodeUnary*)value)->generateConst() : value->generate());
         
-        LLVMSetInitializer(generator->globals[name].value, val.value);
+        LLVMSetInitializer(generator->globals[Symbol(name)].value, val.value);
     }
 
     if (isComdat) {
         LLVMComdatRef comdat = LLVMGetOrInsertComdat(generator->lModule, linkName.c_str());
         LLVMSetComdatSelectionKind(comdat, LLVMAnyComdatSelectionKind);
-        LLVMSetComdat(generator->globals[name].value, comdat);
-        LLVMSetLinkage(generator->globals[name].value, LLVMLinkOnceODRLinkage);
+        LLVMSetComdat(generator->globals[Symbol(name)].value, comdat);
+        LLVMSetLinkage(generator->globals[Symbol(name)].value, LLVMLinkOnceODRLinkage);
     }
-    else if (isExtern) LLVMSetLinkage(generator->globals[name].value, LLVMExternalLinkage);
+    else if (isExtern) LLVMSetLinkage(generator->globals[Symbol(name)].value, LLVMExternalLinkage);
 
-    if (isVolatile) LLVMSetVolatile(generator->globals[name].value, true);
-    applyAlignment(generator->globals[name].value, alignment);
+    if (isVolatile) LLVMSetVolatile(generator->globals[Symbol(name)].value, true);
+    applyAlignment(generator->globals[Symbol(name)].value, alignment);
 }
 
 RaveValue NodeVar::generateAutoTypeGlobal() {
     RaveValue value = instanceof<NodeUnary>(this->value) ? ((NodeUnary*)this->value)->generateConst() : this->value->generate();
 
     linkName = generator->mangle(name, false, false);
-    generator->globals[name] = {LLVMAddGlobal(
+    generator->globals[Symbol(name)] = {LLVMAddGlobal(
         generator->lModule,
         LLVMTypeOf(value.value),
         linkName.c_str()
     ), new TypePointer(value.type)};
 
     type = this->value->getType();
-    LLVMSetInitializer(generator->globals[this->name].value, value.value);
+    LLVMSetInitializer(generator->globals[Symbol(this->name)].value, value.value);
 
     return {};
 }
@@ -224,7 +219,7 @@ RaveValue NodeVar::generateAutoTypeLocal() {
 
     if (instanceof<NodeCall>(value) && instanceof<NodeIden>(((NodeCall*)value)->func)) {
         NodeIden* niden = (NodeIden*)((NodeCall*)value)->func;
-        if (niden->name.find('<') != std::string::npos && AST::structTable.find(niden->name.substr(0, niden->name.find('<'))) != AST::structTable.end()) {
+        if (niden->name.find('<') != std::string::npos && AST::structTable.find(Symbol::lookup(niden->name.substr(0, niden->name.find('<')))) != AST::structTable.end()) {
             isStructConstructor = true;
 
             if (AST::structTable.find(niden->name) != AST::structTable.end()) type = new TypeStruct(niden->name);
@@ -232,7 +227,7 @@ RaveValue NodeVar::generateAutoTypeLocal() {
                 std::string sTypes = niden->name.substr(niden->name.find('<')+  1, niden->name.find('>'));
                 sTypes.pop_back();
 
-                Lexer lexer = Lexer(sTypes, 0);
+                Lexer lexer(sTypes, 0);
                 Parser parser = Parser(lexer.tokens, "(BUILTIN)");
                 std::vector<Type*> types;
 
@@ -242,7 +237,7 @@ RaveValue NodeVar::generateAutoTypeLocal() {
                     types.push_back(parser.parseType());
                 }
 
-                AST::structTable[niden->name.substr(0, niden->name.find('<'))]->genWithTemplate("<" + sTypes + ">", types);
+                AST::structTable[Symbol(niden->name.substr(0, niden->name.find('<')))]->genWithTemplate("<" + sTypes + ">", types);
                 type = new TypeStruct(niden->name);
             }
         }
@@ -250,16 +245,16 @@ RaveValue NodeVar::generateAutoTypeLocal() {
     
     if (!isStructConstructor) {
         val = value->generate();
-        currScope->localScope[name] = LLVM::alloc(val.type, name.c_str());
+        currScope->localScope[Symbol(name)] = LLVM::alloc(val.type, name.c_str());
         type = value->getType();
 
-        if (isVolatile) LLVMSetVolatile(currScope->localScope[name].value, true);
+        if (isVolatile) LLVMSetVolatile(currScope->localScope[Symbol(name)].value, true);
 
-        generateDebugInfo(currScope->localScope[name].value);
-        applyAlignment(currScope->localScope[name].value, -1);
+        generateDebugInfo(currScope->localScope[Symbol(name)].value);
+        applyAlignment(currScope->localScope[Symbol(name)].value, -1);
 
-        LLVMBuildStore(generator->builder, val.value, currScope->localScope[name].value);
-        return currScope->localScope[name];
+        LLVMBuildStore(generator->builder, val.value, currScope->localScope[Symbol(name)].value);
+        return currScope->localScope[Symbol(name)];
     }
 
     return {};
@@ -268,7 +263,7 @@ RaveValue NodeVar::generateAutoTypeLocal() {
 RaveValue NodeVar::generateGlobalVariable() {
     prepareType();
 
-    if (instanceof<TypeAlias>(type)) { AST::aliasTable[name] = value; return {}; }
+    if (instanceof<TypeAlias>(type)) { AST::aliasTable[Symbol(name)] = value; return {}; }
 
     if (instanceof<TypeAuto>(type) && !value) {
         generator->error("using \033[1mauto\033[22m without an explicit value is prohibited!", loc);
@@ -291,50 +286,50 @@ RaveValue NodeVar::generateGlobalVariable() {
     createLLVMGlobal(alignment, noMangling);
 
     if (!isExtern) {
-        if (value) LLVMSetInitializer(generator->globals[name].value, value->generate().value);
-        else if (!noZeroInit) LLVMSetInitializer(generator->globals[name].value, LLVMConstNull(generator->genType(type, loc)));
+        if (value) LLVMSetInitializer(generator->globals[Symbol(name)].value, value->generate().value);
+        else if (!noZeroInit) LLVMSetInitializer(generator->globals[Symbol(name)].value, LLVMConstNull(generator->genType(type, loc)));
 
-        LLVMSetGlobalConstant(generator->globals[name].value, isConst);
+        LLVMSetGlobalConstant(generator->globals[Symbol(name)].value, isConst);
     }
-    else LLVMSetLinkage(generator->globals[name].value, LLVMExternalLinkage);
+    else LLVMSetLinkage(generator->globals[Symbol(name)].value, LLVMExternalLinkage);
 
     handleGlobalInitialization(alignment);
 
     if (generator->settings.outDebugInfo && !isExtern) {
         debugInfo->genGlobalVariable(name.c_str(), debugInfo->genType(type, loc),
-            generator->globals[name].value, loc);
+            generator->globals[Symbol(name)].value, loc);
     }
 
     return {};
 }
 
 RaveValue NodeVar::generateLocalVariable() {
-    currScope->localVars[name] = this;
+    currScope->localVars[Symbol(name)] = this;
     processLocalModifiers();
 
     prepareType();
 
-    if (instanceof<TypeAlias>(type)) { currScope->aliasTable[name] = value; return {}; }
+    if (instanceof<TypeAlias>(type)) { currScope->aliasTable[Symbol(name)] = value; return {}; }
 
     if (instanceof<TypeAuto>(type)) return generateAutoTypeLocal();
 
     if (instanceof<NodeInt>(value) && !isFloatType(type)) ((NodeInt*)value)->isVarVal = type;
 
     LLVMTypeRef gT = generator->genType(type, loc);
-    currScope->localScope[name] = LLVM::alloc(type, name.c_str());
+    currScope->localScope[Symbol(name)] = LLVM::alloc(type, name.c_str());
 
-    generateDebugInfo(currScope->localScope[name].value);
+    generateDebugInfo(currScope->localScope[Symbol(name)].value);
 
-    if (isVolatile) LLVMSetVolatile(currScope->localScope[name].value, true);
-    applyAlignment(currScope->localScope[name].value, -1);
+    if (isVolatile) LLVMSetVolatile(currScope->localScope[Symbol(name)].value, true);
+    applyAlignment(currScope->localScope[Symbol(name)].value, -1);
 
     if (instanceof<TypeStruct>(type)) Predefines::handle(type, new NodeIden(name, loc), loc);
 
     if (value) Binary::operation(TokType::Equ, new NodeIden(name, loc), value, loc);
     else if ((instanceof<TypeBasic>(type) || instanceof<TypePointer>(type)) && !noZeroInit) 
-        LLVMBuildStore(generator->builder, LLVMConstNull(gT), currScope->localScope[name].value);
+        LLVMBuildStore(generator->builder, LLVMConstNull(gT), currScope->localScope[Symbol(name)].value);
 
-    return currScope->localScope[name];
+    return currScope->localScope[Symbol(name)];
 }
 
 RaveValue NodeVar::generate() {
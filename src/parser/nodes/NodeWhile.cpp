@@ -14,32 +14,75 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../include/parser/nodes/NodeVar.hpp"
 #include "../../include/parser/nodes/NodeUnary.hpp"
 #include "../../include/parser/nodes/NodeIden.hpp"
+#include "../../include/parser/nodes/NodeInt.hpp"
+#include "../../include/parser/nodes/NodeChar.hpp"
+#include "../../include/parser/nodes/NodeGet.hpp"
+#include "../../include/parser/nodes/NodeCast.hpp"
+#include "../../include/parser/nodes/NodeBinary.hpp"
+#include "../../include/parser/Checks.hpp"
+#include "../../include/parser/LoopHints.hpp"
 #include "../../include/utils.hpp"
 
-NodeWhile::NodeWhile(Node* cond, Node* body, int loc) {
+NodeWhile::NodeWhile(Node* cond, Node* body, int loc) : Node(NodeKind::While) {
     this->cond = cond;
     this->body = body;
     this->loc = loc;
 }
 
-NodeWhile::~NodeWhile() {
-    if (cond != nullptr) delete cond;
-    if (body != nullptr) delete body;
-}
-
 Type* NodeWhile::getType() {return typeVoid;}
 Node* NodeWhile::comptime() {return this;}
-Node* NodeWhile::copy() {return new NodeWhile(this->cond->copy(), this->body->copy(), this->loc);}
+Node* NodeWhile::copy() {
+    NodeWhile* nwhile = new NodeWhile(this->cond->copy(), this->body->copy(), this->loc);
+    nwhile->mods = this->mods;
+    return nwhile;
+}
 
 void NodeWhile::check() {isChecked = true;}
 
+// Expressions that can be evaluated one more time: no calls (including the overloaded operators) and no stores
+bool NodeWhile::isPure(Node* node) {
+    if (instanceof<NodeInt>(node) || instanceof<NodeChar>(node) || instanceof<NodeBool>(node) || instanceof<NodeIden>(node)) return true;
+    if (instanceof<NodeGet>(node)) {
+        Node* base = ((NodeGet*)node)->base;
+        return (instanceof<NodeIden>(base) || instanceof<NodeGet>(base)) && isPure(base);
+    }
+    if (instanceof<NodeCast>(node)) return isPure(((NodeCast*)node)->value);
+
+    if (instanceof<NodeBinary>(node)) {
+        NodeBinary* binary = (NodeBinary*)node;
+
+        switch (binary->op) {
+            case TokType::Plus: case TokType::Minus: case TokType::Multiply:
+            case TokType::Less: case TokType::More: case TokType::LessEqual: case TokType::MoreEqual:
+            case TokType::Equal: case TokType::Nequal:
+                break;
+            default: return false;
+        }
+
+        if (!isPure(binary->first) || !isPure(binary->second)) return false;
+
+        for (Node* operand : {binary->first, binary->second}) {
+            Type* type = operand->getType();
+            while (instanceof<TypeConst>(type)) type = ((TypeConst*)type)->instance;
+            if (!instanceof<TypeBasic>(type) && !instanceof<TypePointer>(type)) return false;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 RaveValue NodeWhile::generate() {
-    auto& function = generator->functions[currScope->funcName];
+    auto& function = generator->functions[Symbol(currScope->funcName)];
     LLVMBasicBlockRef condBlock = LLVM::makeBlock("cond", function.value);
     LLVMBasicBlockRef whileBlock = LLVM::makeBlock("while", function.value);
     currScope->blockExit = LLVM::makeBlock("exit", function.value);
 
-    LLVMBuildBr(generator->builder, condBlock);
+    LLVMValueRef entered = nullptr;
+    if (isCounted && Checks::enabled()) entered = this->cond->generate().value;
+
+    LLVMValueRef preheaderBranch = LLVMBuildBr(generator->builder, condBlock);
     debugInfo->setInstrLoc(loc);
     LLVM::Builder::atEnd(condBlock);
 
@@ -58,9 +101,12 @@ RaveValue NodeWhile::generate() {
     currScope = copyScope(currScope);
 
     generator->currBB = whileBlock;
+    if (entered != nullptr) Checks::beginLoop(entered, preheaderBranch, condBlock, whileBlock);
     this->body->generate();
     
     if (!generator->activeLoops[selfNumber].hasEnd) { LLVMBuildBr(generator->builder, condBlock); debugInfo->setInstrLoc(loc); }
+    if (entered != nullptr) Checks::endLoop(condBlock);
+    LoopHints::attach(mods, condBlock, preheaderBranch, loc);
 
     LLVMPositionBuilderAtEnd(generator->builder, generator->activeLoops[selfNumber].end);
     generator->currBB = generator->activeLoops[selfNumber].end;
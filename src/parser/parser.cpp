@@ -8,6 +8,7 @@ with this file, You can obtain one at htypep://mozilla.org/MPL/2.0/.
 #include <map>
 #include <string>
 #include "../include/compiler.hpp"
+#include "../include/timeTrace.hpp"
 #include "../include/parser/ast.hpp"
 #include "../include/parser/nodes/Node.hpp"
 #include "../include/parser/nodes/NodeBlock.hpp"
@@ -75,7 +76,7 @@ with this file, You can obtain one at htypep://mozilla.org/MPL/2.0/.
 
 std::map<char, int> operators;
 
-Parser::Parser(std::vector<Token*> tokens, std::string file) 
+Parser::Parser(const std::vector<Token>& tokens, std::string file) 
     : tokens(tokens), file(file) {
     
     operators = {
@@ -130,12 +131,12 @@ void Parser::warning(std::string msg, int line) {
 
 void Parser::warning(std::string msg) { warning(msg, peek()->line); }
 
-Token* Parser::skipStmt() {
+const Token* Parser::skipStmt() {
     while (peek()->type != TokType::Eof && peek()->type != TokType::Semicolon) next();
     return peek();
 }
 
-Token* Parser::skip(int openType, int closeType) {
+const Token* Parser::skip(int openType, int closeType) {
     int count = 1;
 
     while (peek()->type != TokType::Eof) {
@@ -149,12 +150,12 @@ Token* Parser::skip(int openType, int closeType) {
     return peek();
 }
 
-Token* Parser::peek() { return tokens[idx]; }
+const Token* Parser::peek() { return &tokens[idx]; }
 
-Token* Parser::next(int add) { idx += add; return tokens[idx]; }
+const Token* Parser::next(int add) { idx += add; return &tokens[idx]; }
 
-Token* Parser::expect(int type, std::string msg, int add) {
-    Token* _next = next(add);
+const Token* Parser::expect(int type, std::string msg, int add) {
+    const Token* _next = next(add);
 
     if (_next->type != type) {
         error(msg, _next->line);
@@ -165,6 +166,7 @@ Token* Parser::expect(int type, std::string msg, int add) {
 }
 
 void Parser::parseAll() {
+    TIME_TRACE_SCOPE("Parse", file);
     auto start = std::chrono::steady_clock::now();
 
     while (peek()->type != TokType::Eof) {
@@ -178,7 +180,7 @@ void Parser::parseAll() {
 
     auto end = std::chrono::steady_clock::now();
 
-    Compiler::parseTime += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    Compiler::parseTime += std::chrono::duration<double, std::milli>(end - start).count();
 
     if (haveErrors) std::exit(1);
 }
@@ -195,7 +197,7 @@ void Parser::parseTopLevel(std::vector<Node*>& list, std::string s) {
     else if (peek()->type == TokType::Builtin) {
         if (peek()->value == "@if") return list.push_back(parseIf(s, true));
 
-        Token* tok = peek();
+        const Token* tok = peek();
         next();
         checkEOF("the builtin's name was expected!");
 
@@ -218,7 +220,7 @@ void Parser::parseTopLevel(std::vector<Node*>& list, std::string s) {
             next();
         }
 
-        NodeBuiltin* nb = new NodeBuiltin(tok->value, args, tok->line, block);
+        NodeBuiltin* nb = new NodeBuiltin(tok->str(), args, tok->line, block);
         nb->isTopLevel = true;
         return list.push_back(nb);
     }
@@ -229,7 +231,7 @@ void Parser::parseTopLevel(std::vector<Node*>& list, std::string s) {
         while (peek()->type != TokType::Lpar) {
             checkEOF("expected expression!");
 
-            std::string name = peek()->value;
+            std::string name = peek()->str();
             next();
 
             Node* value = nullptr;
@@ -259,7 +261,7 @@ Node* Parser::parseNamespace(std::string s) {
     int loc = peek()->line;
     next();
 
-    std::string name = peek()->value;
+    std::string name = peek()->str();
 
     if (expect(TokType::Rbra, "expected token '{'!") == nullptr) {
         skip(TokType::Rbra, TokType::Lbra);
@@ -298,7 +300,7 @@ std::vector<FuncArgSet> Parser::parseFuncArgSets() {
         Type* type = parseType();
         if (type == nullptr) return args;
 
-        std::string name = peek()->value;
+        std::string name = peek()->str();
 
         next();
         args.push_back(FuncArgSet{.name = name, .type = type, .internalTypes = {type}});
@@ -310,7 +312,7 @@ std::vector<FuncArgSet> Parser::parseFuncArgSets() {
 }
 
 Node* Parser::parseBuiltin(std::string f) {
-    std::string name = peek()->value;
+    std::string name = peek()->str();
     if (name == "@if") return parseIf(f, true);
 
     std::vector<Node*> args;
@@ -355,16 +357,16 @@ Node* Parser::parseBuiltin(std::string f) {
 
 Node* Parser::parseOperatorOverload(Type* type, std::string s) {
     next();
-    Token* _t = peek();
-    std::string name = s + "(" + _t->value;
+    const Token* _t = peek();
+    std::string name = s + "(" + _t->str();
     next();
 
     // Build operator name
     if (peek()->type != TokType::Rpar) {
-        name += peek()->value;
+        name += peek()->str();
         next();
         if (peek()->type != TokType::Rpar) {
-            name += peek()->value;
+            name += peek()->str();
             next();
         }
     }
@@ -376,7 +378,7 @@ Node* Parser::parseOperatorOverload(Type* type, std::string s) {
         next();
         while (peek()->type != TokType::Lpar) {
             Type* argType = parseType();
-            args.push_back(FuncArgSet{.name = peek()->value, .type = argType, .internalTypes = {argType}});
+            args.push_back(FuncArgSet{.name = peek()->str(), .type = argType, .internalTypes = {argType}});
             next();
             if (peek()->type == TokType::Comma) next();
         }
@@ -410,7 +412,7 @@ void Parser::parseDecl(std::vector<Node*>& list, std::string s, std::vector<Decl
     if (peek()->type == TokType::Rpar) {
         next();
         while (peek()->type != TokType::Lpar) {
-            std::string name = peek()->value;
+            std::string name = peek()->str();
             next();
             Node* value = nullptr;
             if (peek()->type == TokType::ValSel) {
@@ -469,7 +471,7 @@ void Parser::parseDecl(std::vector<Node*>& list, std::string s, std::vector<Decl
 
     if (peek()->value == "operator") return list.push_back(parseOperatorOverload(type, s));
 
-    name = peek()->value;
+    name = peek()->str();
     if (isBasicType(name)) error("a declaration cannot be named as a basic type!");
 
     loc = peek()->line;
@@ -491,7 +493,7 @@ void Parser::parseDecl(std::vector<Node*>& list, std::string s, std::vector<Decl
     if (peek()->type == TokType::Less) {
         next();
         while (peek()->type != TokType::More) {
-            templates.push_back(peek()->value);
+            templates.push_back(peek()->str());
             next();
             if (peek()->type == TokType::Comma) next();
         }
@@ -566,7 +568,7 @@ void Parser::parseDecl(std::vector<Node*>& list, std::string s, std::vector<Decl
         if (peek()->type != TokType::Semicolon) next();
 
         while (peek()->type != TokType::Semicolon) {
-            std::string varName = peek()->value;
+            std::string varName = peek()->str();
             next();
 
             Node* varValue = nullptr;
@@ -617,10 +619,10 @@ Node* Parser::parseConstantStructure(std::string structName) {
 }
 
 Node* Parser::parseAtom(std::string f) {
-    Token* t = peek();
+    const Token* t = peek();
     next();
 
-    int size = peek()->value.size();
+    int size = peek()->str().size();
 
     if (t->type == TokType::Number) {
         int expNumber = 0;
@@ -629,10 +631,10 @@ Node* Parser::parseAtom(std::string f) {
             // Exponent
             next();
 
-            char sign = peek()->value[0];
+            char sign = peek()->str()[0];
             next();
 
-            std::string exponent = peek()->value;
+            std::string exponent = peek()->str();
             next();
 
             if (sign == '-') expNumber = std::stoi(exponent) * -1;
@@ -640,10 +642,10 @@ Node* Parser::parseAtom(std::string f) {
         }
 
         if (peek()->type == TokType::Identifier) {
-            std::string iden = peek()->value;
+            std::string iden = peek()->str();
 
             if (iden == "u" || iden == "l" || iden == "c" || iden == "s") {
-                NodeInt* _int = new NodeInt(BigInt(t->value));
+                NodeInt* _int = new NodeInt(BigInt(t->str()));
                 next();
 
                 if (iden == "u") _int->isUnsigned = true;
@@ -661,16 +663,16 @@ Node* Parser::parseAtom(std::string f) {
                         std::string number = "0.";
                         for (int i=1; i<expNumber; i++) number += "0";
 
-                        nfloat = new NodeFloat(std::stod(number + t->value));
+                        nfloat = new NodeFloat(std::stod(number + t->str()));
                     }
                     else {
-                        std::string number = t->value;
+                        std::string number = t->str();
                         for (size_t i=0; i<expNumber; i++) number += "0";
 
-                        nfloat = new NodeFloat(std::stod(t->value + number));
+                        nfloat = new NodeFloat(std::stod(t->str() + number));
                     }
                 }
-                else nfloat = new NodeFloat(std::stod(t->value));
+                else nfloat = new NodeFloat(std::stod(t->str()));
 
                 next();
 
@@ -683,7 +685,7 @@ Node* Parser::parseAtom(std::string f) {
             }
         }
 
-        return new NodeInt(BigInt(t->value));
+        return new NodeInt(BigInt(t->str()));
     }
 
     if (t->type == TokType::FloatNumber) {
@@ -693,10 +695,10 @@ Node* Parser::parseAtom(std::string f) {
             // Exponent
             next();
 
-            char sign = peek()->value[0];
+            char sign = peek()->str()[0];
             next();
 
-            std::string exponent = peek()->value;
+            std::string exponent = peek()->str();
             next();
 
             if (sign == '-') expNumber = std::stoi(exponent) * -1;
@@ -705,11 +707,11 @@ Node* Parser::parseAtom(std::string f) {
 
         NodeFloat* value = nullptr;
 
-        double number = std::stod(t->value);
+        double number = std::stod(t->str());
         if (expNumber != 0) number = std::pow(10, expNumber) * number;
 
         if (peek()->type == TokType::Identifier) {
-            std::string suffix = peek()->value;
+            std::string suffix = peek()->str();
             next();
 
             if (suffix == "d") value = new NodeFloat(number, basicTypes[BasicType::Double]);
@@ -729,7 +731,7 @@ Node* Parser::parseAtom(std::string f) {
     if (t->type == TokType::HexNumber) {
         long long number;
         std::stringstream ss;
-        ss << std::hex << t->value;
+        ss << std::hex << t->str();
         ss >> number;
         return new NodeInt(BigInt(number));
     }
@@ -741,20 +743,20 @@ Node* Parser::parseAtom(std::string f) {
     if (t->type == TokType::String) {
         if (peek()->type == TokType::Identifier && peek()->value == "w") {
             next();
-            return new NodeString(tokens[idx-2]->value, true);
+            return new NodeString(tokens[idx-2].str(), true);
         }
-        return new NodeString(t->value,false);
+        return new NodeString(t->str(),false);
     }
 
     if (t->type == TokType::Char) {
         if (peek()->type == TokType::Identifier && peek()->value == "w") {
             next();
-            return new NodeChar(tokens[idx-2]->value, true);
+            return new NodeChar(tokens[idx-2].str(), true);
         }
-        return new NodeChar(t->value, false);
+        return new NodeChar(t->str(), false);
     }
 
-    if (peek()->type == TokType::Rbra) return parseConstantStructure(t->value);
+    if (peek()->type == TokType::Rbra) return parseConstantStructure(t->str());
 
     if (t->type == TokType::Identifier) {
         if (t->value == "null") return new NodeNull(nullptr, t->line);
@@ -813,14 +815,14 @@ Node* Parser::parseAtom(std::string f) {
                 if (peek()->type == TokType::Comma) next();
             }
             else type = typeVoid;
-            std::string line = peek()->value;
+            std::string line = peek()->str();
             std::string additions = "";
             std::vector<Node*> args;
             next();
 
             if (peek()->type == TokType::Comma) {
                 next();
-                additions = peek()->value;
+                additions = peek()->str();
                 next();
             }
             if (peek()->type == TokType::Comma) {
@@ -837,11 +839,11 @@ Node* Parser::parseAtom(std::string f) {
         else if (peek()->type == TokType::Less) {
             if (isTemplate()) {
                 next();
-                std::string all = t->value + "<";
+                std::string all = t->str() + "<";
                 int countOfL = 0;
 
                 while (countOfL != -1) {
-                    all += peek()->value;
+                    all += peek()->str();
                     if (peek()->type == TokType::Less) countOfL += 1;
                     else if (peek()->type == TokType::More) countOfL -= 1;
                     next();
@@ -882,7 +884,7 @@ Node* Parser::parseAtom(std::string f) {
             else idx += 1;
         }
 
-        if (isBasicType(t->value)) {
+        if (isBasicType(t->str())) {
             idx -= 1;
             return new NodeType(parseType(), t->line);
         }
@@ -890,14 +892,14 @@ Node* Parser::parseAtom(std::string f) {
             // Maybe this is a pointer?
             // TODO: Add support of arrays and structures
             if (peek()->type == TokType::Multiply) {
-                if (tokens[idx + 1]->type == TokType::Lpar || tokens[idx + 1]->type == TokType::Rarr) {
+                if (tokens[idx + 1].type == TokType::Lpar || tokens[idx + 1].type == TokType::Rarr) {
                     idx -= 1;
                     return new NodeType(parseType(), t->line);
                 }
             }
         }
 
-        return new NodeIden(t->value, peek()->line);
+        return new NodeIden(t->str(), peek()->line);
     }
 
     if (t->type == TokType::Rpar) {
@@ -919,17 +921,17 @@ Node* Parser::parseAtom(std::string f) {
     }
 
     if (t->type == TokType::Builtin) {
-        std::string name = t->value;
+        std::string name = t->str();
         std::vector<Node*> args;
         if (peek()->type == TokType::Rpar) {
             next();
             while (peek()->type != TokType::Lpar) {
-                if (isBasicType(peek()->value) || tokens[idx+1]->value == "*") {
+                if (isBasicType(peek()->str()) || tokens[idx+1].value == "*") {
                     Type* pType = parseType(true);
                     if (peek()->type != TokType::Comma && peek()->type != TokType::Lpar) {
                         char op= peek()->type;
                         Node* node;
-                        if (tokens[idx+1]->type == TokType::Builtin) node = parseAtom(f);
+                        if (tokens[idx+1].type == TokType::Builtin) node = parseAtom(f);
                         else {
                             next();
                             node = new NodeType(parseType(true), peek()->line);
@@ -947,8 +949,8 @@ Node* Parser::parseAtom(std::string f) {
         NodeBlock* block;
         if (peek()->type == TokType::Rbra) block = parseBlock(f);
         else block = new NodeBlock({});
-        if (peek()->type == TokType::Identifier && tokens[idx-1]->type != TokType::Lbra && tokens[idx-1]->type != TokType::Semicolon) {
-            std::string name = peek()->value;
+        if (peek()->type == TokType::Identifier && tokens[idx-1].type != TokType::Lbra && tokens[idx-1].type != TokType::Semicolon) {
+            std::string name = peek()->str();
             Node* value = nullptr;
             next();
             if (peek()->type == TokType::Equ) {
@@ -960,14 +962,14 @@ Node* Parser::parseAtom(std::string f) {
         return new NodeBuiltin(name, args, t->line, block);
     }
     if (t->type == TokType::Destructor) return new NodeUnary(t->line, TokType::Destructor, parseExpr());
-    error("expected a number, true/false, char, variable or expression. Got: \033[1m" + t->value + "\033[22m on \033[1m" + std::to_string(t->line) + "\033[22m line.");
+    error("expected a number, true/false, char, variable or expression. Got: \033[1m" + t->str() + "\033[22m on \033[1m" + std::to_string(t->line) + "\033[22m line.");
     return nullptr;
 }
 
 Node* Parser::parseStruct(std::vector<DeclarMod> mods) {
     int loc = peek()->line;
 
-    Token* __name = expect(TokType::Identifier, "a declaration name must be an identifier!");
+    const Token* __name = expect(TokType::Identifier, "a declaration name must be an identifier!");
     if (__name == nullptr) {
         next();
 
@@ -977,7 +979,7 @@ Node* Parser::parseStruct(std::vector<DeclarMod> mods) {
         if (peek()->type == TokType::Lbra) next();
     }
 
-    std::string name = __name->value;
+    std::string name = __name->str();
     next();
 
     std::vector<std::string> templateNames;
@@ -1000,7 +1002,7 @@ Node* Parser::parseStruct(std::vector<DeclarMod> mods) {
     std::string _exs = "";
     if (peek()->type == TokType::ValSel) {
         next();
-        _exs = peek()->value;
+        _exs = peek()->str();
         next();
     }
 
@@ -1043,7 +1045,7 @@ std::string getGlobalFile(Parser* parser) {
     parser->next();
     std::string buffer = "";
     while (parser->peek()->type != TokType::More) {
-        buffer += parser->peek()->value;
+        buffer += parser->peek()->str();
         parser->next();
         if (parser->peek()->type == TokType::Divide) {buffer += "/"; parser->next();}
         else if (parser->peek()->type != TokType::Divide && parser->peek()->type != TokType::More) parser->error("expected token '/' or '>'!");
@@ -1064,7 +1066,7 @@ Node* Parser::parseImport() {
 
     while (peek()->type == TokType::Less || peek()->type == TokType::String) {
         if (peek()->type == TokType::Less) files.push_back(ImportFile{getGlobalFile(this) + ".rave", true});
-        else files.push_back(ImportFile{peek()->value + ".rave", false});
+        else files.push_back(ImportFile{peek()->str() + ".rave", false});
         next();
     }
 
@@ -1082,7 +1084,7 @@ Node* Parser::parseImport() {
 Node* Parser::parseAliasType() {
     int loc = peek()->line;
 
-    std::string name = expect(TokType::Identifier, "a type name must be an identifier!")->value;
+    std::string name = expect(TokType::Identifier, "a type name must be an identifier!")->str();
     expect(TokType::Equ, "expected token '='!");
     next();
 
@@ -1094,7 +1096,7 @@ Node* Parser::parseAliasType() {
 
 Type* Parser::parseTypeAtom() {
     if (peek()->type == TokType::Identifier) {
-        std::string id = peek()->value;
+        std::string id = peek()->str();
         next();
 
         if (id == "void") return typeVoid;
@@ -1111,7 +1113,7 @@ Type* Parser::parseTypeAtom() {
     }
     else if (peek()->type == TokType::Builtin) {
         if (peek()->value == "@") {
-            error("expected a type name, not \033[1m" + peek()->value + "\033[22m!");
+            error("expected a type name, not \033[1m" + peek()->str() + "\033[22m!");
             next();
 
             return nullptr;
@@ -1119,7 +1121,7 @@ Type* Parser::parseTypeAtom() {
 
         std::vector<Node*> args;
         NodeBlock* block;
-        Token* info = peek();
+        const Token* info = peek();
         idx += 2;
 
         while (peek()->type != TokType::Lpar) {
@@ -1127,10 +1129,10 @@ Type* Parser::parseTypeAtom() {
             if (peek()->type == TokType::Comma) next();
         }
 
-        if (peek()->type == TokType::Rbra) return new TypeBuiltin(info->value, args, parseBlock(""));
-        return new TypeBuiltin(info->value, args, new NodeBlock({}));
+        if (peek()->type == TokType::Rbra) return new TypeBuiltin(info->str(), args, parseBlock(""));
+        return new TypeBuiltin(info->str(), args, new NodeBlock({}));
     }
-    else error("expected a type name, not \033[1m" + peek()->value + "\033[22m!");
+    else error("expected a type name, not \033[1m" + peek()->str() + "\033[22m!");
     return nullptr;
 }
 
@@ -1141,7 +1143,7 @@ std::vector<TypeFuncArg*> Parser::parseFuncArgs() {
     while (peek()->type != TokType::Lpar) {
         Type* ty = parseType();
         std::string name = "";
-        if (peek()->type == TokType::Identifier) {name = peek()->value; next();}
+        if (peek()->type == TokType::Identifier) {name = peek()->str(); next();}
         buffer.push_back(new TypeFuncArg(ty,name));
 
         if (peek()->type == TokType::Comma) next();
@@ -1163,7 +1165,7 @@ Type* Parser::parseType(bool cannotBeTemplate, bool isDeclaration) {
         Type* mainType = parseType();
         if (peek()->type != TokType::Comma) error("expected token ','!");
 
-        std::string name = expect(TokType::Identifier, "expected identifier!")->value;
+        std::string name = expect(TokType::Identifier, "expected identifier!")->str();
         expect(TokType::Lpar, "expected token ')'!");
         next();
 
@@ -1186,7 +1188,7 @@ Type* Parser::parseType(bool cannotBeTemplate, bool isDeclaration) {
             if (peek()->type != TokType::Larr) count = parseExpr();
             
             if (peek()->type != TokType::Larr) {
-                if (tokens[idx + 1]->type != TokType::Equ) error("expected token ']'!");
+                if (tokens[idx + 1].type != TokType::Equ) error("expected token ']'!");
             }
             else next();
 
@@ -1227,7 +1229,7 @@ bool Parser::isSlice() {
     int countOfRarr = 1;
 
     while (true) {
-        Token* tok = next();
+        const Token* tok = next();
 
         if (tok->type == TokType::Eof) break;
 
@@ -1247,7 +1249,7 @@ bool Parser::isSlice() {
 
 bool Parser::isTemplate() {
     const int startIdx = idx;
-    const Token* nextToken = tokens[idx + 1];
+    const Token* nextToken = &tokens[idx + 1];
 
     if (nextToken->type == TokType::Number || nextToken->type == TokType::HexNumber ||
         nextToken->type == TokType::FloatNumber || nextToken->type == TokType::String ||
@@ -1348,7 +1350,7 @@ Node* Parser::parseSuffix(Node* base, std::string f) {
             bool isPtr = (peek()->type == TokType::Amp);
             if (isPtr) next();
 
-            std::string field = peek()->value;
+            std::string field = peek()->str();
             next();
 
             if (peek()->type == TokType::Rpar) base = parseCall(new NodeGet(base, field, isPtr, peek()->line));
@@ -1403,7 +1405,7 @@ Node* Parser::parseCall(Node* func) {
 Node* Parser::parseBasic(std::string f) {return parseSuffix(parsePrefix(f), f);}
 
 Node* Parser::parseExpr(std::string f) {
-    std::vector<Token*> operatorStack;
+    std::vector<const Token*> operatorStack;
     std::vector<Node*> nodeStack;
 
     nodeStack.push_back(parseBasic(f));
@@ -1468,7 +1470,7 @@ Node* Parser::parseFor(std::string f) {
     Node* cond;
     int curr = 0;
 
-    if (peek()->type == TokType::Semicolon && tokens[idx + 1]->type == TokType::Semicolon) {
+    if (peek()->type == TokType::Semicolon && tokens[idx + 1].type == TokType::Semicolon) {
         // Infinite loop
         idx += 3;
 
@@ -1486,11 +1488,11 @@ Node* Parser::parseFor(std::string f) {
         if (peek()->type == TokType::Comma) next();
 
         if (curr == 0) {
-            if (tokens[idx + 1]->type == TokType::Equ) presets.push_back(parseExpr(f));
-            else if (tokens[idx + 1]->type == TokType::Semicolon) {curr += 1; next();}
+            if (tokens[idx + 1].type == TokType::Equ) presets.push_back(parseExpr(f));
+            else if (tokens[idx + 1].type == TokType::Semicolon) {curr += 1; next();}
             else {
                 Type* type = parseType();
-                std::string name = peek()->value;
+                std::string name = peek()->str();
                 next();
                 if (peek()->type == TokType::Equ) {
                     next();
@@ -1515,7 +1517,13 @@ Node* Parser::parseForeach(std::string f) {
     int line = peek()->line;
     next(2);
 
-    NodeIden* elName = new NodeIden(peek()->value, line);
+    bool isReference = false;
+    if (peek()->type == TokType::Amp) {
+        isReference = true;
+        next();
+    }
+
+    NodeIden* elName = new NodeIden(peek()->str(), line);
     next();
 
     if (peek()->type != TokType::Semicolon) {
@@ -1531,7 +1539,7 @@ Node* Parser::parseForeach(std::string f) {
         next();
         Node* stmt = parseStmt(f);
         if (!instanceof<NodeBlock>(stmt)) stmt = new NodeBlock(std::vector<Node*>({stmt}));
-        return new NodeForeach(elName, dataVar, nullptr, (NodeBlock*)stmt, line);
+        return new NodeForeach(elName, dataVar, nullptr, (NodeBlock*)stmt, line, isReference);
     }
 
     if (peek()->type != TokType::Semicolon) {
@@ -1545,7 +1553,7 @@ Node* Parser::parseForeach(std::string f) {
 
     Node* stmt = parseStmt(f);
     if (!instanceof<NodeBlock>(stmt)) stmt = new NodeBlock(std::vector<Node*>({stmt}));
-    return new NodeForeach(elName, dataVar, lengthVar, (NodeBlock*)stmt, line);
+    return new NodeForeach(elName, dataVar, lengthVar, (NodeBlock*)stmt, line, isReference);
 }
 
 bool Parser::isTemplateVariable() {
@@ -1593,9 +1601,9 @@ Node* Parser::parseStmt(std::string f) {
     if (peek()->type == TokType::Semicolon) {next(); return parseStmt(f);}
     if (peek()->type == TokType::Eof) return nullptr;
     if (peek()->type == TokType::Identifier) {
-        std::string id = peek()->value;
+        std::string id = peek()->str();
 
-        if (tokens[idx + 1]->type == TokType::Less) {
+        if (tokens[idx + 1].type == TokType::Less) {
             if (isTemplateVariable()) {
                 std::vector<Node*> decl;
                 parseDecl(decl, f);
@@ -1619,10 +1627,10 @@ Node* Parser::parseStmt(std::string f) {
         if (id == "fdefer") return parseDefer(true, f);
         if (id == "defer") return parseDefer(false, f);
 
-        if (tokens[idx+1]->type == TokType::Rarr && tokens[idx+4]->type != TokType::Equ
-           && !TokType::isParent(tokens[idx+4]->type) && !TokType::isCompoundAssigment(tokens[idx+4]->type)
-           && tokens[idx+4]->type != TokType::Rarr && tokens[idx+4]->type != TokType::Dot) {
-            if (tokens[idx+2]->type == TokType::Number && tokens[idx+3]->type == TokType::Larr) {
+        if (tokens[idx+1].type == TokType::Rarr && tokens[idx+4].type != TokType::Equ
+           && !TokType::isParent(tokens[idx+4].type) && !TokType::isCompoundAssigment(tokens[idx+4].type)
+           && tokens[idx+4].type != TokType::Rarr && tokens[idx+4].type != TokType::Dot) {
+            if (tokens[idx+2].type == TokType::Number && tokens[idx+3].type == TokType::Larr) {
                 std::vector<Node*> decl;
                 parseDecl(decl, f);
                 return decl.size() > 1 ? new NodeBlock(decl) : decl[0];
@@ -1679,9 +1687,9 @@ Node* Parser::parseStmt(std::string f) {
                 return expr;
             }
 
+            std::string name = peek()->str();
             next();
 
-            std::string name = peek()->value;
             Node* value = nullptr;
             if (peek()->type == TokType::ValSel) {
                 next();
@@ -1695,6 +1703,16 @@ Node* Parser::parseStmt(std::string f) {
         }
         next();
 
+        // Loop modifiers: (unroll: 4, vectorize: 8) for (...) {...}
+        if (peek()->value == "while" || peek()->value == "for" || peek()->value == "foreach") {
+            Node* loop = parseStmt(f);
+
+            if (instanceof<NodeWhile>(loop)) ((NodeWhile*)loop)->mods = mods;
+            else if (instanceof<NodeFor>(loop)) ((NodeFor*)loop)->mods = mods;
+            else if (instanceof<NodeForeach>(loop)) ((NodeForeach*)loop)->mods = mods;
+            return loop;
+        }
+
         std::vector<Node*> decl;
         parseDecl(decl, f);
         return decl.size() > 1 ? new NodeBlock(decl) : decl[0];
@@ -1854,23 +1872,23 @@ Node* Parser::parseSlice(Node* base, std::string f) {
 }
 
 bool Parser::isDefinedLambda(bool updateIdx) {
-    const auto& nextToken = tokens[idx + 1];
+    const Token* nextToken = &tokens[idx + 1];
     if (nextToken->type != TokType::Rpar && nextToken->type != TokType::Multiply) return false;
 
     int oldIdx = idx;
     int cntOfRpars = 1;
 
     for (int i=idx + 2; i<tokens.size(); i++) {
-        const auto& token = tokens[i];
+        const Token& token = tokens[i];
         
-        if (token->type == TokType::Lpar) {
+        if (token.type == TokType::Lpar) {
             if (--cntOfRpars == 0) {
-                bool result = (i + 1 < tokens.size() && (tokens[i + 1]->type == TokType::Rbra || tokens[i + 1]->type == TokType::ShortRet));
+                bool result = (i + 1 < tokens.size() && (tokens[i + 1].type == TokType::Rbra || tokens[i + 1].type == TokType::ShortRet));
                 if (!updateIdx) idx = i;
                 return result;
             }
         }
-        else if (token->type == TokType::Rpar) ++cntOfRpars;
+        else if (token.type == TokType::Rpar) ++cntOfRpars;
     }
 
     return false;
@@ -1882,7 +1900,7 @@ Node* Parser::parseLambda() {
     std::string name = "";
 
     if (peek()->type == TokType::Identifier) {
-        name = peek()->value;
+        name = peek()->str();
         next();
     }
 
@@ -1908,7 +1926,7 @@ std::vector<Node*> Parser::parseFuncCallArgs() {
     while (peek()->type != TokType::Lpar) {
         if (peek()->type == TokType::Identifier) {
             if (isDefinedLambda()) buffer.push_back(parseLambda());
-            else if (isBasicType(peek()->value)) buffer.push_back(new NodeType(parseType(), peek()->line));
+            else if (isBasicType(peek()->str())) buffer.push_back(new NodeType(parseType(), peek()->line));
             else buffer.push_back(parseExpr());
         }
         else buffer.push_back(parseExpr());
@@ -0,0 +1,116 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "./include/timeTrace.hpp"
+#include "./include/json.hpp"
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+
+#ifdef _WIN32
+   #include <process.h>
+   #define getpid _getpid
+#else
+   #include <unistd.h>
+#endif
+
+namespace TimeTrace {
+    bool enabled = false;
+
+    struct Span {
+        std::string name;
+        std::string detail;
+        double start;
+        double duration;
+        int pid;
+        int tid;
+    };
+
+    // Shared by every thread; forked workers inherit the origin, so their timestamps line up with the parent's
+    static auto origin = std::chrono::steady_clock::now();
+    static std::vector<Span> spans;
+    static std::mutex spansMutex;
+    static std::atomic<int> threadCount(0);
+
+    static thread_local std::vector<Span> openSpans;
+    static thread_local int threadId = -1;
+
+    static double now() {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void begin(const std::string& name, const std::string& detail) {
+        if (!enabled) return;
+        if (threadId < 0) threadId = threadCount++;
+        openSpans.push_back(Span{name, detail, now(), 0.0, 0, threadId});
+    }
+
+    void end() {
+        if (!enabled || openSpans.empty()) return;
+
+        Span span = openSpans.back();
+        openSpans.pop_back();
+
+        span.duration = now() - span.start;
+        span.pid = getpid();
+
+        std::lock_guard<std::mutex> lock(spansMutex);
+        spans.push_back(span);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(spansMutex);
+        spans.clear();
+    }
+
+    void save(FILE* file) {
+        std::lock_guard<std::mutex> lock(spansMutex);
+
+        for (const auto& span : spans) {
+            nlohmann::json line = {{"n", span.name}, {"d", span.detail}, {"s", span.start}, {"u", span.duration}, {"p", span.pid}, {"t", span.tid}};
+            fprintf(file, "%s\n", line.dump().c_str());
+        }
+    }
+
+    void load(FILE* file) {
+        std::string content = "";
+        char buffer[4096];
+        size_t count;
+
+        rewind(file);
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) content.append(buffer, count);
+
+        std::lock_guard<std::mutex> lock(spansMutex);
+        size_t start = 0;
+
+        while (start < content.size()) {
+            size_t end = content.find('\n', start);
+            if (end == std::string::npos) end = content.size();
+
+            nlohmann::json line = nlohmann::json::parse(content.substr(start, end - start), nullptr, false);
+            if (!line.is_discarded()) spans.push_back(Span{line["n"], line["d"], line["s"], line["u"], line["p"], line["t"]});
+
+            start = end + 1;
+        }
+    }
+
+    void write(const std::string& path) {
+        nlohmann::json events = nlohmann::json::array();
+
+        std::lock_guard<std::mutex> lock(spansMutex);
+
+        for (const auto& span : spans) {
+            nlohmann::json event = {{"name", span.name}, {"cat", "rave"}, {"ph", "X"}, {"ts", span.start}, {"dur", span.duration}, {"pid", span.pid}, {"tid", span.tid}};
+            if (span.detail != "") event["args"] = {{"detail", span.detail}};
+            events.push_back(event);
+        }
+
+        std::ofstream output(path);
+        output << nlohmann::json({{"traceEvents", events}, {"displayTimeUnit", "ms"}}).dump() << std::endl;
+    }
+}
@@ -0,0 +1,101 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Lexer microbenchmark: ./tests/bench_lexer [file.rave] [megabytes]
+// Without a file it lexes a synthetic corpus of typical Rave code.
+
+#include "../../src/include/lexer/lexer.hpp"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <cstdlib>
+
+std::string exePath = "./";
+
+static const char* sample = R"(import <std/io> <std/vector>
+
+// Synthetic corpus for the lexer benchmark
+namespace bench {
+    struct Point {
+        int x;
+        int y;
+
+        Point this(int x, int y) {
+            Point this;
+            this.x = x;
+            this.y = y;
+        } => this;
+
+        /* Manhattan distance
+           between two points */
+        int distance(Point other) => std::abs(this.x - other.x) + std::abs(this.y - other.y);
+    }
+
+    (inline) uint hash(char* str, usize length) {
+        uint h = 0x811C9DC5;
+        for (usize i=0; i<length; i++) {
+            h = (h !! cast(uint)str[i]) * 16777619;
+        }
+    } => h;
+}
+
+void main {
+    std::vector<bench::Point> points = std::vector<bench::Point>();
+    for (int i=0; i<1000; i++) points.add(bench::Point(i, i * 2));
+
+    double total = 0.5;
+    foreach (p; points) total += cast(double)p.distance(bench::Point(0, 0));
+
+    if ((total >= 100.25) && (points.length != 0)) std::println("total: ", total, '\n');
+    char c = '\'';
+    @if(@aliasExists(__RAVE_OS)) std::println("\033[32mdone\033[0m");
+}
+)";
+
+int main(int argc, char** argv) {
+    std::string unit = sample;
+
+    if (argc > 1) {
+        std::ifstream file(argv[1]);
+        if (!file) {
+            std::cerr << "Cannot open '" << argv[1] << "'\n";
+            return 1;
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        unit = buffer.str();
+    }
+
+    size_t targetSize = (argc > 2 ? std::atoi(argv[2]) : 32) * 1024 * 1024;
+    std::string corpus;
+    corpus.reserve(targetSize + unit.size());
+    while (corpus.size() < targetSize) corpus += unit;
+
+    double best = 0;
+    size_t tokenCount = 0;
+
+    for (int run=0; run<5; run++) {
+        // The lexer takes the source by value, so it is copied before the clock starts
+        std::string source = corpus;
+
+        auto start = std::chrono::steady_clock::now();
+        Lexer lexer(std::move(source), 0);
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (best == 0 || seconds < best) best = seconds;
+        tokenCount = lexer.tokens.size();
+    }
+
+    std::cout << "Lexed " << corpus.size() / (1024 * 1024) << " MB (" << tokenCount << " tokens) in " << best * 1000 << "ms (best of 5): "
+        << (corpus.size() / (1024.0 * 1024.0)) / best << " MB/s, " << (tokenCount / best) / 1000000 << "M tokens/s\n";
+
+    return 0;
+}
@@ -22,8 +22,11 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../src/include/parser/nodes/NodeComptime.hpp"
 #include "../../src/include/parser/nodes/NodeLoopControl.hpp"
 #include "../../src/include/lexer/tokens.hpp"
+#include "../../src/include/lexer/lexer.hpp"
+#include "../../src/include/parser/parser.hpp"
 #include <llvm-c/Core.h>
 #include <llvm-c/Target.h>
+#include <algorithm>
 
 std::string exePath = "";
 
@@ -51,6 +54,75 @@ void setupLLVM() {
     LLVMInitializeNativeAsmParser();
 }
 
+// Parses, checks and generates the source into the module of the generator
+void generateSource(const std::string& source) {
+    Lexer lexer(source, 1);
+    Parser parser(lexer.tokens, "test.rave");
+    parser.parseAll();
+
+    for (Node* node : parser.nodes) node->check();
+    for (Node* node : parser.nodes) node->generate();
+}
+
+LLVMValueRef getFunction(const std::string& name) {
+    auto it = generator->functions.find(Symbol(name));
+    return (it == generator->functions.end()) ? nullptr : it->second.value;
+}
+
+// Returns the first instruction with the opcode, or nullptr
+LLVMValueRef findInstruction(LLVMValueRef fn, LLVMOpcode opcode) {
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+            if (LLVMGetInstructionOpcode(instr) == opcode) return instr;
+        }
+    }
+    return nullptr;
+}
+
+// Out-of-line stub of the null checks of the function, or nullptr
+LLVMValueRef getCheckStub(LLVMValueRef fn) {
+    return (fn == nullptr) ? nullptr : LLVMGetNamedFunction(generator->lModule, (std::string(LLVMGetValueName(fn)) + ".checkFailed").c_str());
+}
+// Returns the first instruction whose name starts with the prefix (LLVM numbers repeated names), or nullptr
+LLVMValueRef findNamed(LLVMValueRef fn, const std::string& prefix) {
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+            if (std::string(LLVMGetValueName(instr)).rfind(prefix, 0) == 0) return instr;
+        }
+    }
+    return nullptr;
+}
+// Names of the llvm.loop properties of the branch (empty if it has no loop ID)
+std::vector<std::string> loopProperties(LLVMValueRef branch) {
+    std::vector<std::string> names;
+    LLVMValueRef loopID = LLVMGetMetadata(branch, LLVMGetMDKindIDInContext(generator->context, "llvm.loop", 9));
+    if (loopID == nullptr) return names;
+
+    std::vector<LLVMValueRef> properties(LLVMGetMDNodeNumOperands(loopID));
+    LLVMGetMDNodeOperands(loopID, properties.data());
+
+    for (LLVMValueRef property : properties) {
+        if (property == loopID || LLVMIsAMDNode(property) == nullptr || LLVMGetMDNodeNumOperands(property) == 0) continue;
+
+        std::vector<LLVMValueRef> values(LLVMGetMDNodeNumOperands(property));
+        LLVMGetMDNodeOperands(property, values.data());
+        unsigned length = 0;
+        const char* name = LLVMGetMDString(values[0], &length);
+        if (name != nullptr) names.push_back(std::string(name, length));
+    }
+
+    return names;
+}
+int countCalls(LLVMValueRef fn, LLVMValueRef callee) {
+    int count = 0;
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+        for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+            if (LLVMIsACallInst(instr) && LLVMGetCalledValue(instr) == callee) count += 1;
+        }
+    }
+    return count;
+}
+
 int main() {
     TestRunner test;
 
@@ -293,6 +365,158 @@ int main() {
         delete copied;
     }
 
+    // Test NodeSwitch lowering: one switch instruction for constant integer cases
+    {
+        generateSource("int switchDup(int x) {switch (x) {case(1) return = 10; case(1) return = 20; case(2) return = 30;}}");
+        LLVMValueRef _switch = findInstruction(getFunction("switchDup"), LLVMSwitch);
+        TEST("NodeSwitch with constant cases is a switch instruction") EXPECT_NOT_NULL(_switch);
+        if (_switch != nullptr) {
+            TEST("NodeSwitch drops duplicate cases") EXPECT_EQ(LLVMGetNumSuccessors(_switch), 3u);
+            LLVMValueRef store = LLVMGetFirstInstruction(LLVMGetSuccessor(_switch, 1));
+            TEST("NodeSwitch keeps the first duplicate case") EXPECT_TRUE(store != nullptr && LLVMIsAStoreInst(store) && LLVMConstIntGetSExtValue(LLVMGetOperand(store, 0)) == 10);
+            TEST("NodeSwitch without default goes to the end") EXPECT_EQ(std::string(LLVMGetBasicBlockName(LLVMGetSwitchDefaultDest(_switch))), "end");
+        }
+    }
+
+    {
+        generateSource("int switchNarrow(char c) {switch (c) {case(300) return = 1; case(-1) return = 2;}} int switchUnsigned(uchar c) {switch (c) {case(-1) return = 1; case(255) return = 2;}}");
+        LLVMValueRef _switch = findInstruction(getFunction("switchNarrow"), LLVMSwitch);
+        TEST("NodeSwitch drops cases out of the char range") EXPECT_TRUE(_switch != nullptr && LLVMGetNumSuccessors(_switch) == 2);
+        _switch = findInstruction(getFunction("switchUnsigned"), LLVMSwitch);
+        TEST("NodeSwitch drops negative cases of unsigned values") EXPECT_TRUE(_switch != nullptr && LLVMGetNumSuccessors(_switch) == 2);
+        if (_switch != nullptr) TEST("NodeSwitch keeps 255 for uchar") EXPECT_EQ(LLVMConstIntGetZExtValue(LLVMGetOperand(_switch, 2)), 255ull);
+    }
+
+    {
+        generateSource("int switchDefault(int x) {switch (x) {case(1) return = 1; default return = 2;}}");
+        LLVMValueRef _switch = findInstruction(getFunction("switchDefault"), LLVMSwitch);
+        TEST("NodeSwitch generates the default branch") EXPECT_TRUE(_switch != nullptr && std::string(LLVMGetBasicBlockName(LLVMGetSwitchDefaultDest(_switch))) == "default");
+    }
+
+    // Test NodeSwitch lowering: the value is generated once in the if-chain
+    {
+        generateSource("int switchKey(int x) {return = x;} int switchMixed(int x, int y) {switch (switchKey(x)) {case(1) return = 1; case(y) return = 2; case(3) return = 3;}}");
+        LLVMValueRef fn = getFunction("switchMixed");
+        TEST("NodeSwitch with a variable case is an if-chain") EXPECT_TRUE(fn != nullptr && findInstruction(fn, LLVMSwitch) == nullptr);
+        TEST("NodeSwitch with a variable case generates the value once") EXPECT_EQ(countCalls(fn, getFunction("switchKey")), 1);
+    }
+
+    {
+        generateSource("double switchKeyF(double x) {return = x;} int switchFloat(double x) {switch (switchKeyF(x)) {case(1.0) return = 1; case(2.0) return = 2;}}");
+        TEST("NodeSwitch on a float generates the value once") EXPECT_EQ(countCalls(getFunction("switchFloat"), getFunction("switchKeyF")), 1);
+    }
+
+    // Test Checks: the test sources have no prelude, so the stubs trap
+    {
+        generateSource("int checkTwice(int* p) {return = p[0] + p[1];}");
+        LLVMValueRef fn = getFunction("checkTwice");
+        LLVMValueRef stub = getCheckStub(fn);
+        TEST("Checks generate the stub of the function") EXPECT_NOT_NULL(stub);
+        if (stub != nullptr) {
+            TEST("Checks stub traps without the prelude") EXPECT_EQ(countCalls(stub, LLVMGetNamedFunction(generator->lModule, "llvm.trap")), 1);
+            TEST("Checks remove the dominated check") EXPECT_EQ(countCalls(fn, stub), 1);
+        }
+    }
+
+    // Test Checks: the check of an invariant pointer leaves the body of a counted loop
+    {
+        generateSource("void hoistFill(int* d, int n) {for (int i=0; i<n; i++) d[i] = 0;}");
+        LLVMValueRef fn = getFunction("hoistFill");
+        LLVMValueRef hoisted = (fn == nullptr) ? nullptr : findNamed(fn, "isEnteredNull");
+        TEST("Checks hoist the check out of the loop") EXPECT_TRUE(hoisted != nullptr && LLVMGetInstructionParent(hoisted) == LLVMGetEntryBasicBlock(fn));
+        TEST("Checks leave the body of the loop without checks") EXPECT_EQ(countCalls(fn, getCheckStub(fn)), 1);
+
+        // A loop that is not entered does not fail on a null pointer
+        if (hoisted != nullptr) {
+            LLVMValueRef entered = LLVMGetOperand(hoisted, 0);
+            TEST("Checks test the hoisted check only if the loop is entered") EXPECT_TRUE(LLVMGetInstructionOpcode(hoisted) == LLVMAnd && LLVMIsAICmpInst(entered) && LLVMGetICmpPredicate(entered) == LLVMIntSLT);
+        }
+    }
+
+    {
+        generateSource("void hoistStore(int* d, int* e, int n) {int* p = d; for (int i=0; i<n; i++) {p[i] = 0; p = e;}}");
+        LLVMValueRef fn = getFunction("hoistStore");
+        TEST("Checks do not hoist the check of a variable stored in the loop") EXPECT_TRUE(fn != nullptr && findNamed(fn, "isEnteredNull") == nullptr && countCalls(fn, getCheckStub(fn)) == 1);
+    }
+
+    {
+        generateSource("extern(linkname: \"llvm.debugtrap\") void hoistTrap(); void hoistAfterTrap(int* d, int n) {for (int i=0; i<n; i++) {hoistTrap(); d[i] = 0;}}");
+        LLVMValueRef fn = getFunction("hoistAfterTrap");
+        TEST("Checks do not hoist the check over a trap") EXPECT_TRUE(fn != nullptr && findNamed(fn, "isEnteredNull") == nullptr);
+    }
+
+    {
+        generateSource("void hoistNested(int* d, int n) {for (int i=0; i<n; i++) for (int j=0; j<n; j++) d[j] = i;}");
+        LLVMValueRef fn = getFunction("hoistNested");
+        LLVMValueRef hoisted = (fn == nullptr) ? nullptr : findNamed(fn, "isEnteredNull");
+        TEST("Checks keep the check hoisted out of the inner loop in the outer one") EXPECT_TRUE(hoisted != nullptr && LLVMGetInstructionParent(hoisted) != LLVMGetEntryBasicBlock(fn));
+        TEST("Checks leave one check in the nested loops") EXPECT_EQ(countCalls(fn, getCheckStub(fn)), 1);
+    }
+
+    {
+        generateSource("void hoistBounds(int* d, int n, int m) {for (int i=0; i<n; i++) for (int j=0; j<m; j++) d[j] = i;}");
+        LLVMValueRef fn = getFunction("hoistBounds");
+        LLVMValueRef hoisted = (fn == nullptr) ? nullptr : findNamed(fn, "isEnteredNull");
+        LLVMValueRef entered = (hoisted == nullptr) ? nullptr : LLVMGetOperand(hoisted, 0);
+        TEST("Checks test the inner bound before the hoisted check") EXPECT_TRUE(entered != nullptr && LLVMIsAICmpInst(entered) &&
+            LLVMGetInstructionParent(entered) == LLVMGetInstructionParent(hoisted) && LLVMGetInstructionParent(hoisted) != LLVMGetEntryBasicBlock(fn));
+        TEST("Checks leave one check in the loops with separate bounds") EXPECT_EQ(countCalls(fn, getCheckStub(fn)), 1);
+    }
+
+    // Test NodeForeach lowering: a counted loop over an usize index with the length evaluated once
+    {
+        generateSource("int feSum(int* d, int n) {foreach (x; d; n) return += x;} int feSumU(int* d, uint n) {foreach (x; d; n) return += x;}");
+        LLVMValueRef fn = getFunction("feSum");
+        LLVMValueRef counter = (fn == nullptr) ? nullptr : findNamed(fn, "__RAVE_FOREACH_N");
+        TEST("NodeForeach counter is usize") EXPECT_TRUE(counter != nullptr && LLVMIsAAllocaInst(counter) &&
+            LLVMGetIntTypeWidth(LLVMGetAllocatedType(counter)) == ((TypeBasic*)getTypeByName("usize"))->getSize());
+        TEST("NodeForeach clamps a negative signed length") EXPECT_TRUE(fn != nullptr && findInstruction(fn, LLVMSelect) != nullptr);
+        fn = getFunction("feSumU");
+        TEST("NodeForeach does not clamp an unsigned length") EXPECT_TRUE(fn != nullptr && findInstruction(fn, LLVMSelect) == nullptr);
+    }
+
+    {
+        generateSource("void feRef(int* d) {foreach (&x; d; 4) x[0] = 1;}");
+        LLVMValueRef fn = getFunction("feRef");
+        LLVMValueRef element = (fn == nullptr) ? nullptr : findNamed(fn, "x");
+        TEST("NodeForeach binds a pointer to the element") EXPECT_TRUE(element != nullptr && LLVMIsAAllocaInst(element) &&
+            LLVMGetTypeKind(LLVMGetAllocatedType(element)) == LLVMPointerTypeKind);
+    }
+
+    // Test LoopHints: the modifiers are the loop ID of the latch only
+    {
+        auto getLoopIDs = [](LLVMValueRef fn) {
+            std::vector<std::vector<std::string>> loopIDs;
+
+            for (LLVMBasicBlockRef block = (fn == nullptr) ? nullptr : LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+                std::vector<std::string> names = loopProperties(LLVMGetBasicBlockTerminator(block));
+                if (!names.empty()) loopIDs.push_back(names);
+            }
+
+            return loopIDs;
+        };
+
+        generateSource("void hintLoop(int* d, int n) {(unroll: 4, distribute) for (int i=0; i<n; i++) d[i] = 0;}");
+        std::vector<std::vector<std::string>> loopIDs = getLoopIDs(getFunction("hintLoop"));
+
+        TEST("LoopHints attach the loop ID to the latch only") EXPECT_EQ(loopIDs.size(), (size_t)1);
+        if (loopIDs.size() == 1) {
+            auto has = [&](const char* name) {return std::find(loopIDs[0].begin(), loopIDs[0].end(), name) != loopIDs[0].end();};
+            TEST("LoopHints lower unroll: 4") EXPECT_TRUE(has("llvm.loop.unroll.count"));
+            TEST("LoopHints lower distribute with a followup") EXPECT_TRUE(has("llvm.loop.distribute.enable") && has("llvm.loop.distribute.followup_all"));
+            TEST("LoopHints do not mark the loop without -remarks") EXPECT_TRUE(!has("rave.loop.file") && !has("rave.loop.line"));
+        }
+
+        generator->settings.remarks = true;
+        generateSource("void hintReported(int* d, int n) {(unroll: 4) for (int i=0; i<n; i++) d[i] = 0;}");
+        generator->settings.remarks = false;
+
+        loopIDs = getLoopIDs(getFunction("hintReported"));
+        TEST("LoopHints mark the loop with its file and line for -remarks") EXPECT_TRUE(loopIDs.size() == 1 &&
+            std::find(loopIDs[0].begin(), loopIDs[0].end(), "rave.loop.file") != loopIDs[0].end() &&
+            std::find(loopIDs[0].begin(), loopIDs[0].end(), "rave.loop.line") != loopIDs[0].end());
+    }
+
     delete generator;
 
     return test.summary();
@@ -14,6 +14,25 @@ with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "../../src/include/parser/nodes/NodeInt.hpp"
 #include "../../src/include/parser/nodes/NodeBinary.hpp"
 #include "../../src/include/parser/nodes/NodeIden.hpp"
+#include "../../src/include/parser/nodes/NodeFunc.hpp"
+#include "../../src/include/parser/nodes/NodeStruct.hpp"
+#include "../../src/include/parser/nodes/NodeCall.hpp"
+#include "../../src/include/parser/nodes/NodeForeach.hpp"
+#include "../../src/include/parser/nodes/NodeFor.hpp"
+#include "../../src/include/parser/nodes/NodeBlock.hpp"
+#include "../../src/include/parser/ASTCache.hpp"
+#include "../../src/include/parser/FuncRegistry.hpp"
+#include "../../src/include/parser/Symbol.hpp"
+#include "../../src/include/parser/ast.hpp"
+#include <unistd.h>
+
+#if __cplusplus >= 201703L && __has_include(<filesystem>)
+#include <filesystem>
+    namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#    include <experimental/filesystem>
+    namespace fs = std::experimental::filesystem;
+#endif
 
 // Required global variables
 std::string exePath = "./";
@@ -29,6 +48,16 @@ void initBasicTypes() {
     pointerSize = 64;
 }
 
+// Parses the source of one function and returns the nodes of its body (empty if the source is not one function)
+std::vector<Node*> parseFunctionBody(const std::string& source) {
+    Lexer lexer(source, 1);
+    Parser parser(lexer.tokens, "test.rave");
+    parser.parseAll();
+
+    if (parser.nodes.size() != 1 || !instanceof<NodeFunc>(parser.nodes[0])) return {};
+    return ((NodeFunc*)parser.nodes[0])->block->nodes;
+}
+
 int main() {
     TestRunner test;
     initBasicTypes();
@@ -56,24 +85,56 @@ int main() {
     TEST("TypeArray getSize") EXPECT_EQ(intArray->getSize(), 320);
     TEST("TypeArray getElType") EXPECT_EQ(intArray->getElType(), basicTypes[BasicType::Int]);
 
+    // Test interned type keys
+    TypePointer* otherIntPtr = new TypePointer(basicTypes[BasicType::Int]);
+    TEST("Type key is the rendering") EXPECT_EQ(Types::key(intArray).str(), intArray->toString());
+    TEST("Equal types share the key") EXPECT_EQ(Types::key(intPtr).id, Types::key(otherIntPtr).id);
+    TEST("Const has the key of its type") EXPECT_EQ(Types::key(new TypeConst(intPtr)).id, Types::key(intPtr).id);
+    TEST("Different types have different keys") EXPECT_TRUE(Types::key(intPtr) != Types::key(new TypePointer(intPtr)));
+    TEST("typesEqual compares keys") EXPECT_TRUE(Types::typesEqual(intPtr, otherIntPtr));
+
+    // Test kind-based RTTI
+    Type* arrayAsType = intArray;
+    TEST("isa matches the kind") EXPECT_TRUE(isa<TypeArray>(arrayAsType));
+    TEST("instanceof rejects other kinds") EXPECT_TRUE(!instanceof<TypePointer>(arrayAsType));
+    TEST("instanceof rejects null") EXPECT_TRUE(!instanceof<TypeArray>((Type*)nullptr));
+    TEST("dyn_cast returns the object") EXPECT_EQ(dyn_cast<TypeArray>(arrayAsType), intArray);
+    TEST("dyn_cast returns null for other kinds") EXPECT_TRUE(dyn_cast<TypePointer>(arrayAsType) == nullptr);
+
+    // Test the node/type arena
+    {
+        Arena arena;
+        Arena::Scope arenaScope(&arena);
+
+        NodeIden* arenaIden = new NodeIden("arenaValue", 1);
+        TypePointer* arenaPointer = new TypePointer(basicTypes[BasicType::Int]);
+        TEST("Arena takes new nodes and types") EXPECT_TRUE(arena.used() >= sizeof(NodeIden) + sizeof(TypePointer));
+        TEST("Arena objects are usable") EXPECT_EQ(arenaPointer->toString(), std::string("int*"));
+
+        delete arenaIden;
+        arena.release();
+        TEST("Arena release frees everything") EXPECT_EQ(arena.used(), (size_t)0);
+    }
+    TEST("Arena scope restores the heap") EXPECT_TRUE(Arena::current == nullptr);
+
     // Test Parser token handling
-    std::vector<Token*> tokens = {
-        new Token(TokType::Number, "42", 1),
-        new Token(TokType::Eof, "", 1)
+    std::vector<Token> tokens = {
+        Token(TokType::Number, "42", 1),
+        Token(TokType::Eof, "", 1)
     };
     Parser parser(tokens, "test.rave");
     TEST("Parser peek") EXPECT_EQ(parser.peek()->type, TokType::Number);
-    TEST("Parser peek value") EXPECT_EQ(parser.peek()->value, std::string("42"));
+    TEST("Parser peek value") EXPECT_EQ(parser.peek()->str(), std::string("42"));
 
     parser.next();
     TEST("Parser next") EXPECT_EQ(parser.peek()->type, TokType::Eof);
 
     // Test simple expression parsing
-    std::vector<Token*> exprTokens = {
-        new Token(TokType::Number, "5", 1),
-        new Token(TokType::Plus, "+", 1),
-        new Token(TokType::Number, "3", 1),
-        new Token(TokType::Eof, "", 1)
+    std::vector<Token> exprTokens = {
+        Token(TokType::Number, "5", 1),
+        Token(TokType::Plus, "+", 1),
+        Token(TokType::Number, "3", 1),
+        Token(TokType::Eof, "", 1)
     };
     Parser exprParser(exprTokens, "test.rave");
     Node* expr = exprParser.parseExpr("");
@@ -81,9 +142,9 @@ int main() {
     TEST("Binary expression is NodeBinary") EXPECT_TRUE(instanceof<NodeBinary>(expr));
 
     // Test identifier parsing
-    std::vector<Token*> idenTokens = {
-        new Token(TokType::Identifier, "myVar", 1),
-        new Token(TokType::Eof, "", 1)
+    std::vector<Token> idenTokens = {
+        Token(TokType::Identifier, "myVar", 1),
+        Token(TokType::Eof, "", 1)
     };
     Parser idenParser(idenTokens, "test.rave");
     Node* iden = idenParser.parseAtom("");
@@ -93,6 +154,29 @@ int main() {
         TEST("Identifier name") EXPECT_EQ(((NodeIden*)iden)->name, std::string("myVar"));
     }
 
+    // Test Lexer token values
+    Lexer lexer("std::io @sizeOf(x) 0x1F 3.5 \"a\\tb\"", 0);
+    TEST("Lexer token count") EXPECT_EQ(lexer.tokens.size(), (size_t)9);
+    if (lexer.tokens.size() == 9) {
+        TEST("Lexer namespaced identifier") EXPECT_EQ(lexer.tokens[0].str(), std::string("std::io"));
+        TEST("Lexer builtin") EXPECT_EQ(lexer.tokens[1].str(), std::string("@sizeOf"));
+        TEST("Lexer hex number") EXPECT_EQ(lexer.tokens[5].str(), std::string("1F"));
+        TEST("Lexer float number") EXPECT_EQ(lexer.tokens[6].type, TokType::FloatNumber);
+        TEST("Lexer string literal") EXPECT_EQ(lexer.tokens[7].str(), std::string("a\tb"));
+        TEST("Lexer EOF") EXPECT_EQ(lexer.tokens[8].type, TokType::Eof);
+    }
+
+    // Test Symbol interning
+    Symbol first("std::println"), second(std::string("std::") + "println");
+    TEST("Symbol interns equal names") EXPECT_EQ(first.id, second.id);
+    TEST("Symbol keeps the name") EXPECT_EQ(first.str(), std::string("std::println"));
+    TEST("Symbol lookup does not intern") EXPECT_TRUE(Symbol::lookup("__never_interned__").empty());
+    TEST("Empty symbol") EXPECT_EQ(Symbol("").id, (uint32_t)0);
+
+    size_t internedCount = Symbol::count();
+    Call::resolveAlias(std::string("__missing_") + "alias__");
+    TEST("Table probes do not intern missing names") EXPECT_EQ(Symbol::count(), internedCount);
+
     // Test TypeUtils
     std::string intStr = typeToString(basicTypes[BasicType::Int]);
     TEST("typeToString int") EXPECT_EQ(intStr, std::string("i"));
@@ -104,5 +188,126 @@ int main() {
     std::string ptrStr = typeToString(charPtr);
     TEST("typeToString pointer") EXPECT_EQ(ptrStr, std::string("pc"));
 
+    // Test the template argument cache
+    std::vector<Type*> firstArgs = Template::parseTemplateTypes("int,char*");
+    std::vector<Type*> secondArgs = Template::parseTemplateTypes("int,char*");
+    TEST("Template arguments are parsed") EXPECT_EQ(firstArgs.size(), (size_t)2);
+    if (firstArgs.size() == 2 && secondArgs.size() == 2) {
+        TEST("Cached template arguments are copies") EXPECT_TRUE(firstArgs[1] != secondArgs[1]);
+        TEST("Cached template arguments keep the types") EXPECT_EQ(Types::key(secondArgs[1]).str(), std::string("char*"));
+    }
+    Template::clearCache();
+
+    // Test foreach binding the element by reference (the lowering is tested in test_nodes)
+    std::vector<Node*> foreachLoops = parseFunctionBody("void fill(int* d) {foreach (&x; d; 4) x[0] = 1; foreach (y; d; 4) d[0] = y;}");
+    TEST("Parse foreach") EXPECT_TRUE(foreachLoops.size() == 2 && instanceof<NodeForeach>(foreachLoops[0]) && instanceof<NodeForeach>(foreachLoops[1]));
+    if (foreachLoops.size() == 2 && instanceof<NodeForeach>(foreachLoops[0]) && instanceof<NodeForeach>(foreachLoops[1])) {
+        TEST("Foreach element by reference") EXPECT_TRUE(((NodeForeach*)foreachLoops[0])->isReference);
+        TEST("Foreach element name") EXPECT_EQ(((NodeForeach*)foreachLoops[0])->elName->name, std::string("x"));
+        TEST("Foreach element by value") EXPECT_TRUE(!((NodeForeach*)foreachLoops[1])->isReference);
+    }
+
+    // Test loop modifiers (the lowering is tested in test_nodes)
+    std::vector<Node*> hintedLoops = parseFunctionBody("void clear(int* d) {(unroll: 4, distribute) for (int i=0; i<4; i++) d[i] = 0;}");
+    TEST("Parse loop with modifiers") EXPECT_TRUE(hintedLoops.size() == 1 && instanceof<NodeFor>(hintedLoops[0]));
+    if (hintedLoops.size() == 1 && instanceof<NodeFor>(hintedLoops[0])) {
+        std::vector<DeclarMod>& mods = ((NodeFor*)hintedLoops[0])->mods;
+        TEST("Loop modifiers count") EXPECT_EQ(mods.size(), (size_t)2);
+        if (mods.size() == 2) {
+            TEST("Loop modifier name") EXPECT_EQ(mods[0].name, std::string("unroll"));
+            TEST("Loop modifier value") EXPECT_TRUE(instanceof<NodeInt>(mods[0].value));
+            TEST("Loop modifier without value") EXPECT_TRUE(mods[1].name == "distribute" && mods[1].value == nullptr);
+        }
+    }
+
+    // Test ASTCache round trip; the cache is under exePath, so it is moved to a temporary directory
+    std::string savedExePath = exePath;
+    exePath = (fs::temp_directory_path() / ("rave-ast-cache-test-" + std::to_string(getpid()))).string() + "/";
+
+    std::string cacheSource = "int inc(int a) => a + 1; struct Point {int x; int y;}";
+    Lexer cacheLexer(cacheSource, 1);
+    Parser cacheParser(cacheLexer.tokens, "cache_test.rave");
+    cacheParser.parseAll();
+    ASTCache::save("cache_test.rave", cacheSource, cacheParser.nodes);
+
+    std::vector<Node*> cached;
+    TEST("ASTCache loads saved nodes") EXPECT_TRUE(ASTCache::load("cache_test.rave", cacheSource, cached));
+    TEST("ASTCache keeps node count") EXPECT_EQ(cached.size(), cacheParser.nodes.size());
+    if (cached.size() == 2 && instanceof<NodeFunc>(cached[0]) && instanceof<NodeStruct>(cached[1])) {
+        TEST("ASTCache restores function") EXPECT_EQ(((NodeFunc*)cached[0])->name, std::string("inc"));
+        TEST("ASTCache restores arguments") EXPECT_EQ(((NodeFunc*)cached[0])->args.size(), (size_t)1);
+        TEST("ASTCache restores struct fields") EXPECT_EQ(((NodeStruct*)cached[1])->variables.size(), (size_t)2);
+    }
+
+    std::vector<Node*> stale;
+    TEST("ASTCache misses on changed content") EXPECT_TRUE(!ASTCache::load("cache_test.rave", cacheSource + " ", stale));
+
+    std::error_code cacheError;
+    fs::remove_all(exePath, cacheError);
+    exePath = savedExePath;
+
+    // Test copy-on-write bodies of imported functions
+    std::vector<Node*> parsedNodes;
+    {
+        Arena::Scope arenaScope(&AST::parsedArena);
+        Lexer importLexer("int twice(int a) => a * 2;", 1);
+        Parser importParser(importLexer.tokens, "import_test.rave");
+        importParser.parseAll();
+        parsedNodes = importParser.nodes;
+    }
+
+    if (parsedNodes.size() == 1 && instanceof<NodeFunc>(parsedNodes[0])) {
+        NodeFunc* parsedFunc = (NodeFunc*)parsedNodes[0];
+        NodeFunc* imported = (NodeFunc*)parsedFunc->copy();
+        TEST("Imported function shares the parsed body") EXPECT_TRUE(imported->isBlockShared && imported->block == parsedFunc->block);
+        TEST("ownBlock copies the shared body") EXPECT_TRUE(imported->ownBlock() != parsedFunc->block && !imported->isBlockShared);
+
+        NodeFunc* local = (NodeFunc*)imported->copy();
+        TEST("Other copies do not share the body") EXPECT_TRUE(!local->isBlockShared && local->block != imported->block);
+    }
+
+    // Test overload resolution in FuncRegistry
+    FuncRegistry& registry = FuncRegistry::instance();
+    registry.clear();
+
+    Type* intType = basicTypes[BasicType::Int];
+    Type* floatType = basicTypes[BasicType::Float];
+    NodeFunc* sumInt = new NodeFunc("sum", {FuncArgSet{.name = "a", .type = intType}}, nullptr, true, {}, 1, intType, {});
+    NodeFunc* sumFloat = new NodeFunc("sum[_f]", {FuncArgSet{.name = "a", .type = floatType}}, nullptr, true, {}, 1, floatType, {});
+    registry.registerFunc(sumInt);
+    registry.registerFunc(sumFloat);
+
+    TEST("FuncRegistry picks the exact overload") EXPECT_TRUE(registry.findBestMatch("sum", {floatType}) == sumFloat);
+    TEST("FuncRegistry repeats the resolved call") EXPECT_TRUE(registry.findBestMatch("sum", {floatType}) == sumFloat);
+    TEST("FuncRegistry converts the basic types") EXPECT_TRUE(registry.findBestMatch("sum", {basicTypes[BasicType::Long]}) == sumInt);
+    TEST("FuncRegistry checks the number of arguments") EXPECT_TRUE(registry.findBestMatch("sum", {intType, intType}) == nullptr);
+
+    NodeFunc* sumPair = new NodeFunc("sum[_i_i]", {FuncArgSet{.name = "a", .type = intType}, FuncArgSet{.name = "b", .type = intType}},
+        nullptr, true, {}, 1, intType, {});
+    registry.registerFunc(sumPair);
+    TEST("FuncRegistry sees the overloads added later") EXPECT_TRUE(registry.findBestMatch("sum", {intType, intType}) == sumPair);
+    TEST("FuncRegistry finds by the exact signature") EXPECT_TRUE(registry.findBySignature(FuncSignature("sum", {intType})) == sumInt);
+
+    NodeFunc* boxGet = new NodeFunc("get<int>", {FuncArgSet{.name = "this", .type = charPtr}}, nullptr, true, {}, 1, intType, {});
+    registry.registerMethod(boxGet, "Box");
+    TEST("FuncRegistry finds the decorated methods") EXPECT_TRUE(registry.findBestMatch(FuncSignature("get", {charPtr}, "Box")) == boxGet);
+    TEST("FuncRegistry lists the decorated methods") EXPECT_EQ(registry.findAllOverloads("get", "Box").size(), (size_t)1);
+    TEST("FuncRegistry does not match other prefixes") EXPECT_TRUE(!registry.hasBaseName("ge", "Box"));
+
+    // The (=) operator of the structure named as the argument type converts it
+    NodeFunc* wrap = new NodeFunc("wrap", {FuncArgSet{.name = "a", .type = new TypeStruct("Wrapper")}}, nullptr, true, {}, 1, intType, {});
+    registry.registerFunc(wrap);
+    TEST("FuncRegistry does not convert without an operator") EXPECT_TRUE(registry.findBestMatch("wrap", {intType}) == nullptr);
+
+    NodeStruct* convertible = new NodeStruct("int", {}, 1, "", {}, {});
+    NodeFunc* assign = new NodeFunc("int(=)", {FuncArgSet{.name = "this", .type = charPtr}, FuncArgSet{.name = "value", .type = intType}},
+        nullptr, true, {}, 1, intType, {});
+    convertible->operators[TokType::Equ][""] = assign;
+    AST::structTable[Symbol("int")] = convertible;
+    registry.registerOperator(assign, "int", TokType::Equ);
+    TEST("FuncRegistry sees the operators added later") EXPECT_TRUE(registry.findBestMatch("wrap", {intType}) == wrap);
+    AST::structTable.erase(Symbol("int"));
+    registry.clear();
+
     return test.summary();
 }